@@ -0,0 +1,108 @@
+//  This file is part of SignalGP Genetic Regulation.
+//  Copyright (C) Alexander Lalejini, 2020.
+//  Released under MIT license; see LICENSE
+
+// Microbenchmark: heap allocations during BoolCalc program evaluation (thread spawning, event
+// handling, and execution), measured with counting operator new/delete (see alloc_counter.h).
+//
+// Usage: ./alloc-bench [REPEATS] [config options (e.g., -TRAINING_SET_FILE ...)]
+// Configuration is read from config.cfg (as in bool-calc-exp). Programs are the world's initial
+// (random) population. For each program (loaded once), the hardware runs every training case once
+// to warm up, then REPEATS more times; steady-state numbers cover only the latter.
+// Output:
+// - warm-up allocations per test: first run of each test on freshly loaded programs.
+// - steady-state allocations/deallocations per test and per input signal: should be zero for
+//   allocation-free evaluation. Anything left comes from code paths that allocate on every signal
+//   (e.g., SignalGP's per-thread call stacks and memory buffers, which it rebuilds on every spawn).
+// - steady-state net allocations: allocations minus deallocations (nonzero if evaluation keeps
+//   growing the heap rather than churning through it).
+
+#define TAG_LGP_COUNT_ALLOCATIONS
+
+#include <iostream>
+#include <string>
+
+#include "emp/base/vector.hpp"
+#include "emp/config/ArgManager.hpp"
+#include "emp/config/command_line.hpp"
+
+#include "../source/alloc_counter.h"
+#include "../source/BoolCalcWorld.h"
+#include "../source/BoolCalcConfig.h"
+
+class AllocBenchWorld : public BoolCalcWorld<> {
+public:
+  void Bench(size_t repeats) {
+    hardware_t & hw = *eval_hardware;
+    size_t num_tests = 0;
+    size_t num_signals = 0;
+    AllocCounts warm_up;
+    AllocCounts steady_state;
+    double checksum = 0.0;
+    for (size_t org_id = 0; org_id < GetSize(); ++org_id) {
+      if (!IsOccupied(org_id)) continue;
+      LoadProgram(hw, GetOrg(org_id));
+      // Warm up: first run of each test on this program.
+      AllocCounts start = GetAllocCounts();
+      for (const test_case_t & test_case : training_cases) checksum += EvaluateTest(hw, test_case);
+      const AllocCounts warm_up_allocs = GetAllocCounts() - start;
+      // Steady state.
+      start = GetAllocCounts();
+      for (size_t r = 0; r < repeats; ++r) {
+        hw.GetCustomComponent().prefix_memo.Clear(); // Run every signal again (see SHARE_TEST_PREFIXES).
+        for (const test_case_t & test_case : training_cases) checksum += EvaluateTest(hw, test_case);
+      }
+      const AllocCounts steady_state_allocs = GetAllocCounts() - start;
+      warm_up += warm_up_allocs;
+      steady_state += steady_state_allocs;
+      for (const test_case_t & test_case : training_cases) num_signals += repeats * test_case.test_signals.size();
+      num_tests += repeats * training_cases.size();
+    }
+    const size_t num_programs = GetNumOrgs();
+    const size_t num_warm_up_tests = num_programs * training_cases.size();
+    std::cout << "programs: " << num_programs << "; training cases: " << training_cases.size()
+              << "; repeats: " << repeats << " (checksum " << checksum << ")" << std::endl;
+    std::cout << "warm-up allocations per test: "
+              << (double)warm_up.allocations / (double)num_warm_up_tests << std::endl;
+    std::cout << "warm-up deallocations per test: "
+              << (double)warm_up.deallocations / (double)num_warm_up_tests << std::endl;
+    std::cout << "steady-state allocations per test: "
+              << (double)steady_state.allocations / (double)num_tests << std::endl;
+    std::cout << "steady-state deallocations per test: "
+              << (double)steady_state.deallocations / (double)num_tests << std::endl;
+    std::cout << "steady-state allocations per input signal: "
+              << (double)steady_state.allocations / (double)num_signals << std::endl;
+    std::cout << "steady-state deallocations per input signal: "
+              << (double)steady_state.deallocations / (double)num_signals << std::endl;
+    std::cout << "steady-state net allocations: "
+              << (long long)steady_state.allocations - (long long)steady_state.deallocations << std::endl;
+    std::cout << "steady-state bytes allocated per test: "
+              << (double)steady_state.bytes / (double)num_tests << std::endl;
+  }
+};
+
+int main(int argc, char* argv[])
+{
+  size_t repeats = 10;
+  int num_bench_args = 0;
+  if (argc > 1 && argv[1][0] != '-') {
+    repeats = std::stoul(argv[1]);
+    num_bench_args = 1;
+  }
+  if (!AllocationCountingEnabled()) {
+    std::cout << "Allocation counting is not enabled." << std::endl;
+    return -1;
+  }
+  // Hand remaining arguments off to the config.
+  argv[num_bench_args] = argv[0];
+  std::string config_fname = "config.cfg";
+  BoolCalcConfig config;
+  auto args = emp::cl::ArgManager(argc - num_bench_args, argv + num_bench_args);
+  config.Read(config_fname);
+  if (args.ProcessConfigOptions(config, std::cout, config_fname, "config-macros.h") == false) exit(0);
+  if (args.TestUnknown() == false) exit(0);
+
+  AllocBenchWorld world;
+  world.Setup(config);
+  world.Bench(repeats);
+}
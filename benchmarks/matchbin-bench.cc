@@ -0,0 +1,196 @@
+//  This file is part of SignalGP Genetic Regulation.
+//  Copyright (C) Alexander Lalejini, 2020.
+//  Released under MIT license; see LICENSE
+
+// Microbenchmark: matchbin cost for every matchbin configuration (metric, threshold, regulator, tag
+// size, index, decay, tag index) in the build matrix, at function counts from 8 to 256. Each
+// configuration uses exactly the matchbin type BoolCalcWorld would use. Configurations come from
+// bool-calc-configs.h (generated by `make bench-matchbin` from the MULTI_* lists).
+//
+// Usage: ./matchbin-bench [OUTPUT_CSV] [REPEATS]
+// Output (one row per configuration and function count):
+// - raw_matches_per_sec: MatchRaw(query, 1), as regulation instructions look up their targets.
+// - matches_per_sec: Match(query, 1) with regulators untouched (best case for match caches).
+// - regulated_matches_per_sec: Match(query, 1) with one regulator update every REG_INTERVAL matches.
+// - match_cache_hit_rate: fraction of regulated-workload matches that did not rescore every function
+//   (requires MATCH_INDEX=counting or incremental; NA otherwise).
+// - raw_cache_hit_rate: fraction of MatchRaw calls answered by CachedRawMatchBin.
+// - regulator_update_ns, decay_ns: time per AdjRegulator call and per DecayRegulators() step.
+// Queries are drawn from a fixed pool of tags: the instruction tags of a stand-in program loaded with
+// LoadProgram (as the tags of regulation instructions are).
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "emp/base/vector.hpp"
+#include "emp/math/Random.hpp"
+
+#include "BoolCalcVariants.h"
+
+constexpr size_t NUM_QUERIES = 32;   ///< Size of the query tag pool.
+constexpr size_t REG_INTERVAL = 4;   ///< Matches per regulator update in the regulated workload.
+const emp::vector<size_t> FUNCTION_COUNTS = {8, 16, 32, 64, 128, 256};
+
+/// Benchmark settings shared by every configuration.
+struct MatchBinBenchSettings {
+  size_t repeats;
+  std::ostream & csv;
+};
+
+/// A compiled-in matchbin configuration.
+struct MatchBinBenchVariant {
+  std::string metric;
+  std::string thresh;
+  std::string reg;
+  size_t tag_bits;
+  std::string index;      ///< MATCH_INDEX
+  std::string decay;      ///< MATCH_DECAY
+  std::string tag_index;  ///< MATCH_TAG_INDEX
+  void (*run)(const MatchBinBenchVariant &, const MatchBinBenchSettings &);
+};
+
+/// Minimal stand-in for a SignalGP program: one function whose instructions are tagged with the query
+/// pool, so CachedRawMatchBin::LoadProgram can resolve them.
+template<typename TAG_T>
+struct QueryProgram {
+  struct Inst {
+    emp::vector<TAG_T> tags;
+    const emp::vector<TAG_T> & GetTags() const { return tags; }
+    const TAG_T & GetTag(size_t i) const { return tags[i]; }
+  };
+  struct Function {
+    emp::vector<Inst> insts;
+    size_t GetSize() const { return insts.size(); }
+    const Inst & operator[](size_t i) const { return insts[i]; }
+  };
+  Function function;
+  size_t GetSize() const { return 1; }
+  const Function & operator[](size_t) const { return function; }
+  const TAG_T & GetQuery(size_t i) const { return function.insts[i].GetTag(0); }
+};
+
+/// Seconds taken by fun().
+template<typename FUN_T>
+double TimeIt(FUN_T && fun) {
+  const auto start = std::chrono::steady_clock::now();
+  fun();
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+
+/// Benchmark one matchbin type at every function count; writes one csv row per function count.
+template<typename MATCHBIN_T>
+void RunMatchBinBench(const MatchBinBenchVariant & variant, const MatchBinBenchSettings & settings) {
+  using tag_t = std::decay_t<decltype(std::declval<MATCHBIN_T&>().GetTag(0))>;
+  const size_t repeats = settings.repeats;
+  for (size_t num_functions : FUNCTION_COUNTS) {
+    emp::Random random(2);
+    MATCHBIN_T matchbin(random);
+    // SignalGP identifies functions by id (uid == function id).
+    for (size_t uid = 0; uid < num_functions; ++uid) matchbin.Set(uid, tag_t(random, 0.5), uid);
+    QueryProgram<tag_t> program;
+    for (size_t i = 0; i < NUM_QUERIES; ++i) program.function.insts.push_back({{tag_t(random, 0.5)}});
+    matchbin.LoadProgram(program);
+    emp::vector<double> adjustments;
+    for (size_t i = 0; i < 1024; ++i) adjustments.emplace_back(random.GetDouble(-5, 5));
+    size_t checksum = 0;
+
+    const double raw_time = TimeIt([&]() {
+      for (size_t r = 0; r < repeats; ++r) checksum += matchbin.MatchRaw(program.GetQuery(r % NUM_QUERIES), 1).size();
+    });
+    const double match_time = TimeIt([&]() {
+      for (size_t r = 0; r < repeats; ++r) checksum += matchbin.Match(program.GetQuery(r % NUM_QUERIES), 1).size();
+    });
+
+    if constexpr (has_matchbin_stats<MATCHBIN_T>::value) matchbin.ResetStats();
+    const double regulated_time = TimeIt([&]() {
+      for (size_t r = 0; r < repeats; ++r) {
+        if (r % REG_INTERVAL == 0) {
+          matchbin.AdjRegulator(random.GetUInt(num_functions), adjustments[r % adjustments.size()]);
+        }
+        checksum += matchbin.Match(program.GetQuery(r % NUM_QUERIES), 1).size();
+      }
+    });
+    std::string match_hit_rate = "NA";
+    if constexpr (has_matchbin_stats<MATCHBIN_T>::value) {
+      const MatchBinStats & stats = matchbin.GetStats();
+      if (stats.matches) {
+        match_hit_rate = std::to_string(1.0 - static_cast<double>(stats.full_recomputes) / static_cast<double>(stats.matches));
+      }
+    }
+    const size_t raw_lookups = matchbin.GetRawCacheHits() + matchbin.GetRawCacheMisses();
+    const double raw_hit_rate = raw_lookups ? static_cast<double>(matchbin.GetRawCacheHits()) / raw_lookups : 0.0;
+
+    const double update_time = TimeIt([&]() {
+      for (size_t r = 0; r < repeats; ++r) {
+        matchbin.AdjRegulator(r % num_functions, adjustments[r % adjustments.size()]);
+      }
+    });
+    const double decay_time = TimeIt([&]() {
+      for (size_t r = 0; r < repeats; ++r) {
+        if (r % num_functions == 0) matchbin.AdjRegulator(random.GetUInt(num_functions), adjustments[r % adjustments.size()]);
+        matchbin.DecayRegulators();
+      }
+    });
+
+    settings.csv << variant.tag_bits << "," << variant.metric << "," << variant.thresh << "," << variant.reg << ","
+                 << variant.index << "," << variant.decay << "," << variant.tag_index << ","
+                 << num_functions << ","
+                 << repeats / raw_time << "," << repeats / match_time << "," << repeats / regulated_time << ","
+                 << match_hit_rate << "," << raw_hit_rate << ","
+                 << 1e9 * update_time / repeats << "," << 1e9 * decay_time / repeats << std::endl;
+    std::cout << "  " << num_functions << " functions: " << repeats / regulated_time
+              << " regulated matches/s (checksum " << checksum << ")" << std::endl;
+  }
+}
+
+/// Add a variant for CONFIG_T, unless its matchbin options don't fit together (see BoolCalcWorldDefs::VALID).
+template<typename CONFIG_T>
+void AddMatchBinBenchVariant(emp::vector<MatchBinBenchVariant> & variants) {
+  if constexpr (BoolCalcWorldDefs<CONFIG_T>::VALID) {
+    variants.push_back({
+      std::string(CONFIG_T::MATCHBIN_METRIC), std::string(CONFIG_T::MATCHBIN_THRESH),
+      std::string(CONFIG_T::MATCHBIN_REG), CONFIG_T::MATCHBIN_TAG_BITS,
+      std::string(CONFIG_T::MATCHBIN_INDEX), std::string(CONFIG_T::MATCHBIN_DECAY),
+      std::string(CONFIG_T::MATCHBIN_TAG_INDEX), &RunMatchBinBench<typename BoolCalcWorldDefs<CONFIG_T>::matchbin_t>
+    });
+  }
+}
+
+/// Variants for every valid configuration in the list.
+template<typename... CONFIG_TS>
+emp::vector<MatchBinBenchVariant> GetMatchBinBenchVariants(BoolCalcConfigList<CONFIG_TS...>) {
+  emp::vector<MatchBinBenchVariant> variants;
+  (AddMatchBinBenchVariant<CONFIG_TS>(variants), ...);
+  return variants;
+}
+
+#include "bool-calc-configs.h"
+
+int main(int argc, char* argv[]) {
+  const std::string output_path = (argc > 1) ? argv[1] : "matchbin-bench.csv";
+  const size_t repeats = (argc > 2) ? std::stoul(argv[2]) : 20000;
+
+  std::ofstream csv(output_path);
+  if (!csv.is_open()) {
+    std::cout << "Failed to open " << output_path << std::endl;
+    return -1;
+  }
+  csv << "tag_bits,metric,thresh,reg,index,decay,tag_index,num_functions,"
+      << "raw_matches_per_sec,matches_per_sec,regulated_matches_per_sec,"
+      << "match_cache_hit_rate,raw_cache_hit_rate,regulator_update_ns,decay_ns" << std::endl;
+
+  const MatchBinBenchSettings settings{repeats, csv};
+  for (const MatchBinBenchVariant & variant : GetMatchBinBenchVariants(bool_calc_configs_t())) {
+    std::cout << variant.metric << ", thresh " << variant.thresh << ", " << variant.reg << ", "
+              << variant.tag_bits << " bits, " << variant.index << ", " << variant.decay << ", "
+              << variant.tag_index << std::endl;
+    variant.run(variant, settings);
+  }
+  std::cout << "Wrote " << output_path << std::endl;
+  return 0;
+}
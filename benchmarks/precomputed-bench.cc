@@ -0,0 +1,89 @@
+//  This file is part of SignalGP Genetic Regulation.
+//  Copyright (C) Alexander Lalejini, 2020.
+//  Released under MIT license; see LICENSE
+
+// Microbenchmark: signal dispatch through emp::MatchBin (every match rescores the signal against every
+// function tag with the metric) vs. PrecomputedMatchBin (raw scores kept per program; matches only
+// apply regulators).
+//
+// Usage: ./precomputed-bench [NUM_FUNCTIONS] [MATCHES_PER_PROGRAM] [PROGRAMS]
+// Each program gets fresh function tags; each match first adjusts one function's regulator (so
+// emp::MatchBin can't answer from its cache) and then finds the best regulated match for one of a
+// fixed set of input signal tags.
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include "emp/base/vector.hpp"
+#include "emp/bits/BitSet.hpp"
+#include "emp/math/Random.hpp"
+#include "emp/matchbin/MatchBin.hpp"
+#include "emp/matchbin/matchbin_metrics.hpp"
+#include "emp/matchbin/matchbin_selectors.hpp"
+
+#include "../source/matchbin_regulators.h"
+#include "../source/simd_streak_metric.h"
+#include "../source/precomputed_matchbin.h"
+
+constexpr size_t TAG_WIDTH = 256;
+constexpr size_t NUM_SIGNALS = 16;
+using tag_t = emp::BitSet<TAG_WIDTH>;
+using metric_t = SimdStreakMetric<TAG_WIDTH>;
+using selector_t = emp::RankedSelector<>;
+using regulator_t = emp::AdditiveCountdownRegulator<>;
+using plain_matchbin_t = emp::MatchBin<size_t, metric_t, selector_t, regulator_t>;
+using precomputed_matchbin_t = PrecomputedMatchBin<plain_matchbin_t, metric_t, selector_t>;
+
+/// Load each program and dispatch matches_per_program signals against it; returns matches per second.
+template<typename MATCHBIN_T>
+double TimeDispatch(const emp::vector<emp::vector<tag_t>> & programs,
+                    const emp::vector<tag_t> & signals,
+                    const emp::vector<double> & adjustments,
+                    size_t matches_per_program,
+                    size_t & checksum)
+{
+  emp::Random random(1);
+  MATCHBIN_T matchbin(random);
+  const auto start = std::chrono::steady_clock::now();
+  for (const auto & func_tags : programs) {
+    matchbin.Clear();
+    for (size_t i = 0; i < func_tags.size(); ++i) matchbin.Set(i, func_tags[i], i);
+    for (size_t r = 0; r < matches_per_program; ++r) {
+      matchbin.AdjRegulator(r % func_tags.size(), adjustments[r % adjustments.size()]);
+      const auto best = matchbin.Match(signals[r % signals.size()], 1);
+      checksum += best.size() ? best[0] : 0;
+    }
+  }
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  return (programs.size() * matches_per_program) / elapsed.count();
+}
+
+int main(int argc, char* argv[]) {
+  const size_t num_functions = (argc > 1) ? std::stoul(argv[1]) : 256;
+  const size_t matches_per_program = (argc > 2) ? std::stoul(argv[2]) : 2000;
+  const size_t num_programs = (argc > 3) ? std::stoul(argv[3]) : 20;
+
+  emp::Random random(2);
+  emp::vector<emp::vector<tag_t>> programs(num_programs);
+  emp::vector<tag_t> signals;
+  emp::vector<double> adjustments;
+  for (auto & func_tags : programs) {
+    for (size_t i = 0; i < num_functions; ++i) func_tags.emplace_back(random, 0.5);
+  }
+  for (size_t i = 0; i < NUM_SIGNALS; ++i) signals.emplace_back(random, 0.5);
+  for (size_t i = 0; i < 1024; ++i) adjustments.emplace_back(random.GetDouble(-1, 1));
+
+  size_t plain_checksum = 0;
+  size_t precomputed_checksum = 0;
+  const double plain_rate = TimeDispatch<plain_matchbin_t>(programs, signals, adjustments, matches_per_program, plain_checksum);
+  const double precomputed_rate = TimeDispatch<precomputed_matchbin_t>(programs, signals, adjustments, matches_per_program, precomputed_checksum);
+
+  std::cout << "Functions: " << num_functions << "; signals: " << NUM_SIGNALS
+            << "; matches per program: " << matches_per_program << "; programs: " << num_programs << std::endl;
+  std::cout << "emp::MatchBin (metric per match): " << plain_rate << " matches/s" << std::endl;
+  std::cout << "PrecomputedMatchBin: " << precomputed_rate << " matches/s" << std::endl;
+  std::cout << "Speedup: " << precomputed_rate / plain_rate << "x" << std::endl;
+  std::cout << "Same best matches: " << (plain_checksum == precomputed_checksum ? "yes" : "no") << std::endl;
+  return 0;
+}
@@ -0,0 +1,90 @@
+//  This file is part of SignalGP Genetic Regulation.
+//  Copyright (C) Alexander Lalejini, 2020.
+//  Released under MIT license; see LICENSE
+
+// Microbenchmark: regulated-match throughput of ExponentialCountdownRegulator (std::pow per score)
+// vs. QuantizedExponentialCountdownRegulator (table lookup per score), and the observed error of
+// the quantized regulator against its documented bound.
+//
+// Usage: ./regulator-bench [NUM_FUNCTIONS] [REPEATS]
+// Each repeat adjusts one function's regulator and then finds the best regulated match for a query,
+// so every match rescores every function (emp::MatchBin purges its cache on regulator changes).
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string>
+
+#include "emp/base/vector.hpp"
+#include "emp/bits/BitSet.hpp"
+#include "emp/math/Random.hpp"
+#include "emp/matchbin/MatchBin.hpp"
+#include "emp/matchbin/matchbin_metrics.hpp"
+#include "emp/matchbin/matchbin_selectors.hpp"
+
+#include "../source/matchbin_regulators.h"
+
+constexpr size_t TAG_WIDTH = 256;
+using tag_t = emp::BitSet<TAG_WIDTH>;
+using exact_regulator_t = ExponentialCountdownRegulator<>;
+using quantized_regulator_t = QuantizedExponentialCountdownRegulator<>;
+
+/// Run REPEATS (adjust regulator, regulated match) rounds; returns matches per second.
+template<typename REGULATOR_T>
+double TimeRegulatedMatches(const emp::vector<tag_t> & func_tags,
+                            const emp::vector<tag_t> & queries,
+                            const emp::vector<double> & adjustments,
+                            size_t repeats,
+                            size_t & checksum)
+{
+  emp::Random random(1);
+  emp::MatchBin<size_t, emp::StreakMetric<TAG_WIDTH>, emp::RankedSelector<>, REGULATOR_T> matchbin(random);
+  for (size_t i = 0; i < func_tags.size(); ++i) matchbin.Set(i, func_tags[i], i);
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t r = 0; r < repeats; ++r) {
+    const size_t uid = r % func_tags.size();
+    matchbin.SetRegulator(uid, adjustments[r % adjustments.size()]);
+    const auto best = matchbin.Match(queries[r % queries.size()], 1);
+    checksum += best.size() ? best[0] : 0;
+  }
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  return repeats / elapsed.count();
+}
+
+int main(int argc, char* argv[]) {
+  const size_t num_functions = (argc > 1) ? std::stoul(argv[1]) : 256;
+  const size_t repeats = (argc > 2) ? std::stoul(argv[2]) : 20000;
+
+  emp::Random random(2);
+  emp::vector<tag_t> func_tags;
+  emp::vector<tag_t> queries;
+  emp::vector<double> adjustments;
+  for (size_t i = 0; i < num_functions; ++i) func_tags.emplace_back(random, 0.5);
+  for (size_t i = 0; i < 64; ++i) queries.emplace_back(random, 0.5);
+  for (size_t i = 0; i < 1024; ++i) adjustments.emplace_back(random.GetDouble(-20, 20));
+
+  // Accuracy: quantized vs. exact regulated score across the whole state range.
+  exact_regulator_t exact;
+  quantized_regulator_t quantized;
+  double max_error = 0.0;
+  for (double state = exact_regulator_t::min_state; state <= exact_regulator_t::max_state; state += 0.0001) {
+    exact.Set(state);
+    quantized.Set(state);
+    max_error = std::max(max_error, std::abs(quantized(1.0) - exact(1.0)) / exact(1.0));
+  }
+  std::cout << "Max relative error (observed): " << max_error << std::endl;
+  std::cout << "Max relative error (bound): " << quantized_regulator_t::MaxRelativeError() << std::endl;
+
+  size_t exact_checksum = 0;
+  size_t quantized_checksum = 0;
+  const double exact_rate = TimeRegulatedMatches<exact_regulator_t>(func_tags, queries, adjustments, repeats, exact_checksum);
+  const double quantized_rate = TimeRegulatedMatches<quantized_regulator_t>(func_tags, queries, adjustments, repeats, quantized_checksum);
+
+  std::cout << "Functions: " << num_functions << "; repeats: " << repeats << std::endl;
+  std::cout << "Exponential regulator: " << exact_rate << " regulated matches/s" << std::endl;
+  std::cout << "Quantized exponential regulator: " << quantized_rate << " regulated matches/s" << std::endl;
+  std::cout << "Speedup: " << quantized_rate / exact_rate << "x" << std::endl;
+  std::cout << "Same best matches: " << (exact_checksum == quantized_checksum ? "yes" : "no") << std::endl;
+  return 0;
+}
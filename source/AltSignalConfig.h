@@ -15,6 +15,9 @@ EMP_BUILD_CONFIG(AltSignalConfig,
     VALUE(NUM_ENV_CYCLES, size_t, 8, "How many times does the environment cycle?"),
     VALUE(CPU_TIME_PER_ENV_CYCLE, size_t, 128, "How many CPU steps does a SignalGP organism get during an environment cycle?"),
 
+  GROUP(EVALUATION_GROUP, "Organism evaluation settings"),
+    VALUE(PHENOTYPE_CACHE_SIZE, size_t, 0, "How many genomes' phenotypes should we remember across generations? (0 = no caching)"),
+
   GROUP(PROGRAM_GROUP, "Program settings"),
     VALUE(USE_FUNC_REGULATION, bool, true, "Do programs have access to function regulation instructions?"),
     VALUE(USE_GLOBAL_MEMORY, bool, false, "Do programs have access to global memory?"),
@@ -45,7 +45,20 @@
 #include "AltSignalConfig.h"
 #include "mutation_utils.h"
 #include "Event.h"
+#include "hardware_run.h"
 #include "matchbin_regulators.h"
+#include "precomputed_matchbin.h"
+#include "simd_streak_metric.h"
+#include "batch_metrics.h"
+#include "indexed_matchbin.h"
+#include "timer_wheel_matchbin.h"
+#include "tag_index.h"
+#include "cached_raw_matchbin.h"
+#include "dirty_reset_matchbin.h"
+#include "inst_dispatch.h"
+#include "knockouts.h"
+#include "inst_observers.h"
+#include "phenotype_cache.h"
 
 #include "reg_ko_instr_impls.h"
 
@@ -66,9 +79,21 @@ namespace AltSignalWorldDefs {
   #ifndef MATCH_REG
   #define MATCH_REG add
   #endif
+  #ifndef MATCH_REG_RES
+  #define MATCH_REG_RES 16
+  #endif
   #ifndef MATCH_METRIC
   #define MATCH_METRIC streak
   #endif
+  #ifndef MATCH_INDEX
+  #define MATCH_INDEX emp
+  #endif
+  #ifndef MATCH_DECAY
+  #define MATCH_DECAY step
+  #endif
+  #ifndef MATCH_TAG_INDEX
+  #define MATCH_TAG_INDEX none
+  #endif
   using matchbin_val_t = size_t;  ///< SignalGP function ID type (how are functions identified in the matchbin?)
 
   // What match threshold should we use?
@@ -94,23 +119,26 @@ namespace AltSignalWorldDefs {
   using matchbin_metric_t =
   #ifdef MATCH_METRIC
     std::conditional<STRINGVIEWIFY(MATCH_METRIC) == "integer",
-      emp::AsymmetricWrapMetric<TAG_LEN>,
+      BatchAsymmetricWrapMetric<TAG_LEN>,
     std::conditional<STRINGVIEWIFY(MATCH_METRIC) == "integer-symmetric",
-      emp::SymmetricWrapMetric<TAG_LEN>,
+      BatchSymmetricWrapMetric<TAG_LEN>,
     std::conditional<STRINGVIEWIFY(MATCH_METRIC) == "hamming",
-      emp::HammingMetric<TAG_LEN>,
+      BatchHammingMetric<TAG_LEN>,
     std::conditional<STRINGVIEWIFY(MATCH_METRIC) == "hash",
       emp::CryptoHashMetric<TAG_LEN>,
     std::conditional<STRINGVIEWIFY(MATCH_METRIC) == "streak",
       emp::StreakMetric<TAG_LEN>,
     std::conditional<STRINGVIEWIFY(MATCH_METRIC) == "streak-exact",
       emp::ExactDualStreakMetric<TAG_LEN>,
+    std::conditional<STRINGVIEWIFY(MATCH_METRIC) == "streak-simd",
+      SimdStreakMetric<TAG_LEN>,
     std::enable_if<false>
     >::type
     >::type
     >::type
     >::type
     >::type
+    >::type
     >::type;
   #endif
 
@@ -123,9 +151,12 @@ namespace AltSignalWorldDefs {
       emp::MultiplicativeCountdownRegulator<>,
     std::conditional<STRINGVIEWIFY(MATCH_REG) == "exp",
       ExponentialCountdownRegulator<>,
+    std::conditional<STRINGVIEWIFY(MATCH_REG) == "exp-quant",
+      QuantizedExponentialCountdownRegulator<std::ratio<11,10>, 100, MATCH_REG_RES>,
     std::enable_if<false>
     >::type
     >::type
+    >::type
     >::type;
   #endif
 
@@ -136,6 +167,7 @@ namespace AltSignalWorldDefs {
 struct CustomHardware {
   int response = -1;            ///< Organism-set response to environment signal.
   int response_function_id=-1;  ///< Which function responded? Used for data tracking/output.
+  size_t cycles_used=0;         ///< CPU cycles run by evaluation (profiling; Reset() leaves it alone).
 
   void Reset() {
     response = -1;
@@ -151,10 +183,44 @@ public:
   using inst_arg_t = int;                                   ///< Instruction arguments are integers.
   using org_t = AltSignalOrganism<tag_t,inst_arg_t>;
 
-  using matchbin_t = emp::MatchBin<AltSignalWorldDefs::matchbin_val_t,
-                                   AltSignalWorldDefs::matchbin_metric_t,
-                                   AltSignalWorldDefs::matchbin_selector_t,
-                                   AltSignalWorldDefs::matchbin_regulator_t>;
+  using matchbin_metric_t = AltSignalWorldDefs::matchbin_metric_t;
+  // How should the matchbin find regulated matches? (emp: emp::MatchBin, with raw scores kept per program;
+  // counting: emp::MatchBin + match counters; incremental: regulation-aware match index + match counters)
+  using matchbin_index_t =
+    std::conditional<STRINGVIEWIFY(MATCH_INDEX) == "emp",
+      PrecomputedMatchBin<emp::MatchBin<AltSignalWorldDefs::matchbin_val_t, matchbin_metric_t, AltSignalWorldDefs::matchbin_selector_t, AltSignalWorldDefs::matchbin_regulator_t>,
+                          matchbin_metric_t, AltSignalWorldDefs::matchbin_selector_t>,
+    std::conditional<STRINGVIEWIFY(MATCH_INDEX) == "counting",
+      IndexedMatchBin<AltSignalWorldDefs::matchbin_val_t, matchbin_metric_t, AltSignalWorldDefs::matchbin_selector_t, AltSignalWorldDefs::matchbin_regulator_t, false>,
+    std::conditional<STRINGVIEWIFY(MATCH_INDEX) == "incremental",
+      IndexedMatchBin<AltSignalWorldDefs::matchbin_val_t, matchbin_metric_t, AltSignalWorldDefs::matchbin_selector_t, AltSignalWorldDefs::matchbin_regulator_t, true>,
+    std::enable_if<false>
+    >::type
+    >::type
+    >::type;
+  // How should regulators decay? (step: every regulator on every step; wheel: timer wheel, touching only
+  // regulators whose countdown expires)
+  using matchbin_decay_t =
+    std::conditional<STRINGVIEWIFY(MATCH_DECAY) == "step",
+      matchbin_index_t,
+    std::conditional<STRINGVIEWIFY(MATCH_DECAY) == "wheel",
+      TimerWheelMatchBin<matchbin_index_t>,
+    std::enable_if<false>
+    >::type
+    >::type;
+  // How should top-1 matches be found? (none: matchbin scan; nearest: nearest-tag index, falling back
+  // to the scan whenever the index can't give the exact answer)
+  using matchbin_search_t =
+    std::conditional<STRINGVIEWIFY(MATCH_TAG_INDEX) == "none",
+      matchbin_decay_t,
+    std::conditional<STRINGVIEWIFY(MATCH_TAG_INDEX) == "nearest",
+      TagIndexMatchBin<matchbin_decay_t, typename tag_index_for<matchbin_metric_t>::type, AltSignalWorldDefs::matchbin_selector_t>,
+    std::enable_if<false>
+    >::type
+    >::type;
+  // Raw matches (regulation instruction targets) are resolved once per program; resets between tests
+  // only undo regulation that happened since the last reset.
+  using matchbin_t = DirtyResetMatchBin<CachedRawMatchBin<matchbin_search_t>>;
   using mem_model_t = sgp::SimpleMemoryModel;
   using hardware_t = sgp::LinearFunctionsProgramSignalGP<mem_model_t,
                                                           tag_t,
@@ -207,6 +273,8 @@ protected:
   size_t NUM_SIGNAL_RESPONSES;
   size_t NUM_ENV_CYCLES;
   size_t CPU_TIME_PER_ENV_CYCLE;
+  // Evaluation group
+  size_t PHENOTYPE_CACHE_SIZE;
   // Program group
   bool USE_FUNC_REGULATION;
   bool USE_GLOBAL_MEMORY;
@@ -237,12 +305,19 @@ protected:
 
   bool setup = false;               ///< Has this world been setup already?
   emp::Ptr<inst_lib_t> inst_lib;    ///< Manages SignalGP instruction set.
+  emp::vector<emp::Ptr<inst_lib_t>> ko_inst_libs; ///< Instruction set specialized for each knockout mode (by KnockoutMode).
+  emp::Ptr<inst_lib_t> trace_inst_lib;  ///< Instruction set that records executed instructions (into traced_instructions); used for traces.
+  emp::vector<inst_t> traced_instructions;  ///< Instructions executed on trace_hardware (cleared by the trace).
   emp::Ptr<event_lib_t> event_lib;  ///< Manages SignalGP events.
   emp::Ptr<mutator_t> mutator;      ///< Mutates SignalGP programs.
 
   size_t event_id__env_sig;         ///< Event library ID of environment signal.
 
   emp::Ptr<hardware_t> eval_hardware;  ///< The SignalGP virtual hardware used to evaluate programs.
+  emp::vector<emp::Ptr<hardware_t>> ko_hardware; ///< Virtual hardware used to evaluate programs under each knockout mode (by KnockoutMode).
+  emp::Ptr<hardware_t> trace_hardware;  ///< Used to trace programs (runs trace_inst_lib).
+
+  PhenotypeCache<program_t, phenotype_t> phen_cache; ///< Remembers phenotypes by genome (across generations).
 
   emp::Signal<void(size_t)> after_eval_sig; ///< Triggered after organism (ID given by size_t argument) evaluation.
   emp::Signal<void(void)> end_setup_sig;    ///< Triggered after setup is done.
@@ -250,11 +325,6 @@ protected:
   emp::Ptr<emp::DataFile> max_fit_file; ///< Manages max fitness organism file (output at SUMMARY_RESOLUTION)
   // emp::Ptr<systematics_t> sys_ptr;      ///< Shortcut pointer to correctly-typed systematics manager. Base world class will be responsible for memory management.
 
-  bool KO_REGULATION=false;       ///< Is regulation knocked out?
-  bool KO_UP_REGULATION=false;    ///< Is up-regulation knocked out?
-  bool KO_DOWN_REGULATION=false;  ///< Is down-regulation knocked out?
-  bool KO_GLOBAL_MEMORY=false;    ///< Is global memory access knocked out?
-
   /// tracking information for max fitness organism in the population.
   struct {
     size_t org_id=0;
@@ -263,8 +333,17 @@ protected:
 
   /// Localize configuration parameters from input config object.
   void InitConfigs(const AltSignalConfig & config);
-  /// Initialize the instruction library.
+  /// Initialize the instruction library (and one library per knockout mode).
   void InitInstLib();
+  /// Add default instructions to target_lib, with knockouts KNOCKOUTS_T compiled in (see knockouts.h)
+  /// and observer applied to each instruction (see inst_observers.h).
+  template<typename KNOCKOUTS_T, typename OBSERVER_T=NoInstObserver>
+  void AddInstructions(inst_lib_t & target_lib, const OBSERVER_T & observer=OBSERVER_T());
+  /// Initialize the instruction library for knockout mode MODE.
+  template<KnockoutMode MODE>
+  void AddKnockoutInstructions() {
+    AddInstructions<typename knockouts_for<MODE>::type>(*ko_inst_libs[(size_t)MODE]);
+  }
   /// Initialize the event library.
   void InitEventLib();
   /// Initialize the SignalGP virtual hardware used to evaluate programs.
@@ -291,7 +370,9 @@ protected:
   void DoUpdate();
 
   /// Evaluate org_t org on repeated signal task.
-  void EvaluateOrg(org_t & org);
+  void EvaluateOrg(org_t & org) { EvaluateOrg(*eval_hardware, org); }
+  /// Evaluate org_t org on repeated signal task using the given virtual hardware.
+  void EvaluateOrg(hardware_t & hw, org_t & org);
 
   /// Monster function that runs analyses on given organisms.
   /// - e.g., knockout experiments, traces, etc
@@ -320,8 +401,12 @@ public:
   ~AltSignalWorld() {
     if (setup) {
       inst_lib.Delete();
+      for (auto lib : ko_inst_libs) lib.Delete();
+      trace_inst_lib.Delete();
       event_lib.Delete();
       eval_hardware.Delete();
+      for (auto hw : ko_hardware) hw.Delete();
+      trace_hardware.Delete();
       mutator.Delete();
       max_fit_file.Delete();
     }
@@ -350,6 +435,8 @@ void AltSignalWorld::InitConfigs(const AltSignalConfig & config) {
   NUM_SIGNAL_RESPONSES = config.NUM_SIGNAL_RESPONSES();
   NUM_ENV_CYCLES = config.NUM_ENV_CYCLES();
   CPU_TIME_PER_ENV_CYCLE = config.CPU_TIME_PER_ENV_CYCLE();
+  // evaluation group
+  PHENOTYPE_CACHE_SIZE = config.PHENOTYPE_CACHE_SIZE();
   // program group
   USE_FUNC_REGULATION = config.USE_FUNC_REGULATION();
   USE_GLOBAL_MEMORY = config.USE_GLOBAL_MEMORY();
@@ -382,12 +469,20 @@ void AltSignalWorld::InitHardware() {
   // If being configured for the first time, create a new hardware object.
   if (!setup) {
     eval_hardware = emp::NewPtr<hardware_t>(*random_ptr, *inst_lib, *event_lib);
+    trace_hardware = emp::NewPtr<hardware_t>(*random_ptr, *trace_inst_lib, *event_lib);
+    // Knockout analysis runs on hardware bound to the matching knockout instruction library.
+    for (auto lib : ko_inst_libs) ko_hardware.emplace_back(emp::NewPtr<hardware_t>(*random_ptr, *lib, *event_lib));
   }
-  // Configure SignalGP CPU
-  eval_hardware->Reset();
-  eval_hardware->SetActiveThreadLimit(MAX_ACTIVE_THREAD_CNT);
-  eval_hardware->SetThreadCapacity(MAX_THREAD_CAPACITY);
-  emp_assert(eval_hardware->ValidateThreadState());
+  // Configure SignalGP CPUs
+  auto configure_hardware = [this](hardware_t & hw) {
+    hw.Reset();
+    hw.SetActiveThreadLimit(MAX_ACTIVE_THREAD_CNT);
+    hw.SetThreadCapacity(MAX_THREAD_CAPACITY);
+    emp_assert(hw.ValidateThreadState());
+  };
+  configure_hardware(*eval_hardware);
+  configure_hardware(*trace_hardware);
+  for (auto hw : ko_hardware) configure_hardware(*hw);
 }
 
 /// Initialize the environment.
@@ -403,249 +498,265 @@ void AltSignalWorld::InitEnvironment() {
 
 /// Create and initialize instruction set with default instructions.
 void AltSignalWorld::InitInstLib() {
-  if (!setup) inst_lib = emp::NewPtr<inst_lib_t>();
-  inst_lib->Clear(); // Reset the instruction library
+  if (!setup) {
+    inst_lib = emp::NewPtr<inst_lib_t>();
+    trace_inst_lib = emp::NewPtr<inst_lib_t>();
+    for (size_t mode = 0; mode < NUM_KNOCKOUT_MODES; ++mode) ko_inst_libs.emplace_back(emp::NewPtr<inst_lib_t>());
+  }
+  AddInstructions<NoKnockouts>(*inst_lib);
+  AddInstructions<NoKnockouts>(*trace_inst_lib, InstRecorder<inst_t>(traced_instructions));
+  AddKnockoutInstructions<KnockoutMode::GLOBAL_MEMORY>();
+  AddKnockoutInstructions<KnockoutMode::REGULATION>();
+  AddKnockoutInstructions<KnockoutMode::GLOBAL_MEMORY_AND_REGULATION>();
+  AddKnockoutInstructions<KnockoutMode::UP_REGULATION>();
+  AddKnockoutInstructions<KnockoutMode::DOWN_REGULATION>();
+}
+
+/// Add default instructions to target_lib, with knockouts KNOCKOUTS_T compiled in and observer applied.
+template<typename KNOCKOUTS_T, typename OBSERVER_T>
+void AltSignalWorld::AddInstructions(inst_lib_t & target_lib, const OBSERVER_T & observer) {
+  ObservedInstLib<inst_lib_t, inst_prop_t, OBSERVER_T> lib(target_lib, observer);
+  lib.Clear(); // Reset the instruction library
   // Add default instructions.
-  inst_lib->AddInst("Nop", [](hardware_t & hw, const inst_t & inst) { ; }, "No operation!");
-  inst_lib->AddInst("Inc", sgp::inst_impl::Inst_Inc<hardware_t, inst_t>, "Increment!");
-  inst_lib->AddInst("Dec", sgp::inst_impl::Inst_Dec<hardware_t, inst_t>, "Decrement!");
-  inst_lib->AddInst("Not", sgp::inst_impl::Inst_Not<hardware_t, inst_t>, "Logical not of ARG[0]");
-  inst_lib->AddInst("Add", sgp::inst_impl::Inst_Add<hardware_t, inst_t>, "");
-  inst_lib->AddInst("Sub", sgp::inst_impl::Inst_Sub<hardware_t, inst_t>, "");
-  inst_lib->AddInst("Mult", sgp::inst_impl::Inst_Mult<hardware_t, inst_t>, "");
-  inst_lib->AddInst("Div", sgp::inst_impl::Inst_Div<hardware_t, inst_t>, "");
-  inst_lib->AddInst("Mod", sgp::inst_impl::Inst_Mod<hardware_t, inst_t>, "");
-  inst_lib->AddInst("TestEqu", sgp::inst_impl::Inst_TestEqu<hardware_t, inst_t>, "");
-  inst_lib->AddInst("TestNEqu", sgp::inst_impl::Inst_TestNEqu<hardware_t, inst_t>, "");
-  inst_lib->AddInst("TestLess", sgp::inst_impl::Inst_TestLess<hardware_t, inst_t>, "");
-  inst_lib->AddInst("TestLessEqu", sgp::inst_impl::Inst_TestLessEqu<hardware_t, inst_t>, "");
-  inst_lib->AddInst("TestGreater", sgp::inst_impl::Inst_TestGreater<hardware_t, inst_t>, "");
-  inst_lib->AddInst("TestGreaterEqu", sgp::inst_impl::Inst_TestGreaterEqu<hardware_t, inst_t>, "");
-  inst_lib->AddInst("SetMem", sgp::inst_impl::Inst_SetMem<hardware_t, inst_t>, "");
-  inst_lib->AddInst("Close", sgp::inst_impl::Inst_Close<hardware_t, inst_t>, "", {inst_prop_t::BLOCK_CLOSE});
-  inst_lib->AddInst("Break", sgp::inst_impl::Inst_Break<hardware_t, inst_t>, "");
-  inst_lib->AddInst("Call", sgp::inst_impl::Inst_Call<hardware_t, inst_t>, "");
-  inst_lib->AddInst("Return", sgp::inst_impl::Inst_Return<hardware_t, inst_t>, "");
-  inst_lib->AddInst("CopyMem", sgp::inst_impl::Inst_CopyMem<hardware_t, inst_t>, "");
-  inst_lib->AddInst("SwapMem", sgp::inst_impl::Inst_SwapMem<hardware_t, inst_t>, "");
-  inst_lib->AddInst("InputToWorking", sgp::inst_impl::Inst_InputToWorking<hardware_t, inst_t>, "");
-  inst_lib->AddInst("WorkingToOutput", sgp::inst_impl::Inst_WorkingToOutput<hardware_t, inst_t>, "");
-  inst_lib->AddInst("Fork", sgp::inst_impl::Inst_Fork<hardware_t, inst_t>, "");
-  inst_lib->AddInst("Terminate", sgp::inst_impl::Inst_Terminate<hardware_t, inst_t>, "");
-  inst_lib->AddInst("If", sgp::lfp_inst_impl::Inst_If<hardware_t, inst_t>, "", {inst_prop_t::BLOCK_DEF});
-  inst_lib->AddInst("While", sgp::lfp_inst_impl::Inst_While<hardware_t, inst_t>, "", {inst_prop_t::BLOCK_DEF});
-  inst_lib->AddInst("Routine", sgp::lfp_inst_impl::Inst_Routine<hardware_t, inst_t>, "");
-  inst_lib->AddInst("Terminal", sgp::inst_impl::Inst_Terminal<hardware_t, inst_t,
-                                                              std::ratio<1>, std::ratio<-1>>, "");
+  lib.AddInst("Nop", [](hardware_t & hw, const inst_t & inst) { ; }, "No operation!");
+  lib.AddInst("Inc", DirectInst<sgp::inst_impl::Inst_Inc<hardware_t, inst_t>>{}, "Increment!");
+  lib.AddInst("Dec", DirectInst<sgp::inst_impl::Inst_Dec<hardware_t, inst_t>>{}, "Decrement!");
+  lib.AddInst("Not", DirectInst<sgp::inst_impl::Inst_Not<hardware_t, inst_t>>{}, "Logical not of ARG[0]");
+  lib.AddInst("Add", DirectInst<sgp::inst_impl::Inst_Add<hardware_t, inst_t>>{}, "");
+  lib.AddInst("Sub", DirectInst<sgp::inst_impl::Inst_Sub<hardware_t, inst_t>>{}, "");
+  lib.AddInst("Mult", DirectInst<sgp::inst_impl::Inst_Mult<hardware_t, inst_t>>{}, "");
+  lib.AddInst("Div", DirectInst<sgp::inst_impl::Inst_Div<hardware_t, inst_t>>{}, "");
+  lib.AddInst("Mod", DirectInst<sgp::inst_impl::Inst_Mod<hardware_t, inst_t>>{}, "");
+  lib.AddInst("TestEqu", DirectInst<sgp::inst_impl::Inst_TestEqu<hardware_t, inst_t>>{}, "");
+  lib.AddInst("TestNEqu", DirectInst<sgp::inst_impl::Inst_TestNEqu<hardware_t, inst_t>>{}, "");
+  lib.AddInst("TestLess", DirectInst<sgp::inst_impl::Inst_TestLess<hardware_t, inst_t>>{}, "");
+  lib.AddInst("TestLessEqu", DirectInst<sgp::inst_impl::Inst_TestLessEqu<hardware_t, inst_t>>{}, "");
+  lib.AddInst("TestGreater", DirectInst<sgp::inst_impl::Inst_TestGreater<hardware_t, inst_t>>{}, "");
+  lib.AddInst("TestGreaterEqu", DirectInst<sgp::inst_impl::Inst_TestGreaterEqu<hardware_t, inst_t>>{}, "");
+  lib.AddInst("SetMem", DirectInst<sgp::inst_impl::Inst_SetMem<hardware_t, inst_t>>{}, "");
+  lib.AddInst("Close", DirectInst<sgp::inst_impl::Inst_Close<hardware_t, inst_t>>{}, "", {inst_prop_t::BLOCK_CLOSE});
+  lib.AddInst("Break", DirectInst<sgp::inst_impl::Inst_Break<hardware_t, inst_t>>{}, "");
+  lib.AddInst("Call", DirectInst<sgp::inst_impl::Inst_Call<hardware_t, inst_t>>{}, "");
+  lib.AddInst("Return", DirectInst<sgp::inst_impl::Inst_Return<hardware_t, inst_t>>{}, "");
+  lib.AddInst("CopyMem", DirectInst<sgp::inst_impl::Inst_CopyMem<hardware_t, inst_t>>{}, "");
+  lib.AddInst("SwapMem", DirectInst<sgp::inst_impl::Inst_SwapMem<hardware_t, inst_t>>{}, "");
+  lib.AddInst("InputToWorking", DirectInst<sgp::inst_impl::Inst_InputToWorking<hardware_t, inst_t>>{}, "");
+  lib.AddInst("WorkingToOutput", DirectInst<sgp::inst_impl::Inst_WorkingToOutput<hardware_t, inst_t>>{}, "");
+  lib.AddInst("Fork", DirectInst<sgp::inst_impl::Inst_Fork<hardware_t, inst_t>>{}, "");
+  lib.AddInst("Terminate", DirectInst<sgp::inst_impl::Inst_Terminate<hardware_t, inst_t>>{}, "");
+  lib.AddInst("If", DirectInst<sgp::lfp_inst_impl::Inst_If<hardware_t, inst_t>>{}, "", {inst_prop_t::BLOCK_DEF});
+  lib.AddInst("While", DirectInst<sgp::lfp_inst_impl::Inst_While<hardware_t, inst_t>>{}, "", {inst_prop_t::BLOCK_DEF});
+  lib.AddInst("Routine", DirectInst<sgp::lfp_inst_impl::Inst_Routine<hardware_t, inst_t>>{}, "");
+  lib.AddInst("Terminal", DirectInst<sgp::inst_impl::Inst_Terminal<hardware_t, inst_t, std::ratio<1>, std::ratio<-1>>>{}, "");
 
   // If we can use global memory, give programs access. Otherwise, nops.
   if (USE_GLOBAL_MEMORY) {
-    inst_lib->AddInst(
+    lib.AddInst(
       "WorkingToGlobal",
-      [this](hardware_t & hw, const inst_t & inst) {
-        if (!KO_GLOBAL_MEMORY) sgp::inst_impl::Inst_WorkingToGlobal<hardware_t, inst_t>(hw, inst);
+      [](hardware_t & hw, const inst_t & inst) {
+        if constexpr (!KNOCKOUTS_T::global_memory) sgp::inst_impl::Inst_WorkingToGlobal<hardware_t, inst_t>(hw, inst);
       },
       "Push working memory to global memory"
     );
-    inst_lib->AddInst(
+    lib.AddInst(
       "GlobalToWorking",
-      [this](hardware_t & hw, const inst_t & inst) {
-        if (!KO_GLOBAL_MEMORY) sgp::inst_impl::Inst_GlobalToWorking<hardware_t, inst_t>(hw, inst);
+      [](hardware_t & hw, const inst_t & inst) {
+        if constexpr (!KNOCKOUTS_T::global_memory) sgp::inst_impl::Inst_GlobalToWorking<hardware_t, inst_t>(hw, inst);
       },
       "Pull global memory into working memory"
     );
 
-    inst_lib->AddInst(
+    lib.AddInst(
       "FullWorkingToGlobal",
-      [this](hardware_t & hw, const inst_t & inst) {
-        if (!KO_GLOBAL_MEMORY) sgp::inst_impl::Inst_FullWorkingToGlobal<hardware_t, inst_t>(hw, inst);
+      [](hardware_t & hw, const inst_t & inst) {
+        if constexpr (!KNOCKOUTS_T::global_memory) sgp::inst_impl::Inst_FullWorkingToGlobal<hardware_t, inst_t>(hw, inst);
       },
       "Push all working memory to global memory"
     );
-    inst_lib->AddInst(
+    lib.AddInst(
       "FullGlobalToWorking",
-      [this](hardware_t & hw, const inst_t & inst) {
-        if (!KO_GLOBAL_MEMORY) sgp::inst_impl::Inst_FullGlobalToWorking<hardware_t, inst_t>(hw, inst);
+      [](hardware_t & hw, const inst_t & inst) {
+        if constexpr (!KNOCKOUTS_T::global_memory) sgp::inst_impl::Inst_FullGlobalToWorking<hardware_t, inst_t>(hw, inst);
       },
       "Pull all global memory into working memory"
     );
   } else {
-    inst_lib->AddInst("Nop-WorkingToGlobal", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "Nop");
-    inst_lib->AddInst("Nop-GlobalToWorking", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "Nop");
-    inst_lib->AddInst("Nop-FullWorkingToGlobal", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "Nop");
-    inst_lib->AddInst("Nop-FullGlobalToWorking", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "Nop");
+    lib.AddInst("Nop-WorkingToGlobal", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "Nop");
+    lib.AddInst("Nop-GlobalToWorking", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "Nop");
+    lib.AddInst("Nop-FullWorkingToGlobal", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "Nop");
+    lib.AddInst("Nop-FullGlobalToWorking", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "Nop");
   }
 
   // If we can use regulation, add regulation instructions; otherwise, add an equivalent number of
   // no-operation instructions.
   if (USE_FUNC_REGULATION) {
-    inst_lib->AddInst("SetRegulator", [this](hardware_t & hw, const inst_t & inst) {
-      if (KO_REGULATION) {
+    lib.AddInst("SetRegulator", [](hardware_t & hw, const inst_t & inst) {
+      if constexpr (KNOCKOUTS_T::regulation) {
         return;
-      } else if (KO_DOWN_REGULATION) {
+      } else if constexpr (KNOCKOUTS_T::down_regulation) {
         inst_impls::Inst_SetRegulator_KO_DOWN_REG<hardware_t, inst_t>(hw, inst);
-      } else if (KO_UP_REGULATION) {
+      } else if constexpr (KNOCKOUTS_T::up_regulation) {
         inst_impls::Inst_SetRegulator_KO_UP_REG<hardware_t, inst_t>(hw, inst);
       } else {
         sgp::inst_impl::Inst_SetRegulator<hardware_t, inst_t>(hw, inst);
       }
     }, "");
-    inst_lib->AddInst("SetRegulator-", [this](hardware_t & hw, const inst_t & inst) {
-      if (KO_REGULATION) {
+    lib.AddInst("SetRegulator-", [](hardware_t & hw, const inst_t & inst) {
+      if constexpr (KNOCKOUTS_T::regulation) {
         return;
-      } else if (KO_DOWN_REGULATION) {
+      } else if constexpr (KNOCKOUTS_T::down_regulation) {
         inst_impls::Inst_SetRegulator_KO_DOWN_REG<hardware_t, inst_t, -1>(hw, inst);
-      } else if (KO_UP_REGULATION) {
+      } else if constexpr (KNOCKOUTS_T::up_regulation) {
         inst_impls::Inst_SetRegulator_KO_UP_REG<hardware_t, inst_t, -1>(hw, inst);
       } else {
         sgp::inst_impl::Inst_SetRegulator<hardware_t, inst_t, -1>(hw, inst);
       }
     }, "");
 
-    inst_lib->AddInst("SetOwnRegulator", [this](hardware_t & hw, const inst_t & inst) {
-      if (KO_REGULATION) {
+    lib.AddInst("SetOwnRegulator", [](hardware_t & hw, const inst_t & inst) {
+      if constexpr (KNOCKOUTS_T::regulation) {
         return;
-      } else if (KO_DOWN_REGULATION) {
+      } else if constexpr (KNOCKOUTS_T::down_regulation) {
         inst_impls::Inst_SetOwnRegulator_KO_DOWN_REG<hardware_t, inst_t>(hw, inst);
-      } else if (KO_UP_REGULATION) {
+      } else if constexpr (KNOCKOUTS_T::up_regulation) {
         inst_impls::Inst_SetOwnRegulator_KO_UP_REG<hardware_t, inst_t>(hw, inst);
       } else {
         sgp::inst_impl::Inst_SetOwnRegulator<hardware_t, inst_t>(hw, inst);
       }
     }, "");
-    inst_lib->AddInst("SetOwnRegulator-", [this](hardware_t & hw, const inst_t & inst) {
-      if (KO_REGULATION) {
+    lib.AddInst("SetOwnRegulator-", [](hardware_t & hw, const inst_t & inst) {
+      if constexpr (KNOCKOUTS_T::regulation) {
         return;
-      } else if (KO_DOWN_REGULATION) {
+      } else if constexpr (KNOCKOUTS_T::down_regulation) {
         inst_impls::Inst_SetOwnRegulator_KO_DOWN_REG<hardware_t, inst_t, -1>(hw, inst);
-      } else if (KO_UP_REGULATION) {
+      } else if constexpr (KNOCKOUTS_T::up_regulation) {
         inst_impls::Inst_SetOwnRegulator_KO_UP_REG<hardware_t, inst_t, -1>(hw, inst);
       } else {
         sgp::inst_impl::Inst_SetOwnRegulator<hardware_t, inst_t, -1>(hw, inst);
       }
     }, "");
-    inst_lib->AddInst("AdjRegulator", [this](hardware_t & hw, const inst_t & inst) {
-      if (KO_REGULATION) {
+    lib.AddInst("AdjRegulator", [](hardware_t & hw, const inst_t & inst) {
+      if constexpr (KNOCKOUTS_T::regulation) {
         return;
-      } else if (KO_DOWN_REGULATION) {
+      } else if constexpr (KNOCKOUTS_T::down_regulation) {
         inst_impls::Inst_AdjRegulator_KO_DOWN_REG<hardware_t, inst_t>(hw, inst);
-      } else if (KO_UP_REGULATION) {
+      } else if constexpr (KNOCKOUTS_T::up_regulation) {
         inst_impls::Inst_AdjRegulator_KO_UP_REG<hardware_t, inst_t>(hw, inst);
       } else {
         sgp::inst_impl::Inst_AdjRegulator<hardware_t, inst_t>(hw, inst);
       }
     }, "");
-    inst_lib->AddInst("AdjRegulator-", [this](hardware_t & hw, const inst_t & inst) {
-      if (KO_REGULATION) {
+    lib.AddInst("AdjRegulator-", [](hardware_t & hw, const inst_t & inst) {
+      if constexpr (KNOCKOUTS_T::regulation) {
         return;
-      } else if (KO_DOWN_REGULATION) {
+      } else if constexpr (KNOCKOUTS_T::down_regulation) {
         inst_impls::Inst_AdjRegulator_KO_DOWN_REG<hardware_t, inst_t, -1>(hw, inst);
-      } else if (KO_UP_REGULATION) {
+      } else if constexpr (KNOCKOUTS_T::up_regulation) {
         inst_impls::Inst_AdjRegulator_KO_UP_REG<hardware_t, inst_t, -1>(hw, inst);
       } else {
         sgp::inst_impl::Inst_AdjRegulator<hardware_t, inst_t, -1>(hw, inst);
       }
     }, "");
-    inst_lib->AddInst("AdjOwnRegulator", [this](hardware_t & hw, const inst_t & inst) {
-      if (KO_REGULATION) {
+    lib.AddInst("AdjOwnRegulator", [](hardware_t & hw, const inst_t & inst) {
+      if constexpr (KNOCKOUTS_T::regulation) {
         return;
-      } else if (KO_DOWN_REGULATION) {
+      } else if constexpr (KNOCKOUTS_T::down_regulation) {
         inst_impls::Inst_AdjOwnRegulator_KO_DOWN_REG<hardware_t, inst_t>(hw, inst);
-      } else if (KO_UP_REGULATION) {
+      } else if constexpr (KNOCKOUTS_T::up_regulation) {
         inst_impls::Inst_AdjOwnRegulator_KO_UP_REG<hardware_t, inst_t>(hw, inst);
       } else {
         sgp::inst_impl::Inst_AdjOwnRegulator<hardware_t, inst_t>(hw, inst);
       }
     }, "");
-    inst_lib->AddInst("AdjOwnRegulator-", [this](hardware_t & hw, const inst_t & inst) {
-      if (KO_REGULATION) {
+    lib.AddInst("AdjOwnRegulator-", [](hardware_t & hw, const inst_t & inst) {
+      if constexpr (KNOCKOUTS_T::regulation) {
         return;
-      } else if (KO_DOWN_REGULATION) {
+      } else if constexpr (KNOCKOUTS_T::down_regulation) {
         inst_impls::Inst_AdjOwnRegulator_KO_DOWN_REG<hardware_t, inst_t, -1>(hw, inst);
-      } else if (KO_UP_REGULATION) {
+      } else if constexpr (KNOCKOUTS_T::up_regulation) {
         inst_impls::Inst_AdjOwnRegulator_KO_UP_REG<hardware_t, inst_t, -1>(hw, inst);
       } else {
         sgp::inst_impl::Inst_AdjOwnRegulator<hardware_t, inst_t, -1>(hw, inst);
       }
     }, "");
-    inst_lib->AddInst("ClearRegulator", [this](hardware_t & hw, const inst_t & inst) {
-      if (KO_REGULATION) {
+    lib.AddInst("ClearRegulator", [](hardware_t & hw, const inst_t & inst) {
+      if constexpr (KNOCKOUTS_T::regulation) {
         return;
-      } else if (KO_DOWN_REGULATION) {
+      } else if constexpr (KNOCKOUTS_T::down_regulation) {
         inst_impls::Inst_ClearRegulator_KO_DOWN_REG<hardware_t, inst_t>(hw, inst);
-      } else if (KO_UP_REGULATION) {
+      } else if constexpr (KNOCKOUTS_T::up_regulation) {
         inst_impls::Inst_ClearRegulator_KO_UP_REG<hardware_t, inst_t>(hw, inst);
       } else {
         sgp::inst_impl::Inst_ClearRegulator<hardware_t, inst_t>(hw, inst);
       }
     }, "");
-    inst_lib->AddInst("ClearOwnRegulator", [this](hardware_t & hw, const inst_t & inst) {
-      if (KO_REGULATION) {
+    lib.AddInst("ClearOwnRegulator", [](hardware_t & hw, const inst_t & inst) {
+      if constexpr (KNOCKOUTS_T::regulation) {
         return;
-      } else if (KO_DOWN_REGULATION) {
+      } else if constexpr (KNOCKOUTS_T::down_regulation) {
         inst_impls::Inst_ClearOwnRegulator_KO_DOWN_REG<hardware_t, inst_t>(hw, inst);
-      } else if (KO_UP_REGULATION) {
+      } else if constexpr (KNOCKOUTS_T::up_regulation) {
         inst_impls::Inst_ClearOwnRegulator_KO_UP_REG<hardware_t, inst_t>(hw, inst);
       } else {
         sgp::inst_impl::Inst_ClearOwnRegulator<hardware_t, inst_t>(hw, inst);
       }
     }, "");
-    inst_lib->AddInst("SenseRegulator", [this](hardware_t & hw, const inst_t & inst) {
-      if (!KO_REGULATION) sgp::inst_impl::Inst_SenseRegulator<hardware_t, inst_t>(hw, inst);
+    lib.AddInst("SenseRegulator", [](hardware_t & hw, const inst_t & inst) {
+      if constexpr (!KNOCKOUTS_T::regulation) sgp::inst_impl::Inst_SenseRegulator<hardware_t, inst_t>(hw, inst);
     }, "");
-    inst_lib->AddInst("SenseOwnRegulator", [this](hardware_t & hw, const inst_t & inst) {
-      if (!KO_REGULATION) sgp::inst_impl::Inst_SenseOwnRegulator<hardware_t, inst_t>(hw, inst);
+    lib.AddInst("SenseOwnRegulator", [](hardware_t & hw, const inst_t & inst) {
+      if constexpr (!KNOCKOUTS_T::regulation) sgp::inst_impl::Inst_SenseOwnRegulator<hardware_t, inst_t>(hw, inst);
     }, "");
-    inst_lib->AddInst("IncRegulator", [this](hardware_t & hw, const inst_t & inst) {
-      if (KO_REGULATION || KO_DOWN_REGULATION) {
+    lib.AddInst("IncRegulator", [](hardware_t & hw, const inst_t & inst) {
+      if constexpr (KNOCKOUTS_T::regulation || KNOCKOUTS_T::down_regulation) {
         return;
       } else {
         sgp::inst_impl::Inst_IncRegulator<hardware_t, inst_t>(hw, inst);
       }
     }, "");
-    inst_lib->AddInst("IncOwnRegulator", [this](hardware_t & hw, const inst_t & inst) {
-      if (KO_REGULATION || KO_DOWN_REGULATION) {
+    lib.AddInst("IncOwnRegulator", [](hardware_t & hw, const inst_t & inst) {
+      if constexpr (KNOCKOUTS_T::regulation || KNOCKOUTS_T::down_regulation) {
         return;
       } else {
         sgp::inst_impl::Inst_IncOwnRegulator<hardware_t, inst_t>(hw, inst);
       }
      }, "");
-    inst_lib->AddInst("DecRegulator", [this](hardware_t & hw, const inst_t & inst) {
-      if (KO_REGULATION || KO_UP_REGULATION) {
+    lib.AddInst("DecRegulator", [](hardware_t & hw, const inst_t & inst) {
+      if constexpr (KNOCKOUTS_T::regulation || KNOCKOUTS_T::up_regulation) {
         return;
       } else {
         sgp::inst_impl::Inst_DecRegulator<hardware_t, inst_t>(hw, inst);
       }
     }, "");
-    inst_lib->AddInst("DecOwnRegulator", [this](hardware_t & hw, const inst_t & inst) {
-      if (KO_REGULATION || KO_UP_REGULATION) {
+    lib.AddInst("DecOwnRegulator", [](hardware_t & hw, const inst_t & inst) {
+      if constexpr (KNOCKOUTS_T::regulation || KNOCKOUTS_T::up_regulation) {
         return;
       } else {
         sgp::inst_impl::Inst_DecOwnRegulator<hardware_t, inst_t>(hw, inst);
       }
     }, "");
   } else {
-    inst_lib->AddInst("Nop-SetRegulator", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "");
-    inst_lib->AddInst("Nop-SetOwnRegulator", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "");
-    inst_lib->AddInst("Nop-AdjRegulator", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "");
-    inst_lib->AddInst("Nop-AdjOwnRegulator", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "");
-    inst_lib->AddInst("Nop-SetRegulator-", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "");
-    inst_lib->AddInst("Nop-SetOwnRegulator-", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "");
-    inst_lib->AddInst("Nop-AdjRegulator-", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "");
-    inst_lib->AddInst("Nop-AdjOwnRegulator-", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "");
-    inst_lib->AddInst("Nop-ClearRegulator", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "");
-    inst_lib->AddInst("Nop-ClearOwnRegulator", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "");
-    inst_lib->AddInst("Nop-SenseRegulator", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "");
-    inst_lib->AddInst("Nop-SenseOwnRegulator", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "");
-    inst_lib->AddInst("Nop-IncRegulator", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "");
-    inst_lib->AddInst("Nop-IncOwnRegulator", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "");
-    inst_lib->AddInst("Nop-DecRegulator", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "");
-    inst_lib->AddInst("Nop-DecOwnRegulator", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "");
+    lib.AddInst("Nop-SetRegulator", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "");
+    lib.AddInst("Nop-SetOwnRegulator", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "");
+    lib.AddInst("Nop-AdjRegulator", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "");
+    lib.AddInst("Nop-AdjOwnRegulator", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "");
+    lib.AddInst("Nop-SetRegulator-", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "");
+    lib.AddInst("Nop-SetOwnRegulator-", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "");
+    lib.AddInst("Nop-AdjRegulator-", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "");
+    lib.AddInst("Nop-AdjOwnRegulator-", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "");
+    lib.AddInst("Nop-ClearRegulator", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "");
+    lib.AddInst("Nop-ClearOwnRegulator", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "");
+    lib.AddInst("Nop-SenseRegulator", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "");
+    lib.AddInst("Nop-SenseOwnRegulator", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "");
+    lib.AddInst("Nop-IncRegulator", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "");
+    lib.AddInst("Nop-IncOwnRegulator", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "");
+    lib.AddInst("Nop-DecRegulator", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "");
+    lib.AddInst("Nop-DecOwnRegulator", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "");
   }
 
   // Add one response instruction for each possible response (equal to the number of possible environment states).
   for (size_t i = 0; i < NUM_SIGNAL_RESPONSES; ++i) {
-    inst_lib->AddInst("Response-" + emp::to_string(i), [this, i](hardware_t & hw, const inst_t & inst) {
+    lib.AddInst("Response-" + emp::to_string(i), [this, i](hardware_t & hw, const inst_t & inst) {
       const auto & call_state = hw.GetCurThread().GetExecState().GetTopCallState();
       const auto & flow = call_state.GetTopFlow();
       const size_t mp = flow.GetMP();
@@ -934,6 +1045,11 @@ void AltSignalWorld::InitDataCollection() {
   max_fit_file->template AddFun<size_t>([this]() {
     return this->GetOrg(max_fit_org_tracker.org_id).GetPhenotype().GetNoResponses();
   }, "num_no_responses");
+  max_fit_file->template AddFun<size_t>([this]() { return phen_cache.GetHits(); }, "phen_cache_hits");
+  max_fit_file->template AddFun<size_t>([this]() { return phen_cache.GetMisses(); }, "phen_cache_misses");
+  max_fit_file->template AddFun<size_t>([this]() {
+    return eval_hardware->GetCustomComponent().cycles_used;
+  }, "cpu_cycles_used");
   max_fit_file->template AddFun<size_t>([this]() {
     return this->GetOrg(max_fit_org_tracker.org_id).GetGenome().GetProgram().GetSize();
   }, "num_modules");
@@ -953,9 +1069,25 @@ void AltSignalWorld::InitDataCollection() {
 /// Evaluate entire population.
 void AltSignalWorld::DoEvaluation() {
   max_fit_org_tracker.org_id = 0;
+  phen_cache.ResetCounters();
+  eval_hardware->GetCustomComponent().cycles_used = 0;
   for (size_t org_id = 0; org_id < this->GetSize(); ++org_id) {
     emp_assert(this->IsOccupied(org_id));
-    EvaluateOrg(this->GetOrg(org_id));
+    org_t & org = this->GetOrg(org_id);
+    if (phen_cache.IsEnabled()) {
+      // Evaluation is deterministic, so we only need to run genomes we haven't seen recently.
+      const program_t & program = org.GetGenome().GetProgram();
+      const size_t program_hash = HashProgram(program);
+      if (phen_cache.Get(program, program_hash, org.GetPhenotype())) {
+        phen_cache.RecordHits();
+      } else {
+        EvaluateOrg(org);
+        phen_cache.Put(program, program_hash, org.GetPhenotype());
+        phen_cache.RecordMisses();
+      }
+    } else {
+      EvaluateOrg(org);
+    }
     if (CalcFitnessID(org_id) > CalcFitnessID(max_fit_org_tracker.org_id)) max_fit_org_tracker.org_id = org_id;
     // Record phenotype information for this taxon
     after_eval_sig.Trigger(org_id);
@@ -992,27 +1124,24 @@ void AltSignalWorld::DoUpdate() {
 }
 
 /// Evaluate a single organism.
-void AltSignalWorld::EvaluateOrg(org_t & org) {
+void AltSignalWorld::EvaluateOrg(hardware_t & hw, org_t & org) {
   eval_environment.ResetEnv();
   org.GetPhenotype().Reset();
   // Ready the hardware! Load organism program, reset the custom hardware component.
-  eval_hardware->SetProgram(org.GetGenome().program);
-  emp_assert(eval_hardware->ValidateThreadState());
-  emp_assert(eval_hardware->GetActiveThreadIDs().size() == 0);
+  hw.SetProgram(org.GetGenome().program);
+  hw.GetMatchBin().LoadProgram(hw.GetProgram());
+  emp_assert(hw.ValidateThreadState());
+  emp_assert(hw.GetActiveThreadIDs().size() == 0);
   // Evaluate organism in the environment!
   for (size_t cycle = 0; cycle < NUM_ENV_CYCLES; ++cycle) {
-    eval_hardware->ResetBaseHardwareState(); // Reset threads every cycle.
-    eval_hardware->GetCustomComponent().Reset();
-    emp_assert(eval_hardware->GetActiveThreadIDs().size() == 0);
-    eval_hardware->QueueEvent(event_t(event_id__env_sig, eval_environment.env_signal_tag));
+    hw.ResetBaseHardwareState(); // Reset threads every cycle.
+    hw.GetCustomComponent().Reset();
+    emp_assert(hw.GetActiveThreadIDs().size() == 0);
+    hw.QueueEvent(event_t(event_id__env_sig, eval_environment.env_signal_tag));
     // Step hardware! If at any point there are no active || pending threads, we're done!
-    for (size_t step = 0; step < CPU_TIME_PER_ENV_CYCLE; ++step) {
-      eval_hardware->SingleProcess();
-      // auto information = GetHardwareStatePrintInfo(*eval_hardware);
-      if (!(eval_hardware->GetNumActiveThreads() || eval_hardware->GetNumPendingThreads())) break;
-    }
+    hw.GetCustomComponent().cycles_used += RunUntilQuiescent(hw, CPU_TIME_PER_ENV_CYCLE);
     // Did hardware consume the resource?
-    const int org_response = eval_hardware->GetCustomComponent().response;
+    const int org_response = hw.GetCustomComponent().response;
     if (org_response == (int)eval_environment.cur_state) {
       // Correct response!
       org.GetPhenotype().resources_consumed += 1;
@@ -1056,47 +1185,22 @@ void AltSignalWorld::AnalyzeOrg(const org_t & org, size_t org_id/*=0*/) {
   // (2) Run a full trace of this organism.
   TraceOrganism(org, org_id);
   ////////////////////////////////////////////////
-  // (3) Run with knockouts
+  // (3) Run with knockouts (each on hardware running the matching knockout instruction library)
   //     - ko memory
-  KO_GLOBAL_MEMORY = true;
-  KO_REGULATION = false;
-  KO_UP_REGULATION = false;
-  KO_DOWN_REGULATION = false;
   org_t ko_mem_org(org);
-  EvaluateOrg(ko_mem_org);
+  EvaluateOrg(*ko_hardware[(size_t)KnockoutMode::GLOBAL_MEMORY], ko_mem_org);
   //     - ko regulation
-  KO_GLOBAL_MEMORY = false;
-  KO_REGULATION = true;
-  KO_UP_REGULATION = false;
-  KO_DOWN_REGULATION = false;
   org_t ko_reg_org(org);
-  EvaluateOrg(ko_reg_org);
+  EvaluateOrg(*ko_hardware[(size_t)KnockoutMode::REGULATION], ko_reg_org);
   //     - ko memory & ko regulation
-  KO_GLOBAL_MEMORY = true;
-  KO_REGULATION = true;
-  KO_UP_REGULATION = false;
-  KO_DOWN_REGULATION = false;
   org_t ko_all_org(org);
-  EvaluateOrg(ko_all_org);
+  EvaluateOrg(*ko_hardware[(size_t)KnockoutMode::GLOBAL_MEMORY_AND_REGULATION], ko_all_org);
   //    - ko up-regulation (promotors)
-  KO_GLOBAL_MEMORY = false;
-  KO_REGULATION = false;
-  KO_UP_REGULATION = true;
-  KO_DOWN_REGULATION = false;
   org_t ko_up_reg_org(org);
-  EvaluateOrg(ko_up_reg_org);
+  EvaluateOrg(*ko_hardware[(size_t)KnockoutMode::UP_REGULATION], ko_up_reg_org);
   //    - ko down-regulation (repressors)
-  KO_GLOBAL_MEMORY = false;
-  KO_REGULATION = false;
-  KO_UP_REGULATION = false;
-  KO_DOWN_REGULATION = true;
   org_t ko_down_reg_org(org);
-  EvaluateOrg(ko_down_reg_org);
-  // Reset KO variables to both be false
-  KO_GLOBAL_MEMORY = false;
-  KO_REGULATION = false;
-  KO_UP_REGULATION = false;
-  KO_DOWN_REGULATION = false;
+  EvaluateOrg(*ko_hardware[(size_t)KnockoutMode::DOWN_REGULATION], ko_down_reg_org);
   ////////////////////////////////////////////////
   // (4) Setup and write to analysis output file
   // note: I'll arbitrarily use test_org 0 as canonical version
@@ -1158,13 +1262,8 @@ void AltSignalWorld::TraceOrganism(const org_t & org, size_t org_id/*=0*/) {
   HardwareStatePrintInfo hw_state_info;
   size_t env_cycle=0;
   size_t cpu_step=0;
-  emp::vector<inst_t> executed_instructions;
-
-  inst_lib->OnBeforeInstExec(
-    [&executed_instructions](hardware_t & hw, const inst_t & inst) {
-      executed_instructions.emplace_back(inst);
-    }
-  );
+  // trace_hardware runs the tracing instruction library, which records executed instructions.
+  traced_instructions.clear();
 
   // ----- Timing information -----
   trace_file.template AddFun<size_t>([&env_cycle]() {
@@ -1191,14 +1290,14 @@ void AltSignalWorld::TraceOrganism(const org_t & org, size_t org_id/*=0*/) {
   // ----- Hardware Information -----
   //    * current response
   trace_file.template AddFun<int>([this]() {
-    return eval_hardware->GetCustomComponent().response;
+    return trace_hardware->GetCustomComponent().response;
   }, "cur_response");
   trace_file.template AddFun<int>([this]() {
-    return eval_hardware->GetCustomComponent().response_function_id;
+    return trace_hardware->GetCustomComponent().response_function_id;
   }, "cur_responding_function");
   //    * correct responses
   trace_file.template AddFun<bool>([&trace_org, this]() {
-    return eval_hardware->GetCustomComponent().response == (int)eval_environment.cur_state;
+    return trace_hardware->GetCustomComponent().response == (int)eval_environment.cur_state;
   }, "has_correct_response");
   //    * num_modules
   trace_file.template AddFun<size_t>([&hw_state_info]() {
@@ -1217,14 +1316,14 @@ void AltSignalWorld::TraceOrganism(const org_t & org, size_t org_id/*=0*/) {
   }, "module_regulator_states");
   //    * which module would be triggered by the environment signal?
   trace_file.template AddFun<int>([this]() {
-    const auto matches = eval_hardware->GetMatchBin().Match(eval_environment.env_signal_tag);
+    const auto matches = trace_hardware->GetMatchBin().Match(eval_environment.env_signal_tag);
     if (matches.size()) return (int)matches[0];
     else return -1;
   }, "env_signal_closest_match");
   //    * match scores against environment signal tag for each module
   trace_file.template AddFun<std::string>([this]() {
-    const auto match_scores = eval_hardware->GetMatchBin().ComputeMatchScores(eval_environment.env_signal_tag);
-    emp::vector<double> scores(eval_hardware->GetNumModules());
+    const auto match_scores = trace_hardware->GetMatchBin().ComputeMatchScores(eval_environment.env_signal_tag);
+    emp::vector<double> scores(trace_hardware->GetNumModules());
     std::ostringstream stream;
     for (const auto & pair : match_scores) {
       const size_t module_id = pair.first;
@@ -1261,15 +1360,15 @@ void AltSignalWorld::TraceOrganism(const org_t & org, size_t org_id/*=0*/) {
   }, "num_active_threads");
 
   trace_file.template AddFun<std::string>(
-    [&executed_instructions, this]() {
+    [this]() {
       std::ostringstream stream;
       stream << "\"[";
-      for (size_t i = 0; i < executed_instructions.size(); ++i) {
+      for (size_t i = 0; i < traced_instructions.size(); ++i) {
         if (i) stream << ",";
-        stream << inst_lib->GetName(executed_instructions[i].GetID());
+        stream << inst_lib->GetName(traced_instructions[i].GetID());
       }
       stream << "]\"";
-      executed_instructions.clear();
+      traced_instructions.clear();
       return stream.str();
     },
     "executed_instructions"
@@ -1284,29 +1383,29 @@ void AltSignalWorld::TraceOrganism(const org_t & org, size_t org_id/*=0*/) {
   eval_environment.ResetEnv();
   trace_org.GetPhenotype().Reset();
   // Ready the hardware! Load organism program, reset the custom hardware component.
-  eval_hardware->SetProgram(trace_org.GetGenome().program);
-  emp_assert(eval_hardware->ValidateThreadState());
-  emp_assert(eval_hardware->GetActiveThreadIDs().size() == 0);
+  trace_hardware->SetProgram(trace_org.GetGenome().program);
+  emp_assert(trace_hardware->ValidateThreadState());
+  emp_assert(trace_hardware->GetActiveThreadIDs().size() == 0);
   // Evaluate organism in the environment!
   for (env_cycle = 0; env_cycle < NUM_ENV_CYCLES; ++env_cycle) {
-    eval_hardware->ResetBaseHardwareState(); // Reset threads every cycle.
-    eval_hardware->GetCustomComponent().Reset();
-    emp_assert(eval_hardware->GetActiveThreadIDs().size() == 0);
-    eval_hardware->QueueEvent(event_t(event_id__env_sig, eval_environment.env_signal_tag));
+    trace_hardware->ResetBaseHardwareState(); // Reset threads every cycle.
+    trace_hardware->GetCustomComponent().Reset();
+    emp_assert(trace_hardware->GetActiveThreadIDs().size() == 0);
+    trace_hardware->QueueEvent(event_t(event_id__env_sig, eval_environment.env_signal_tag));
     // Step hardware! If at any point there are no active || pending threads, we're done!
     // => Trace! <=
     cpu_step = 0;
-    hw_state_info = GetHardwareStatePrintInfo(*eval_hardware);
+    hw_state_info = GetHardwareStatePrintInfo(*trace_hardware);
     trace_file.Update(); // Always output state BEFORE time step advances
     while (cpu_step < CPU_TIME_PER_ENV_CYCLE) {
-      eval_hardware->SingleProcess();
+      trace_hardware->SingleProcess();
       ++cpu_step;
-      hw_state_info = GetHardwareStatePrintInfo(*eval_hardware);
+      hw_state_info = GetHardwareStatePrintInfo(*trace_hardware);
       trace_file.Update();
-      if (!(eval_hardware->GetNumActiveThreads() || eval_hardware->GetNumPendingThreads())) break;
+      if (!(trace_hardware->GetNumActiveThreads() || trace_hardware->GetNumPendingThreads())) break;
     }
     // Did hardware consume the resource?
-    const int org_response = eval_hardware->GetCustomComponent().response;
+    const int org_response = trace_hardware->GetCustomComponent().response;
     if (org_response == (int)eval_environment.cur_state) {
       // Correct response!
       trace_org.GetPhenotype().resources_consumed += 1;
@@ -1320,8 +1419,6 @@ void AltSignalWorld::TraceOrganism(const org_t & org, size_t org_id/*=0*/) {
     }
     eval_environment.AdvanceEnv();
   }
-
-  inst_lib->ResetBeforeInstExecSignal();
 }
 
 // -- utilities --
@@ -1583,6 +1680,9 @@ void AltSignalWorld::Setup(const AltSignalConfig & config) {
   InitEnvironment();
   // Initialize organism mutators!
   InitMutator();
+  // Clear out any remembered phenotypes.
+  phen_cache.Clear();
+  phen_cache.SetCapacity(PHENOTYPE_CACHE_SIZE);
 
   // How should population be initialized?
   end_setup_sig.AddAction([this]() {
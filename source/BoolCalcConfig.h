@@ -15,11 +15,16 @@ EMP_BUILD_CONFIG(BoolCalcConfig,
     VALUE(TRAINING_SET_FILE, std::string, "./training_cases.csv", "Path to the csv containing training test cases to use to determine if a program is a solution."),
     VALUE(CPU_CYCLES_PER_INPUT_SIGNAL, size_t, 128, "How many cpu cycles do we give programs to respond to each input signal?"),
     VALUE(CATEGORICAL_OUTPUT, bool, false, "Output numbers represent discrete categories?"),
+    VALUE(NUM_EVAL_THREADS, size_t, 1, "How many worker threads should we use to evaluate the population? (1 = serial evaluation)"),
+    VALUE(PHENOTYPE_CACHE_SIZE, size_t, 0, "How many genomes' test scores should we remember across generations? (0 = no caching)"),
+    VALUE(INHERIT_NEUTRAL_PHENOTYPES, bool, false, "Should offspring whose mutations only touch unreachable functions (or Nop operands) inherit their parent's test scores?"),
+    VALUE(SHARE_TEST_PREFIXES, bool, false, "Should each program run input signal sequences shared by several training cases only once (resuming from saved hardware state)?"),
 
   GROUP(SELECTION_GROUP, "Selection settings"),
     VALUE(DOWN_SAMPLE, bool, false, "Should we down-sample the testing set for evaluation?"),
     VALUE(DOWN_SAMPLE_RATE, double, 0.25, "What proportion of the test cases should we use each generation?"),
     VALUE(SAMPLE_BY_TEST_TYPE, bool, true, "Should we down sample each test case type instead of naively sampling all test cases?"),
+    VALUE(LAZY_LEXICASE, bool, false, "Should we only evaluate organisms on test cases as lexicase selection reaches them? (selected parents are identical either way)"),
 
   GROUP(PROGRAM_GROUP, "Program settings"),
     VALUE(USE_FUNC_REGULATION, bool, true, "Do programs have access to function regulation instructions?"),
@@ -50,6 +55,15 @@ EMP_BUILD_CONFIG(BoolCalcConfig,
     VALUE(MUT_RATE__INST_TAG_SEQ_RAND, double, 0.0, "Per-tag sequence randomization rate"),
     VALUE(MUT_RATE__FUNC_TAG_SEQ_RAND, double, 0.0, "Per-tag sequence randomization rate"),
 
+  GROUP(MATCHBIN_GROUP, "Matchbin settings (only used by bool-calc-multi; other builds use their compile-time MATCH_* settings)"),
+    VALUE(MATCHBIN_METRIC, std::string, "streak", "Tag metric (as MATCH_METRIC: hamming, hash, integer, integer-symmetric, streak, streak-exact, streak-simd)"),
+    VALUE(MATCHBIN_THRESH, std::string, "0", "Match threshold (as MATCH_THRESH: 0, 25, 50, 75)"),
+    VALUE(MATCHBIN_REG, std::string, "exp", "Regulator (as MATCH_REG: add, mult, exp, exp-quant)"),
+    VALUE(MATCHBIN_TAG_BITS, size_t, 256, "Tag length in bits (as TAG_NUM_BITS)"),
+    VALUE(MATCHBIN_INDEX, std::string, "emp", "Match index (as MATCH_INDEX: emp, counting, incremental)"),
+    VALUE(MATCHBIN_DECAY, std::string, "step", "Regulator decay (as MATCH_DECAY: step, wheel)"),
+    VALUE(MATCHBIN_TAG_INDEX, std::string, "none", "Top-1 tag index (as MATCH_TAG_INDEX: none, nearest)"),
+
   GROUP(DATA_COLLECTION_GROUP, "Data collection settings"),
     VALUE(OUTPUT_DIR, std::string, "output", "where should we dump output?"),
     VALUE(SUMMARY_RESOLUTION, size_t, 10, "How often should we output summary statistics?"),
@@ -3,6 +3,7 @@
 
 #include <tuple>
 #include <algorithm>
+#include <unordered_map>
 #include "hardware/SignalGP/utils/LinearFunctionsProgram.h"
 // #include "mutation_utils.h"
 
@@ -46,9 +47,11 @@ public:
 
     emp::vector<double> test_scores;  ///< Scores on tests. Each test corresponds to a different signal sequence.
     emp::vector<size_t> test_ids;     ///< Sequence IDs of tests (aligned with test_scores)
+    emp::vector<bool> test_evaluated; ///< Has the corresponding test been run yet? (aligned with test_scores)
     double aggregate_score=0.0;       ///< Aggregate score across all signal sequences tested on (i.e., sum(test_scores))
     size_t num_passes=0;
     bool is_solution=false;
+    std::unordered_map<size_t, double> known_test_scores; ///< Test id => score known without evaluation (e.g., inherited from an equivalent parent). Not cleared by Reset.
 
     void Reset(size_t tests=1) {
       aggregate_score=0.0;         // Reset aggregate score.
@@ -56,8 +59,10 @@ public:
       is_solution=false;
       test_scores.resize(tests);   // Make sure trial scores is right size.
       test_ids.resize(tests);
+      test_evaluated.resize(tests);
       std::fill(test_scores.begin(), test_scores.end(), 0); // Fill with zeroes.
       std::fill(test_ids.begin(), test_ids.end(), 0);
+      std::fill(test_evaluated.begin(), test_evaluated.end(), false);
     }
 
     bool operator==(const this_t & o) const {
@@ -93,6 +98,21 @@ public:
                        o.is_solution
                       );
     }
+    /// Have all tests been evaluated?
+    bool IsComplete() const {
+      return std::all_of(test_evaluated.begin(), test_evaluated.end(), [](bool e) { return e; });
+    }
+
+    /// Recompute aggregate score and number of passes from test scores.
+    void UpdateAggregates() {
+      aggregate_score = 0.0;
+      num_passes = 0;
+      for (size_t i = 0; i < test_scores.size(); ++i) {
+        aggregate_score += test_scores[i];
+        num_passes += (size_t)(test_scores[i] == 1.0);
+      }
+    }
+
     bool IsSolution() const { return is_solution; }
     double GetAggregateScore() const { return aggregate_score; }
   };
@@ -0,0 +1,96 @@
+/***
+ * Boolean logic calculator world variants.
+ *
+ * Holds several fully specialized BoolCalcWorld instantiations (one per world configuration type) in a
+ * single executable. Each variant is compiled exactly as a single-configuration build would compile
+ * it; the only runtime dispatch is choosing which variant's Run function to call at startup.
+ *
+ * Configuration types are structs with BoolCalcBuildConfig's members, listed in a BoolCalcConfigList.
+ * The Makefile's bool-calc-multi target generates them (see MULTI_* options).
+ **/
+
+#ifndef BOOL_CALC_VARIANTS_H
+#define BOOL_CALC_VARIANTS_H
+
+#include <iostream>
+#include <string>
+
+#include "emp/base/vector.hpp"
+
+#include "BoolCalcConfig.h"
+#include "BoolCalcWorld.h"
+
+/// List of BoolCalcWorld configuration types.
+template<typename... CONFIG_TS>
+struct BoolCalcConfigList { };
+
+/// A compiled-in BoolCalcWorld configuration.
+struct BoolCalcVariant {
+  std::string metric;
+  std::string thresh;
+  std::string reg;
+  size_t tag_bits;
+  std::string index;
+  std::string decay;
+  std::string tag_index;
+  void (*run)(BoolCalcConfig &);   ///< Set up and run a world with this configuration.
+
+  bool Matches(const BoolCalcConfig & config) const {
+    return metric == config.MATCHBIN_METRIC() && thresh == config.MATCHBIN_THRESH()
+      && reg == config.MATCHBIN_REG() && tag_bits == config.MATCHBIN_TAG_BITS()
+      && index == config.MATCHBIN_INDEX() && decay == config.MATCHBIN_DECAY()
+      && tag_index == config.MATCHBIN_TAG_INDEX();
+  }
+};
+
+template<typename CONFIG_T>
+void RunBoolCalcWorld(BoolCalcConfig & config) {
+  BoolCalcWorld<CONFIG_T> world;
+  world.Setup(config);
+  world.Run();
+}
+
+/// Add a variant for CONFIG_T, unless its matchbin options don't fit together (see BoolCalcWorldDefs::VALID).
+template<typename CONFIG_T>
+void AddBoolCalcVariant(emp::vector<BoolCalcVariant> & variants) {
+  if constexpr (BoolCalcWorldDefs<CONFIG_T>::VALID) {
+    variants.push_back({
+      std::string(CONFIG_T::MATCHBIN_METRIC), std::string(CONFIG_T::MATCHBIN_THRESH),
+      std::string(CONFIG_T::MATCHBIN_REG), CONFIG_T::MATCHBIN_TAG_BITS,
+      std::string(CONFIG_T::MATCHBIN_INDEX), std::string(CONFIG_T::MATCHBIN_DECAY),
+      std::string(CONFIG_T::MATCHBIN_TAG_INDEX), &RunBoolCalcWorld<CONFIG_T>
+    });
+  }
+}
+
+/// Variants for every valid configuration in the list.
+template<typename... CONFIG_TS>
+emp::vector<BoolCalcVariant> GetBoolCalcVariants(BoolCalcConfigList<CONFIG_TS...>) {
+  emp::vector<BoolCalcVariant> variants;
+  (AddBoolCalcVariant<CONFIG_TS>(variants), ...);
+  return variants;
+}
+
+/// Run the variant matching config's matchbin settings. Returns false if there is no such variant.
+inline bool RunBoolCalcVariant(BoolCalcConfig & config, const emp::vector<BoolCalcVariant> & variants) {
+  for (const BoolCalcVariant & variant : variants) {
+    if (!variant.Matches(config)) continue;
+    variant.run(config);
+    return true;
+  }
+  std::cout << "No compiled-in world for MATCHBIN_METRIC=" << config.MATCHBIN_METRIC()
+            << ", MATCHBIN_THRESH=" << config.MATCHBIN_THRESH()
+            << ", MATCHBIN_REG=" << config.MATCHBIN_REG()
+            << ", MATCHBIN_TAG_BITS=" << config.MATCHBIN_TAG_BITS()
+            << ", MATCHBIN_INDEX=" << config.MATCHBIN_INDEX()
+            << ", MATCHBIN_DECAY=" << config.MATCHBIN_DECAY()
+            << ", MATCHBIN_TAG_INDEX=" << config.MATCHBIN_TAG_INDEX() << ". Available:" << std::endl;
+  for (const BoolCalcVariant & variant : variants) {
+    std::cout << "  " << variant.metric << ", " << variant.thresh << ", " << variant.reg << ", "
+              << variant.tag_bits << ", " << variant.index << ", " << variant.decay << ", "
+              << variant.tag_index << std::endl;
+  }
+  return false;
+}
+
+#endif
@@ -29,6 +29,12 @@
 #include <string_view>
 #include <limits>
 #include <algorithm>
+#include <numeric>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
 // Empirical
 #include "emp/bits/BitSet.hpp"
 #include "emp/matchbin/MatchBin.hpp"
@@ -49,90 +55,164 @@
 #include "BoolCalcOrg.h"
 #include "BoolCalcTestCase.h"
 #include "Event.h"
+#include "hardware_run.h"
 #include "reg_ko_instr_impls.h"
 #include "mutation_utils.h"
 #include "matchbin_regulators.h"
+#include "precomputed_matchbin.h"
+#include "simd_streak_metric.h"
+#include "batch_metrics.h"
+#include "indexed_matchbin.h"
+#include "timer_wheel_matchbin.h"
+#include "tag_index.h"
+#include "cached_raw_matchbin.h"
+#include "dirty_reset_matchbin.h"
+#include "phenotype_cache.h"
+#include "selection_utils.h"
+#include "reachability_utils.h"
+#include "inst_dispatch.h"
+#include "knockouts.h"
+#include "inst_observers.h"
+#include "test_prefix_trie.h"
+
+#ifndef TAG_NUM_BITS
+#define TAG_NUM_BITS 64
+#endif
+#ifndef MATCH_THRESH
+#define MATCH_THRESH 0
+#endif
+#ifndef MATCH_REG
+#define MATCH_REG add
+#endif
+#ifndef MATCH_REG_RES
+#define MATCH_REG_RES 16
+#endif
+#ifndef MATCH_METRIC
+#define MATCH_METRIC streak
+#endif
+#ifndef MATCH_INDEX
+#define MATCH_INDEX emp
+#endif
+#ifndef MATCH_DECAY
+#define MATCH_DECAY step
+#endif
+#ifndef MATCH_TAG_INDEX
+#define MATCH_TAG_INDEX none
+#endif
+
+/// World configuration given by the compile-time MATCH_* and TAG_NUM_BITS settings (the default).
+/// Any struct with these members (named as the MATCHBIN_* config settings) configures a
+/// BoolCalcWorld; e.g., bool-calc-multi compiles in one world per configuration struct.
+struct BoolCalcBuildConfig {
+  static constexpr size_t MATCHBIN_TAG_BITS = TAG_NUM_BITS;
+  static constexpr std::string_view MATCHBIN_METRIC = STRINGVIEWIFY(MATCH_METRIC);
+  static constexpr std::string_view MATCHBIN_THRESH = STRINGVIEWIFY(MATCH_THRESH);
+  static constexpr std::string_view MATCHBIN_REG = STRINGVIEWIFY(MATCH_REG);
+  static constexpr std::string_view MATCHBIN_INDEX = STRINGVIEWIFY(MATCH_INDEX);
+  static constexpr std::string_view MATCHBIN_DECAY = STRINGVIEWIFY(MATCH_DECAY);
+  static constexpr std::string_view MATCHBIN_TAG_INDEX = STRINGVIEWIFY(MATCH_TAG_INDEX);
+};
 
-/// Globally-scoped, static variables.
-namespace BoolCalcWorldDefs {
-  #ifndef TAG_NUM_BITS
-  #define TAG_NUM_BITS 64
-  #endif
-  constexpr size_t TAG_LEN = TAG_NUM_BITS;  ///< How many bits per tag?
-  constexpr size_t INST_TAG_CNT = 1;        ///< How many tags per instruction?
-  constexpr size_t INST_ARG_CNT = 3;        ///< How many instruction arguments per instruction?
-  constexpr size_t FUNC_NUM_TAGS = 1;       ///< How many tags are associated with each function in a program?
-
-  #ifndef MATCH_THRESH
-  #define MATCH_THRESH 0
-  #endif
-  #ifndef MATCH_REG
-  #define MATCH_REG add
-  #endif
-  #ifndef MATCH_METRIC
-  #define MATCH_METRIC streak
-  #endif
+/// Static world definitions for the world configuration CONFIG_T (e.g., BoolCalcBuildConfig).
+template<typename CONFIG_T>
+struct BoolCalcWorldDefs {
+  static constexpr size_t TAG_LEN = CONFIG_T::MATCHBIN_TAG_BITS;  ///< How many bits per tag?
+  static constexpr size_t INST_TAG_CNT = 1;        ///< How many tags per instruction?
+  static constexpr size_t INST_ARG_CNT = 3;        ///< How many instruction arguments per instruction?
+  static constexpr size_t FUNC_NUM_TAGS = 1;       ///< How many tags are associated with each function in a program?
 
   using matchbin_val_t = size_t;  ///< SignalGP function ID type (how are functions identified in the matchbin?)
 
   // What match threshold should we use?
   // Remember, the ranked selector threshold is in terms of DISTANCE, not similarity. Thus, unintuitive template values.
   using matchbin_selector_t =
-  #ifdef MATCH_THRESH
-    std::conditional<STRINGVIEWIFY(MATCH_THRESH) == "0",
+    std::conditional_t<CONFIG_T::MATCHBIN_THRESH == "0",
       emp::RankedSelector<>,
-    std::conditional<STRINGVIEWIFY(MATCH_THRESH) == "25",
+    std::conditional_t<CONFIG_T::MATCHBIN_THRESH == "25",
       emp::RankedSelector<std::ratio<TAG_LEN+(3*(TAG_LEN/4)), TAG_LEN>>,
-    std::conditional<STRINGVIEWIFY(MATCH_THRESH) == "50",
+    std::conditional_t<CONFIG_T::MATCHBIN_THRESH == "50",
       emp::RankedSelector<std::ratio<TAG_LEN+(TAG_LEN/2), TAG_LEN>>,
-    std::conditional<STRINGVIEWIFY(MATCH_THRESH) == "75",
+    std::conditional_t<CONFIG_T::MATCHBIN_THRESH == "75",
       emp::RankedSelector<std::ratio<TAG_LEN+(TAG_LEN/4), TAG_LEN>>,
       std::enable_if<false>
-    >::type
-    >::type
-    >::type
-    >::type;
-  #endif
+    >>>>;
 
   // How should we measure tag similarity?
   using matchbin_metric_t =
-  #ifdef MATCH_METRIC
-    std::conditional<STRINGVIEWIFY(MATCH_METRIC) == "integer",
-      emp::AsymmetricWrapMetric<TAG_LEN>,
-    std::conditional<STRINGVIEWIFY(MATCH_METRIC) == "integer-symmetric",
-      emp::SymmetricWrapMetric<TAG_LEN>,
-    std::conditional<STRINGVIEWIFY(MATCH_METRIC) == "hamming",
-      emp::HammingMetric<TAG_LEN>,
-    std::conditional<STRINGVIEWIFY(MATCH_METRIC) == "streak",
+    std::conditional_t<CONFIG_T::MATCHBIN_METRIC == "integer",
+      BatchAsymmetricWrapMetric<TAG_LEN>,
+    std::conditional_t<CONFIG_T::MATCHBIN_METRIC == "integer-symmetric",
+      BatchSymmetricWrapMetric<TAG_LEN>,
+    std::conditional_t<CONFIG_T::MATCHBIN_METRIC == "hamming",
+      BatchHammingMetric<TAG_LEN>,
+    std::conditional_t<CONFIG_T::MATCHBIN_METRIC == "hash",
+      emp::CryptoHashMetric<TAG_LEN>,
+    std::conditional_t<CONFIG_T::MATCHBIN_METRIC == "streak",
       emp::StreakMetric<TAG_LEN>,
-    std::conditional<STRINGVIEWIFY(MATCH_METRIC) == "streak-exact",
+    std::conditional_t<CONFIG_T::MATCHBIN_METRIC == "streak-exact",
       emp::ExactDualStreakMetric<TAG_LEN>,
+    std::conditional_t<CONFIG_T::MATCHBIN_METRIC == "streak-simd",
+      SimdStreakMetric<TAG_LEN>,
     std::enable_if<false>
-    >::type
-    >::type
-    >::type
-    >::type
-    >::type;
-  #endif
+    >>>>>>>;
 
   // How should we regulate functions?
   using matchbin_regulator_t =
-  #ifdef MATCH_REG
-    std::conditional<STRINGVIEWIFY(MATCH_REG) == "add",
+    std::conditional_t<CONFIG_T::MATCHBIN_REG == "add",
       emp::AdditiveCountdownRegulator<>,
-    std::conditional<STRINGVIEWIFY(MATCH_REG) == "mult",
+    std::conditional_t<CONFIG_T::MATCHBIN_REG == "mult",
       emp::MultiplicativeCountdownRegulator<>,
-    std::conditional<STRINGVIEWIFY(MATCH_REG) == "exp",
+    std::conditional_t<CONFIG_T::MATCHBIN_REG == "exp",
       ExponentialCountdownRegulator<>,
+    std::conditional_t<CONFIG_T::MATCHBIN_REG == "exp-quant",
+      QuantizedExponentialCountdownRegulator<std::ratio<11,10>, 100, MATCH_REG_RES>,
+    std::enable_if<false>
+    >>>>;
+
+  // How should the matchbin find regulated matches? (emp: emp::MatchBin, with raw scores kept per program;
+  // counting: emp::MatchBin + match counters; incremental: regulation-aware match index + match counters)
+  using matchbin_index_t =
+    std::conditional_t<CONFIG_T::MATCHBIN_INDEX == "emp",
+      PrecomputedMatchBin<emp::MatchBin<matchbin_val_t, matchbin_metric_t, matchbin_selector_t, matchbin_regulator_t>,
+                          matchbin_metric_t, matchbin_selector_t>,
+    std::conditional_t<CONFIG_T::MATCHBIN_INDEX == "counting",
+      IndexedMatchBin<matchbin_val_t, matchbin_metric_t, matchbin_selector_t, matchbin_regulator_t, false>,
+    std::conditional_t<CONFIG_T::MATCHBIN_INDEX == "incremental",
+      IndexedMatchBin<matchbin_val_t, matchbin_metric_t, matchbin_selector_t, matchbin_regulator_t, true>,
     std::enable_if<false>
-    >::type
-    >::type
-    >::type;
-  #endif
+    >>>;
+  // How should regulators decay? (step: every regulator on every step; wheel: timer wheel, touching only
+  // regulators whose countdown expires)
+  using matchbin_decay_t =
+    std::conditional_t<CONFIG_T::MATCHBIN_DECAY == "step",
+      matchbin_index_t,
+    std::conditional_t<CONFIG_T::MATCHBIN_DECAY == "wheel",
+      TimerWheelMatchBin<matchbin_index_t>,
+    std::enable_if<false>
+    >>;
+  // How should top-1 matches be found? (none: matchbin scan; nearest: nearest-tag index, falling back
+  // to the scan whenever the index can't give the exact answer)
+  using matchbin_tag_index_t = typename tag_index_for<matchbin_metric_t>::type;
+  using matchbin_search_t =
+    std::conditional_t<CONFIG_T::MATCHBIN_TAG_INDEX == "none",
+      matchbin_decay_t,
+    std::conditional_t<CONFIG_T::MATCHBIN_TAG_INDEX == "nearest",
+      TagIndexMatchBin<matchbin_decay_t, matchbin_tag_index_t, matchbin_selector_t>,
+    std::enable_if<false>
+    >>;
+  // Raw matches (regulation instruction targets) are resolved once per program; resets between tests
+  // only undo regulation that happened since the last reset.
+  using matchbin_t = DirtyResetMatchBin<CachedRawMatchBin<matchbin_search_t>>;
+
+  /// Do the options fit together? (incremental indexes need MATCHBIN_THRESH 0; nearest-tag indexes
+  /// need a metric with a tag index: integer, integer-symmetric, or hamming)
+  static constexpr bool VALID =
+    (CONFIG_T::MATCHBIN_INDEX != "incremental" || is_unthresholded_ranked_selector<matchbin_selector_t>::value)
+    && (CONFIG_T::MATCHBIN_TAG_INDEX != "nearest" || !std::is_void<matchbin_tag_index_t>::value);
 
   using org_t = BoolCalcOrganism<emp::BitSet<TAG_LEN>,int>;
   using config_t = BoolCalcConfig;
-}
+};
 
 // - Inst_Add
 template<typename HARDWARE_T, typename INSTRUCTION_T, typename OPERAND_T>
@@ -145,16 +225,33 @@ void Inst_Nand(HARDWARE_T & hw, const INSTRUCTION_T & inst) {
   mem_state.SetWorking(inst.GetArg(2), result);
 }
 
-/// Custom hardware component for SignalGP
+/// How the hardware responded to a single input signal.
+struct BoolCalcSignalResponse {
+  using operand_t = BoolCalcTestInfo::operand_t;
+  using response_t = BoolCalcTestInfo::RESPONSE_TYPE;
+
+  bool responded=false;
+  response_t type=response_t::NONE;
+  operand_t value=0;
+};
+
+/// Custom hardware component for SignalGP (REGULATOR_T: the matchbin's regulator type)
+template<typename REGULATOR_T>
 struct BoolCalcCustomHardware {
 
   using operand_t = BoolCalcTestInfo::operand_t;
   using response_t = BoolCalcTestInfo::RESPONSE_TYPE;
+  using mem_buffer_t = std::decay_t<decltype(std::declval<sgp::SimpleMemoryModel&>().GetGlobalBuffer())>;
+  using checkpoint_t = HardwareCheckpoint<mem_buffer_t, REGULATOR_T>;
+  using prefix_memo_t = PrefixMemo<BoolCalcSignalResponse, checkpoint_t>;
 
   response_t response_type=response_t::NONE;
   operand_t response_value=0;
   bool responded=false;
   int response_function_id=-1;
+  size_t cycles_used=0; ///< CPU cycles run by evaluation (profiling; Reset() leaves it alone).
+  prefix_memo_t prefix_memo; ///< Test prefixes run by the loaded program (see SHARE_TEST_PREFIXES; Reset() leaves it alone).
+  size_t loaded_org_id=(size_t)-1; ///< Population id of the organism whose program is loaded, if known (lazy evaluation; Reset() leaves it alone).
 
   void Reset() {
     response_type = response_t::NONE;
@@ -188,21 +285,34 @@ struct BoolCalcCustomHardware {
   int GetResponseFunctionID() const { return response_function_id; }
 };
 
-class BoolCalcWorld : public emp::World<BoolCalcWorldDefs::org_t> {
+/// CONFIG_T: world configuration (tag length and matchbin options; see BoolCalcBuildConfig).
+template<typename CONFIG_T=BoolCalcBuildConfig>
+class BoolCalcWorld : public emp::World<typename BoolCalcWorldDefs<CONFIG_T>::org_t> {
 public:
-  using tag_t = emp::BitSet<BoolCalcWorldDefs::TAG_LEN>;
+  using defs_t = BoolCalcWorldDefs<CONFIG_T>;
+  using base_t = emp::World<typename defs_t::org_t>;
+  using tag_t = emp::BitSet<defs_t::TAG_LEN>;
   using inst_arg_t = int;
   using config_t = BoolCalcConfig;
   using operand_t = BoolCalcTestInfo::operand_t;
-  using custom_comp_t = BoolCalcCustomHardware;
+  using custom_comp_t = BoolCalcCustomHardware<typename defs_t::matchbin_regulator_t>;
 
   using org_t = BoolCalcOrganism<tag_t, inst_arg_t>;
   using phenotype_t = typename org_t::phenotype_t;
 
-  using matchbin_t = emp::MatchBin<BoolCalcWorldDefs::matchbin_val_t,
-                                   BoolCalcWorldDefs::matchbin_metric_t,
-                                   BoolCalcWorldDefs::matchbin_selector_t,
-                                   BoolCalcWorldDefs::matchbin_regulator_t>;
+  using matchbin_metric_t = typename defs_t::matchbin_metric_t;
+  using matchbin_t = typename defs_t::matchbin_t;
+  static_assert(defs_t::VALID, "Invalid matchbin configuration (see BoolCalcWorldDefs::VALID).");
+
+  // emp::World members (the world's base class depends on CONFIG_T)
+  using base_t::GetSize;
+  using base_t::GetOrg;
+  using base_t::GetUpdate;
+  using base_t::CalcFitnessID;
+  using base_t::ClearCache;
+  using base_t::Reset;
+  using base_t::Update;
+  using base_t::SetupFitnessFile;
 
   using mem_model_t = sgp::SimpleMemoryModel;
   using hardware_t = sgp::LinearFunctionsProgramSignalGP<mem_model_t,
@@ -212,16 +322,25 @@ public:
                                                          custom_comp_t>;
   using event_lib_t = typename hardware_t::event_lib_t;
   using base_event_t = typename hardware_t::event_t;
-  using event_t = MessageEvent<BoolCalcWorldDefs::TAG_LEN>;
+  using event_t = MessageEvent<defs_t::TAG_LEN>;
+  using signal_response_t = BoolCalcSignalResponse;
+  using signal_key_t = std::pair<size_t, operand_t>;  ///< Input signal (signal id, operand or 0)
+  using test_prefix_trie_t = SequenceTrie<signal_key_t>;
   using inst_lib_t = typename hardware_t::inst_lib_t;
   using inst_t = typename hardware_t::inst_t;
   using inst_prop_t = typename hardware_t::InstProperty;
   using program_t = typename hardware_t::program_t;
   using program_function_t = typename program_t::function_t;
   using mutator_t = MutatorLinearFunctionsProgram<hardware_t, tag_t, inst_arg_t>;
+  using reachability_t = ReachabilityAnalysis<hardware_t, tag_t, matchbin_metric_t>;
   using hw_response_type_t = BoolCalcTestInfo::RESPONSE_TYPE;
 
   using test_case_t = BoolCalcTestInfo::TestCase;
+  using test_scores_t = std::unordered_map<size_t, double>;  ///< Training case id => score
+  using phen_cache_t = PhenotypeCache<program_t, test_scores_t>;
+
+  /// What neutral mutant detection needs to know about an instruction (see InitMutator).
+  enum class InstCategory { OTHER, NOP, FLOW, REGULATOR, OWN_REGULATOR };
 
   /// Struct used as intermediary for printing/outputting SignalGP hardware state at a given time step.
   struct HardwareStatePrintInfo {
@@ -234,6 +353,9 @@ public:
   };
 
 protected:
+  using base_t::pop;
+  using base_t::random_ptr;
+
   // --- Localized Configuration Settings ---
   // Default group
   int SEED;
@@ -245,11 +367,16 @@ protected:
   std::string TRAINING_SET_FILE;
   size_t CPU_CYCLES_PER_INPUT_SIGNAL;
   bool CATEGORICAL_OUTPUT;
+  size_t NUM_EVAL_THREADS;
+  size_t PHENOTYPE_CACHE_SIZE;
+  bool INHERIT_NEUTRAL_PHENOTYPES;
+  bool SHARE_TEST_PREFIXES;
 
   // Selection group
   bool DOWN_SAMPLE;
   double DOWN_SAMPLE_RATE;
   bool SAMPLE_BY_TEST_TYPE;
+  bool LAZY_LEXICASE;
   // Program group
   bool USE_FUNC_REGULATION;
   bool USE_GLOBAL_MEMORY;
@@ -285,9 +412,24 @@ protected:
   size_t max_fit_org_id=0;
 
   emp::Ptr<inst_lib_t> inst_lib;            ///< Manages SignalGP instruction set.
+  emp::vector<InstCategory> inst_categories;  ///< Category of each instruction (by instruction id; set by AddInstructions).
+  emp::vector<emp::Ptr<inst_lib_t>> ko_inst_libs;  ///< Instruction set specialized for each knockout mode (by KnockoutMode).
+  emp::Ptr<inst_lib_t> trace_inst_lib;  ///< Instruction set that records executed instructions (into traced_instructions); used for traces.
+  emp::vector<inst_t> traced_instructions;  ///< Instructions executed on trace_hardware (cleared by the trace).
   emp::Ptr<event_lib_t> event_lib;          ///< Manages SignalGP events.
   emp::Ptr<mutator_t> mutator;
+  emp::Ptr<reachability_t> reachability;  ///< Finds functions that could ever run (used to detect neutral mutants).
   emp::Ptr<hardware_t> eval_hardware;        ///< Used to evaluate programs.
+  emp::vector<emp::Ptr<hardware_t>> ko_hardware;  ///< Used to evaluate programs under each knockout mode (by KnockoutMode).
+  emp::Ptr<hardware_t> trace_hardware;  ///< Used to trace programs (runs trace_inst_lib).
+  emp::vector<emp::Ptr<hardware_t>> worker_hardware;  ///< One per evaluation worker (only used when NUM_EVAL_THREADS > 1).
+  emp::vector<emp::Ptr<emp::Random>> worker_randoms;  ///< Per-worker random number generators (hardware never shares the world's).
+
+  phen_cache_t phen_cache;        ///< Remembers training case scores by genome (across generations).
+  std::mutex phen_cache_mutex;    ///< Guards phen_cache during parallel evaluation.
+
+  std::unordered_map<size_t, emp::vector<bool>> reachable_funcs_by_parent; ///< Parent pop id => reachable functions (this generation).
+  size_t neutral_offspring_cnt=0; ///< Offspring that inherited their parent's test scores (this generation).
 
   // emp::Signal<void(size_t)> after_eval_sig; ///< Triggered after organism (ID given by size_t argument) evaluation
   emp::Signal<void(void)> end_setup_sig;    ///< Triggered at end of world setup.
@@ -312,20 +454,24 @@ protected:
   size_t num_eval_tests;
 
   emp::vector<tag_t> test_input_signal_tags;        ///< Stored by ID
+  test_prefix_trie_t test_prefixes;                 ///< Training case signal sequences (see SHARE_TEST_PREFIXES)
   emp::vector<std::string> test_input_signals;      ///< ...
   std::unordered_map<std::string, size_t> test_input_signal_lu;
 
   std::unordered_set<size_t> output_categories; ///< Used when CATEGORICAL_OUTPUT is true
 
-  bool KO_REGULATION=false;       ///< Is regulation knocked out right now?
-  bool KO_UP_REGULATION=false;    ///< Is up-regulation knocked out right now?
-  bool KO_DOWN_REGULATION=false;  ///< Is down-regulation knocked out right now?
-  bool KO_GLOBAL_MEMORY=false;    ///< Is global memory access knocked out right now?
-
   size_t event_id_input_sig=0;
 
   void InitConfigs(const config_t & config);
   void InitInstLib();
+  /// Add this world's instructions to target_lib, with knockouts KNOCKOUTS_T compiled in (see knockouts.h)
+  /// and observer applied to each instruction (see inst_observers.h).
+  template<typename KNOCKOUTS_T, typename OBSERVER_T=NoInstObserver>
+  void AddInstructions(inst_lib_t & target_lib, const OBSERVER_T & observer=OBSERVER_T());
+  template<KnockoutMode MODE>
+  void AddKnockoutInstructions() {
+    AddInstructions<typename knockouts_for<MODE>::type>(*ko_inst_libs[(size_t)MODE]);
+  }
   void InitEventLib();
   void InitHardware();
   void InitMutator();
@@ -336,6 +482,7 @@ protected:
   void InitPop_Random();
 
   void DoEvaluation();
+  void DoEvaluation_Parallel(const emp::vector<size_t> & test_eval_order);
   void DoSelection();
   void DoUpdate();
 
@@ -343,9 +490,99 @@ protected:
                    const emp::vector<test_case_t> & tests,
                    const emp::vector<size_t> & test_eval_order,
                    size_t num_tests=0,
-                   bool bail_on_fail=false);
+                   bool bail_on_fail=false)
+  {
+    EvaluateOrg(*eval_hardware, org, tests, test_eval_order, num_tests, bail_on_fail);
+  }
+
+  void EvaluateOrg(hardware_t & hw,
+                   org_t & org,
+                   const emp::vector<test_case_t> & tests,
+                   const emp::vector<size_t> & test_eval_order,
+                   size_t num_tests=0,
+                   bool bail_on_fail=false,
+                   bool reuse_scores=false);
+
+  /// Load organism's program onto the given hardware.
+  void LoadProgram(hardware_t & hw, org_t & org);
+
+  /// Run a single test case on hardware that already has a program loaded. Returns the test score.
+  /// A score is exactly 1.0 if and only if the program passed the test (partial credit never sums to 1.0).
+  /// With SHARE_TEST_PREFIXES, leading signals this program already ran (since it was loaded) in
+  /// another training case are not run again (see test_prefix_trie.h).
+  double EvaluateTest(hardware_t & hw, const test_case_t & test_case);
+  /// Reset threads, deliver a single input signal, and run the hardware until it responds (or quiesces).
+  signal_response_t RunTestSignal(hardware_t & hw, const BoolCalcTestInfo::TestSignal & test_sig);
+  /// Trie key for an input signal (operands with different values are different signals).
+  static signal_key_t GetSignalKey(const BoolCalcTestInfo::TestSignal & test_sig) {
+    return {test_sig.GetSignalID(), test_sig.IsOperand() ? test_sig.GetOperand() : (operand_t)0};
+  }
 
-  bool ScreenSolution(const org_t & org);
+  // -- Lazy lexicase evaluation --
+  // Organisms are only scored on a training case once lexicase selection needs that score.
+  // Scores are memoized in the organism's phenotype (test_evaluated marks which are known).
+
+  /// Ready organism for lazy evaluation (assign tests, pull known scores from phenotype cache).
+  void PrepareOrg_Lazy(org_t & org, const emp::vector<size_t> & test_eval_order);
+  /// Make sure each given organism has been evaluated on the test at eval_index.
+  void EvaluateOrgsOnTest_Lazy(const emp::vector<size_t> & org_ids, size_t eval_index);
+  /// Evaluate organism on all of its remaining (not yet evaluated) tests.
+  void CompleteOrgEvaluation_Lazy(size_t org_id);
+  /// Hardware that evaluates the given organism (always the same one, so its program can stay loaded).
+  hardware_t & GetLazyHardware(size_t org_id) {
+    return (NUM_EVAL_THREADS > 1) ? *worker_hardware[org_id % worker_hardware.size()] : *eval_hardware;
+  }
+  /// Load organism's program onto hw, unless hw already has it loaded.
+  void LoadProgram_Lazy(hardware_t & hw, size_t org_id);
+  /// Forget which organisms' programs are loaded (population ids now refer to new organisms).
+  void ForgetLoadedOrgs() {
+    eval_hardware->GetCustomComponent().loaded_org_id = (size_t)-1;
+    for (auto hw : worker_hardware) hw->GetCustomComponent().loaded_org_id = (size_t)-1;
+  }
+  /// Evaluate the entire population on all remaining tests (e.g., before snapshotting the population).
+  void CompletePopEvaluation_Lazy();
+  /// After selection, find the max fitness organism and remember newly evaluated test scores.
+  void FinishEvaluation_Lazy();
+
+  /// Did mutations to this offspring only touch functions that could never run in its parent?
+  bool IsNeutralMutant(size_t parent_id);
+  /// Give offspring all of its parent's known test scores.
+  void InheritTestScores(org_t & offspring, const org_t & parent);
+
+  /// Matchbin match counters summed over all evaluation hardware (all zero unless MATCH_INDEX is counting or incremental).
+  MatchBinStats GetMatchBinStats() {
+    MatchBinStats stats;
+    if constexpr (has_matchbin_stats<matchbin_t>::value) {
+      stats += eval_hardware->GetMatchBin().GetStats();
+      for (auto hw : worker_hardware) stats += hw->GetMatchBin().GetStats();
+    }
+    return stats;
+  }
+
+  void ResetMatchBinStats() {
+    if constexpr (has_matchbin_stats<matchbin_t>::value) {
+      eval_hardware->GetMatchBin().ResetStats();
+      for (auto hw : worker_hardware) hw->GetMatchBin().ResetStats();
+    }
+  }
+
+  /// CPU cycles run by evaluation, summed over all evaluation hardware.
+  size_t GetCyclesUsed() {
+    size_t cycles = eval_hardware->GetCustomComponent().cycles_used;
+    for (auto hw : worker_hardware) cycles += hw->GetCustomComponent().cycles_used;
+    return cycles;
+  }
+
+  void ResetCyclesUsed() {
+    eval_hardware->GetCustomComponent().cycles_used = 0;
+    for (auto hw : worker_hardware) hw->GetCustomComponent().cycles_used = 0;
+  }
+
+  /// Hardware that runs programs with knockout mode mode.
+  hardware_t & GetKnockoutHardware(KnockoutMode mode) { return *ko_hardware[(size_t)mode]; }
+
+  bool ScreenSolution(const org_t & org) { return ScreenSolution(*eval_hardware, org); }
+  bool ScreenSolution(hardware_t & hw, const org_t & org);
 
   void AnalyzeOrg(const org_t & org, size_t pop_id);
 
@@ -416,9 +653,16 @@ public:
 
   ~BoolCalcWorld() {
     if(inst_lib) inst_lib.Delete();
+    for (auto lib : ko_inst_libs) lib.Delete();
+    if(trace_inst_lib) trace_inst_lib.Delete();
     if(event_lib) event_lib.Delete();
     if(mutator) mutator.Delete();
+    if(reachability) reachability.Delete();
     if(eval_hardware) eval_hardware.Delete();
+    for (auto hw : ko_hardware) hw.Delete();
+    if(trace_hardware) trace_hardware.Delete();
+    for (auto hw : worker_hardware) hw.Delete();
+    for (auto rnd : worker_randoms) rnd.Delete();
     if(max_fit_file) max_fit_file.Delete();
   }
 
@@ -428,7 +672,8 @@ public:
 };
 
 // ---- Public function implementations ----
-void BoolCalcWorld::Setup(const config_t & config) {
+template<typename CONFIG_T>
+void BoolCalcWorld<CONFIG_T>::Setup(const config_t & config) {
   std:: cout << "--- Setting up BoolCalcWorld ---" << std::endl;
   setup = false;
 
@@ -449,6 +694,9 @@ void BoolCalcWorld::Setup(const config_t & config) {
   InitHardware();
   // Initialize the program mutator
   InitMutator();
+  // Clear out any remembered phenotypes
+  phen_cache.Clear();
+  phen_cache.SetCapacity(PHENOTYPE_CACHE_SIZE);
 
   // How should the population be initialized?
   end_setup_sig.AddAction([this]() {
@@ -456,6 +704,16 @@ void BoolCalcWorld::Setup(const config_t & config) {
     InitPop();
     std::cout << " Done." << std::endl;
     this->SetAutoMutate(); // Set to automutate after initialization.
+    // Must be added after auto-mutate so that we see the offspring's mutations.
+    if (INHERIT_NEUTRAL_PHENOTYPES) {
+      this->OnOffspringReady([this](org_t & offspring, emp::WorldPosition parent_pos) {
+        const size_t parent_id = parent_pos.GetIndex();
+        if (IsNeutralMutant(parent_id)) {
+          InheritTestScores(offspring, GetOrg(parent_id));
+          ++neutral_offspring_cnt;
+        }
+      });
+    }
   });
   // Misc. world configuration
   this->SetPopStruct_Mixed(true);
@@ -470,13 +728,15 @@ void BoolCalcWorld::Setup(const config_t & config) {
   setup=true;
 }
 
-void BoolCalcWorld::RunStep() {
+template<typename CONFIG_T>
+void BoolCalcWorld<CONFIG_T>::RunStep() {
   DoEvaluation();
   DoSelection();
   DoUpdate();
 }
 
-void BoolCalcWorld::Run() {
+template<typename CONFIG_T>
+void BoolCalcWorld<CONFIG_T>::Run() {
   for (size_t u = 0; u <= GENERATIONS; ++u) {
     RunStep();
     if (STOP_ON_SOLUTION & found_solution) break;
@@ -484,7 +744,8 @@ void BoolCalcWorld::Run() {
 }
 
 // ---- Internal function implementations ----
-void BoolCalcWorld::DoEvaluation() {
+template<typename CONFIG_T>
+void BoolCalcWorld<CONFIG_T>::DoEvaluation() {
   // If we're down sampling, shuffle the training cases.
   const bool use_samples_by_type = DOWN_SAMPLE && SAMPLE_BY_TEST_TYPE;
   if (use_samples_by_type) {
@@ -493,24 +754,80 @@ void BoolCalcWorld::DoEvaluation() {
     emp::Shuffle(*random_ptr, training_case_ids);
   }
 
+  const emp::vector<size_t> & test_eval_order = (use_samples_by_type) ? sampled_training_case_ids : training_case_ids;
+  phen_cache.ResetCounters(); // Counts test scores reused (hits) and computed (misses) this generation.
+  neutral_offspring_cnt = 0;
+  reachable_funcs_by_parent.clear();
+  ResetMatchBinStats();
+  ResetCyclesUsed();
+  ForgetLoadedOrgs();
+  if (LAZY_LEXICASE) {
+    // Defer evaluation to selection (max fitness organism is found after selection).
+    for (size_t org_id = 0; org_id < GetSize(); ++org_id) {
+      emp_assert(IsOccupied(org_id));
+      PrepareOrg_Lazy(GetOrg(org_id), test_eval_order);
+    }
+    return;
+  } else if (NUM_EVAL_THREADS > 1) {
+    DoEvaluation_Parallel(test_eval_order);
+  } else {
+    for (size_t org_id = 0; org_id < GetSize(); ++org_id) {
+      emp_assert(IsOccupied(org_id));
+      EvaluateOrg(
+        *eval_hardware,
+        GetOrg(org_id),
+        training_cases,
+        test_eval_order,
+        num_eval_tests,
+        false,
+        true
+      );
+    }
+  }
+
+  // Find the max fitness organism (in population order, so ties always resolve the same way).
   max_fit_org_id = 0;
   for (size_t org_id = 0; org_id < GetSize(); ++org_id) {
-    emp_assert(IsOccupied(org_id));
-    EvaluateOrg(
-      GetOrg(org_id),
-      training_cases,
-      (use_samples_by_type) ? sampled_training_case_ids : training_case_ids,
-      num_eval_tests
-    );
     if (CalcFitnessID(org_id) > CalcFitnessID(max_fit_org_id)) max_fit_org_id = org_id;
   }
 }
 
-void BoolCalcWorld::DoSelection() {
+/// Evaluate the population using a pool of worker threads, each with its own virtual hardware.
+/// Workers pull organisms off of a shared counter; each organism's evaluation only touches that
+/// organism's phenotype and the worker's hardware, so results do not depend on scheduling.
+template<typename CONFIG_T>
+void BoolCalcWorld<CONFIG_T>::DoEvaluation_Parallel(const emp::vector<size_t> & test_eval_order) {
+  emp_assert(worker_hardware.size() == NUM_EVAL_THREADS);
+  std::atomic<size_t> next_org_id(0);
+  auto evaluate = [this, &next_org_id, &test_eval_order](hardware_t & hw) {
+    for (size_t org_id = next_org_id++; org_id < GetSize(); org_id = next_org_id++) {
+      emp_assert(IsOccupied(org_id));
+      EvaluateOrg(
+        hw,
+        GetOrg(org_id),
+        training_cases,
+        test_eval_order,
+        num_eval_tests,
+        false,
+        true
+      );
+    }
+  };
+  emp::vector<std::thread> workers;
+  for (size_t worker_id = 1; worker_id < worker_hardware.size(); ++worker_id) {
+    workers.emplace_back(evaluate, std::ref(*worker_hardware[worker_id]));
+  }
+  evaluate(*worker_hardware[0]); // This thread does its share of the work, too.
+  for (auto & worker : workers) worker.join();
+}
+
+template<typename CONFIG_T>
+void BoolCalcWorld<CONFIG_T>::DoSelection() {
   do_selection_sig.Trigger();
 }
 
-void BoolCalcWorld::DoUpdate() {
+template<typename CONFIG_T>
+void BoolCalcWorld<CONFIG_T>::DoUpdate() {
   const double max_score = CalcFitnessID(max_fit_org_id);
   const double max_passes = GetOrg(max_fit_org_id).GetPhenotype().num_passes;
   const size_t cur_update = GetUpdate();
@@ -534,6 +851,7 @@ void BoolCalcWorld::DoUpdate() {
   if (SNAPSHOT_RESOLUTION) {
     const bool snapshot = (!(cur_update % SNAPSHOT_RESOLUTION)) || (cur_update == GENERATIONS) || (STOP_ON_SOLUTION & found_solution);
     if (snapshot) {
+      if (LAZY_LEXICASE) CompletePopEvaluation_Lazy();
       DoPopulationSnapshot();
       if (cur_update || (STOP_ON_SOLUTION & found_solution)) {
         AnalyzeOrg(GetOrg(max_fit_org_id), max_fit_org_id);
@@ -541,17 +859,24 @@ void BoolCalcWorld::DoUpdate() {
     }
   }
 
+  // The fitness file (written by Update) summarizes every organism's aggregate score.
+  if (LAZY_LEXICASE && SUMMARY_RESOLUTION && !(cur_update % SUMMARY_RESOLUTION)) CompletePopEvaluation_Lazy();
+
   Update();
   ClearCache();
 }
 
 // todo - modify this to support running on training, testing, or both
-void BoolCalcWorld::EvaluateOrg(
+// NOTE - reuse_scores assumes that tests are the training cases and that nothing is knocked out.
+template<typename CONFIG_T>
+void BoolCalcWorld<CONFIG_T>::EvaluateOrg(
+  hardware_t & hw,
   org_t & org,
   const emp::vector<test_case_t> & tests,
   const emp::vector<size_t> & test_eval_order,
   size_t num_tests/*=0*/,
-  bool bail_on_fail/*=false*/
+  bool bail_on_fail/*=false*/,
+  bool reuse_scores/*=false*/
 ) {
   // Evaluate given organism on each test (num_eval_tests)
   if (!num_tests) num_tests = test_eval_order.size();
@@ -559,74 +884,52 @@ void BoolCalcWorld::EvaluateOrg(
   emp_assert(num_tests <= tests.size(), num_tests, tests.size());
   phenotype_t & phen = org.GetPhenotype();
   phen.Reset(num_tests);
+  const program_t & program = org.GetGenome().GetProgram();
+
+  // Have we seen this genome before? If so, pull up its known test scores.
+  // (inherited scores are used first; they do not count as cache hits)
+  const bool use_phen_cache = reuse_scores && phen_cache.IsEnabled();
+  size_t program_hash = 0;
+  test_scores_t known_scores;
+  if (use_phen_cache) {
+    program_hash = HashProgram(program);
+    std::lock_guard<std::mutex> lock(phen_cache_mutex);
+    phen_cache.Get(program, program_hash, known_scores);
+  }
+  size_t cache_hits = 0;
+  size_t cache_misses = 0;
 
   // Ready the hardware
-  eval_hardware->SetProgram(org.GetGenome().program); // This resets the hardware completely.
+  bool program_loaded = false;
   // Evaluate program on each training example
   for (size_t eval_index = 0; eval_index < num_tests; ++eval_index) {
     emp_assert(eval_index < phen.test_scores.size());
     emp_assert(phen.test_scores[eval_index] == 0);
-    eval_hardware->ResetMatchBin();       // Reset matchbin (regulation) between tests
-    eval_hardware->ResetHardwareState();  // Reset global memory between tests
     // grab the test case id
     const size_t test_id = test_eval_order[eval_index];
     phen.test_ids[eval_index] = test_id;
-    // grab the appropriate training example
-    const test_case_t & test_case = tests[test_id];
-    // compute amount of partial credit for each correct response to an input signal
-    const double partial_credit = 1.0 / (double)test_case.test_signals.size();
-    size_t num_correct_sig_resps = 0;
-    for (size_t sig_i = 0; sig_i < test_case.test_signals.size(); ++sig_i) {
-      const BoolCalcTestInfo::TestSignal & test_sig = test_case.test_signals[sig_i];
-      const tag_t & test_sig_tag = test_input_signal_tags[test_sig.GetSignalID()];
-      // Reset the hardware
-      eval_hardware->ResetBaseHardwareState(); // Only reset threads, not global memory
-      eval_hardware->GetCustomComponent().Reset();
-      emp_assert(eval_hardware->ValidateThreadState());
-      emp_assert(eval_hardware->GetActiveThreadIDs().size() == 0);
-      emp_assert(eval_hardware->GetNumQueuedEvents() == 0);
-      // Queue calculator button input
-      if (test_sig.IsOperand()) {
-        eval_hardware->QueueEvent(
-          event_t(event_id_input_sig, test_sig_tag, {{0, (double)test_sig.GetOperand()}})
-        );
-      } else if (test_sig.IsOperator()) {
-        eval_hardware->QueueEvent(
-          event_t(event_id_input_sig, test_sig_tag)
-        );
+    phen.test_evaluated[eval_index] = true;
+    auto inherited_score = phen.known_test_scores.find(test_id);
+    auto known_score = known_scores.find(test_id);
+    if (reuse_scores && inherited_score != phen.known_test_scores.end()) {
+      phen.test_scores[eval_index] = inherited_score->second;
+    } else if (known_score != known_scores.end()) {
+      phen.test_scores[eval_index] = known_score->second;
+      ++cache_hits;
+    } else {
+      if (!program_loaded) {
+        LoadProgram(hw, org); // This resets the hardware completely.
+        program_loaded = true;
       }
-      // Step the hardware forward to process the signal
-      for (size_t step = 0; step < CPU_CYCLES_PER_INPUT_SIGNAL; ++step) {
-        eval_hardware->SingleProcess();
-        // Stop early if no active or pending threads
-        const size_t num_active_threads = eval_hardware->GetNumActiveThreads();
-        const size_t num_pending_threads = eval_hardware->GetNumPendingThreads();
-        if (!( num_active_threads || num_pending_threads )) break;
-      }
-      // How did the organism respond?
-      const bool has_response = eval_hardware->GetCustomComponent().HasResponse();
-      const hw_response_type_t resp_type = eval_hardware->GetCustomComponent().GetResponseType();
-      const operand_t resp_val = eval_hardware->GetCustomComponent().GetResponseValue();
-      const bool is_correct = test_sig.IsCorrect(resp_type, resp_val);
-      if (has_response && is_correct) {
-        phen.test_scores[eval_index] += partial_credit;
-        num_correct_sig_resps += 1;
-      } else if (
-          has_response &&
-          test_sig.GetCorrectResponseType() == hw_response_type_t::NUMERIC &&
-          resp_type == hw_response_type_t::NUMERIC)
-      {
-        phen.test_scores[eval_index] += 0.1*partial_credit; // get some credit
-      } else {
-        // Bail early
-        break;
+      phen.test_scores[eval_index] = EvaluateTest(hw, tests[test_id]);
+      if (use_phen_cache) {
+        known_scores[test_id] = phen.test_scores[eval_index];
+        ++cache_misses;
       }
     }
     // Did the program correctly respond to all input signals?
-    // Update test score if necessary
-    const bool pass = (num_correct_sig_resps == test_case.test_signals.size());
-    if (pass) { phen.test_scores[eval_index] = 1.0; }
-    else if (bail_on_fail) { break; } // Organism failed test and we want to bail on first fail.
+    const bool pass = (phen.test_scores[eval_index] == 1.0);
+    if (!pass && bail_on_fail) { break; } // Organism failed test and we want to bail on first fail.
 
     // Update number of passes
     phen.num_passes += (size_t)pass;
@@ -634,9 +937,301 @@ void BoolCalcWorld::EvaluateOrg(
     // Update aggregate score
     phen.aggregate_score += phen.test_scores[eval_index];
   }
+
+  // Remember any newly computed test scores.
+  if (use_phen_cache) {
+    std::lock_guard<std::mutex> lock(phen_cache_mutex);
+    if (cache_misses) phen_cache.Put(program, program_hash, known_scores);
+    phen_cache.RecordHits(cache_hits);
+    phen_cache.RecordMisses(cache_misses);
+  }
+}
+
+template<typename CONFIG_T>
+void BoolCalcWorld<CONFIG_T>::LoadProgram(hardware_t & hw, org_t & org) {
+  const program_t & program = org.GetGenome().GetProgram();
+  hw.SetProgram(program);
+  hw.GetMatchBin().LoadProgram(hw.GetProgram());
+  hw.GetCustomComponent().prefix_memo.Clear();
+  hw.GetCustomComponent().loaded_org_id = (size_t)-1;
+}
+
+template<typename CONFIG_T>
+void BoolCalcWorld<CONFIG_T>::LoadProgram_Lazy(hardware_t & hw, size_t org_id) {
+  if (hw.GetCustomComponent().loaded_org_id == org_id) return;
+  LoadProgram(hw, GetOrg(org_id));
+  hw.GetCustomComponent().loaded_org_id = org_id;
+}
+
+template<typename CONFIG_T>
+double BoolCalcWorld<CONFIG_T>::EvaluateTest(hardware_t & hw, const test_case_t & test_case) {
+  hw.ResetMatchBin();       // Reset matchbin (regulation) between tests (dirty-tracked; see DirtyResetMatchBin)
+  hw.ResetHardwareState();  // Reset global memory between tests (full reset)
+  auto & prefix_memo = hw.GetCustomComponent().prefix_memo;
+  // Where is this test in the trie of training case prefixes? (NO_NODE once it leaves the trie)
+  size_t node = (SHARE_TEST_PREFIXES) ? test_prefixes.GetRoot() : test_prefix_trie_t::NO_NODE;
+  // Is the hardware in the state left by this test's signals so far? (not after reusing responses)
+  bool hw_in_sync = true;
+  double score = 0.0;
+  // compute amount of partial credit for each correct response to an input signal
+  const double partial_credit = 1.0 / (double)test_case.test_signals.size();
+  size_t num_correct_sig_resps = 0;
+  for (size_t sig_i = 0; sig_i < test_case.test_signals.size(); ++sig_i) {
+    const BoolCalcTestInfo::TestSignal & test_sig = test_case.test_signals[sig_i];
+    const size_t prefix_node = node;
+    if (node != test_prefix_trie_t::NO_NODE) node = test_prefixes.GetChild(node, GetSignalKey(test_sig));
+    signal_response_t response;
+    if (node != test_prefix_trie_t::NO_NODE && prefix_memo.HasResponse(node)) {
+      // This program already ran this prefix: reuse its response.
+      response = prefix_memo.GetResponse(node);
+      hw_in_sync = false;
+    } else {
+      if (!hw_in_sync) {
+        // Catch the hardware (still in its reset state) up to the end of the reused prefix: restore
+        // the deepest checkpoint along it (if any), then re-run the signals after that checkpoint.
+        size_t resume_node = prefix_node;
+        while (resume_node != test_prefixes.GetRoot() && !prefix_memo.HasCheckpoint(resume_node)) {
+          resume_node = test_prefixes.GetParent(resume_node);
+        }
+        size_t resume_i = 0;
+        if (prefix_memo.HasCheckpoint(resume_node)) {
+          prefix_memo.RestoreCheckpoint(resume_node, hw);
+          resume_i = test_prefixes.GetDepth(resume_node);
+        }
+        emp_assert(test_prefixes.GetDepth(prefix_node) == sig_i);
+        for (size_t prev_i = resume_i; prev_i < sig_i; ++prev_i) RunTestSignal(hw, test_case.test_signals[prev_i]);
+        hw_in_sync = true;
+      }
+      response = RunTestSignal(hw, test_sig);
+      if (node != test_prefix_trie_t::NO_NODE) {
+        prefix_memo.SetResponse(node, response);
+        if (test_prefixes.IsBranch(node)) prefix_memo.SaveCheckpoint(node, hw);
+      }
+    }
+    // How did the organism respond?
+    const bool is_correct = test_sig.IsCorrect(response.type, response.value);
+    if (response.responded && is_correct) {
+      score += partial_credit;
+      num_correct_sig_resps += 1;
+    } else if (
+        response.responded &&
+        test_sig.GetCorrectResponseType() == hw_response_type_t::NUMERIC &&
+        response.type == hw_response_type_t::NUMERIC)
+    {
+      score += 0.1*partial_credit; // get some credit
+    } else {
+      // Bail early
+      break;
+    }
+  }
+  // Did the program correctly respond to all input signals?
+  // Update test score if necessary
+  const bool pass = (num_correct_sig_resps == test_case.test_signals.size());
+  if (pass) { score = 1.0; }
+  return score;
+}
+
+template<typename CONFIG_T>
+typename BoolCalcWorld<CONFIG_T>::signal_response_t BoolCalcWorld<CONFIG_T>::RunTestSignal(
+  hardware_t & hw,
+  const BoolCalcTestInfo::TestSignal & test_sig
+) {
+  const tag_t & test_sig_tag = test_input_signal_tags[test_sig.GetSignalID()];
+  // Reset the hardware
+  hw.ResetBaseHardwareState(); // Only reset threads, not global memory (full reset of every thread slot)
+  hw.GetCustomComponent().Reset();
+  emp_assert(hw.ValidateThreadState());
+  emp_assert(hw.GetActiveThreadIDs().size() == 0);
+  emp_assert(hw.GetNumQueuedEvents() == 0);
+  // Handle calculator button input. The event queue is empty, so handling the input directly is
+  // equivalent to queueing it for the first SingleProcess, without heap-allocating a queued copy.
+  if (test_sig.IsOperand()) {
+    hw.HandleEvent(
+      event_t(event_id_input_sig, test_sig_tag, {{0, (double)test_sig.GetOperand()}})
+    );
+  } else if (test_sig.IsOperator()) {
+    hw.HandleEvent(
+      event_t(event_id_input_sig, test_sig_tag)
+    );
+  }
+  // Step the hardware forward to process the signal (stops early once it goes quiescent)
+  hw.GetCustomComponent().cycles_used += RunUntilQuiescent(hw, CPU_CYCLES_PER_INPUT_SIGNAL);
+  signal_response_t response;
+  response.responded = hw.GetCustomComponent().HasResponse();
+  response.type = hw.GetCustomComponent().GetResponseType();
+  response.value = hw.GetCustomComponent().GetResponseValue();
+  return response;
+}
+
+template<typename CONFIG_T>
+void BoolCalcWorld<CONFIG_T>::PrepareOrg_Lazy(org_t & org, const emp::vector<size_t> & test_eval_order) {
+  emp_assert(num_eval_tests <= test_eval_order.size());
+  phenotype_t & phen = org.GetPhenotype();
+  phen.Reset(num_eval_tests);
+  std::copy(test_eval_order.begin(), test_eval_order.begin() + num_eval_tests, phen.test_ids.begin());
+  // Use any inherited scores.
+  for (size_t eval_index = 0; eval_index < num_eval_tests; ++eval_index) {
+    auto inherited_score = phen.known_test_scores.find(phen.test_ids[eval_index]);
+    if (inherited_score == phen.known_test_scores.end()) continue;
+    phen.test_scores[eval_index] = inherited_score->second;
+    phen.test_evaluated[eval_index] = true;
+  }
+  if (!phen_cache.IsEnabled()) return;
+  // Pull up any known scores for this genome.
+  const program_t & program = org.GetGenome().GetProgram();
+  test_scores_t known_scores;
+  if (!phen_cache.Get(program, HashProgram(program), known_scores)) return;
+  for (size_t eval_index = 0; eval_index < num_eval_tests; ++eval_index) {
+    if (phen.test_evaluated[eval_index]) continue;
+    auto known_score = known_scores.find(phen.test_ids[eval_index]);
+    if (known_score == known_scores.end()) continue;
+    phen.test_scores[eval_index] = known_score->second;
+    phen.test_evaluated[eval_index] = true;
+    phen_cache.RecordHits();
+  }
+}
+
+/// Organisms missing the requested score are evaluated on it in one batch (in parallel when
+/// NUM_EVAL_THREADS > 1). Each worker only touches its own hardware and the phenotypes it is handed.
+template<typename CONFIG_T>
+void BoolCalcWorld<CONFIG_T>::EvaluateOrgsOnTest_Lazy(const emp::vector<size_t> & org_ids, size_t eval_index) {
+  emp::vector<size_t> pending;
+  for (size_t org_id : org_ids) {
+    emp_assert(eval_index < GetOrg(org_id).GetPhenotype().test_evaluated.size());
+    if (!GetOrg(org_id).GetPhenotype().test_evaluated[eval_index]) pending.emplace_back(org_id);
+  }
+  if (pending.empty()) return;
+  // Each organism is always evaluated on the same hardware (see GetLazyHardware), so an organism
+  // that stays in the running keeps its program loaded from one test to the next.
+  auto evaluate = [this, &pending, eval_index](hardware_t & hw) {
+    for (size_t org_id : pending) {
+      if (&GetLazyHardware(org_id) != &hw) continue;
+      phenotype_t & phen = GetOrg(org_id).GetPhenotype();
+      LoadProgram_Lazy(hw, org_id);
+      phen.test_scores[eval_index] = EvaluateTest(hw, training_cases[phen.test_ids[eval_index]]);
+      phen.test_evaluated[eval_index] = true;
+    }
+  };
+  if (NUM_EVAL_THREADS > 1) {
+    emp::vector<bool> busy(worker_hardware.size(), false);
+    for (size_t org_id : pending) busy[org_id % worker_hardware.size()] = true;
+    emp::vector<std::thread> workers;
+    for (size_t worker_id = 1; worker_id < worker_hardware.size(); ++worker_id) {
+      if (busy[worker_id]) workers.emplace_back(evaluate, std::ref(*worker_hardware[worker_id]));
+    }
+    if (busy[0]) evaluate(*worker_hardware[0]);
+    for (auto & worker : workers) worker.join();
+  } else {
+    evaluate(*eval_hardware);
+  }
+  if (phen_cache.IsEnabled()) phen_cache.RecordMisses(pending.size());
+}
+
+template<typename CONFIG_T>
+void BoolCalcWorld<CONFIG_T>::CompleteOrgEvaluation_Lazy(size_t org_id) {
+  hardware_t & hw = GetLazyHardware(org_id);
+  phenotype_t & phen = GetOrg(org_id).GetPhenotype();
+  for (size_t eval_index = 0; eval_index < phen.test_scores.size(); ++eval_index) {
+    if (phen.test_evaluated[eval_index]) continue;
+    LoadProgram_Lazy(hw, org_id);
+    phen.test_scores[eval_index] = EvaluateTest(hw, training_cases[phen.test_ids[eval_index]]);
+    phen.test_evaluated[eval_index] = true;
+    if (phen_cache.IsEnabled()) phen_cache.RecordMisses();
+  }
+  phen.UpdateAggregates();
+}
+
+template<typename CONFIG_T>
+void BoolCalcWorld<CONFIG_T>::CompletePopEvaluation_Lazy() {
+  for (size_t org_id = 0; org_id < GetSize(); ++org_id) {
+    if (!GetOrg(org_id).GetPhenotype().IsComplete()) {
+      CompleteOrgEvaluation_Lazy(org_id);
+    }
+  }
+}
+
+/// Finding the max fitness organism does not require evaluating everyone. An organism's aggregate
+/// score can be no larger than its known scores plus 1.0 for each unevaluated test, so we complete
+/// organisms in order of decreasing upper bound until no remaining organism could match the best.
+/// Scores are always summed in test order, so results match eager evaluation exactly.
+template<typename CONFIG_T>
+void BoolCalcWorld<CONFIG_T>::FinishEvaluation_Lazy() {
+  emp::vector<double> upper_bounds(GetSize(), 0.0);
+  emp::vector<size_t> org_ids(GetSize());
+  std::iota(org_ids.begin(), org_ids.end(), 0);
+  for (size_t org_id = 0; org_id < GetSize(); ++org_id) {
+    const phenotype_t & phen = GetOrg(org_id).GetPhenotype();
+    for (size_t eval_index = 0; eval_index < phen.test_scores.size(); ++eval_index) {
+      upper_bounds[org_id] += (phen.test_evaluated[eval_index]) ? phen.test_scores[eval_index] : 1.0;
+    }
+  }
+  std::stable_sort(org_ids.begin(), org_ids.end(), [&upper_bounds](size_t a, size_t b) {
+    return upper_bounds[a] > upper_bounds[b];
+  });
+  // Ties resolve to the lowest population id (as in eager evaluation).
+  max_fit_org_id = org_ids[0];
+  double max_score = -1.0;
+  for (size_t org_id : org_ids) {
+    if (upper_bounds[org_id] < max_score) break;
+    CompleteOrgEvaluation_Lazy(org_id);
+    const double score = CalcFitnessID(org_id);
+    if (score > max_score || (score == max_score && org_id < max_fit_org_id)) {
+      max_score = score;
+      max_fit_org_id = org_id;
+    }
+  }
+  // Remember newly evaluated test scores.
+  if (!phen_cache.IsEnabled()) return;
+  for (size_t org_id = 0; org_id < GetSize(); ++org_id) {
+    const phenotype_t & phen = GetOrg(org_id).GetPhenotype();
+    const program_t & program = GetOrg(org_id).GetGenome().GetProgram();
+    const size_t program_hash = HashProgram(program);
+    test_scores_t known_scores;
+    phen_cache.Get(program, program_hash, known_scores);
+    bool updated = false;
+    for (size_t eval_index = 0; eval_index < phen.test_scores.size(); ++eval_index) {
+      if (!phen.test_evaluated[eval_index]) continue;
+      updated |= known_scores.emplace(phen.test_ids[eval_index], phen.test_scores[eval_index]).second;
+    }
+    if (updated) phen_cache.Put(program, program_hash, known_scores);
+  }
+}
+
+/// Must be called immediately after the offspring is mutated (uses the mutator's tracking).
+/// Function-level mutations (dup, del, tag changes) shift matches, so they are never neutral.
+template<typename CONFIG_T>
+bool BoolCalcWorld<CONFIG_T>::IsNeutralMutant(size_t parent_id) {
+  if (mutator->GetFunctionSetChanged()) return false;
+  const auto & touched_funcs = mutator->GetTouchedFunctions();
+  if (touched_funcs.empty()) return true;
+  // Find (or look up) which of the parent's functions could run.
+  auto reachable_it = reachable_funcs_by_parent.find(parent_id);
+  if (reachable_it == reachable_funcs_by_parent.end()) {
+    LoadProgram(*eval_hardware, GetOrg(parent_id));
+    reachable_it = reachable_funcs_by_parent.emplace(
+      parent_id,
+      reachability->FindReachable(*eval_hardware, test_input_signal_tags)
+    ).first;
+  }
+  const emp::vector<bool> & reachable = reachable_it->second;
+  return std::none_of(touched_funcs.begin(), touched_funcs.end(), [&reachable](size_t func_id) {
+    return reachable[func_id];
+  });
+}
+
+template<typename CONFIG_T>
+void BoolCalcWorld<CONFIG_T>::InheritTestScores(org_t & offspring, const org_t & parent) {
+  const phenotype_t & parent_phen = parent.GetPhenotype();
+  phenotype_t & offspring_phen = offspring.GetPhenotype();
+  offspring_phen.known_test_scores = parent_phen.known_test_scores;
+  for (size_t eval_index = 0; eval_index < parent_phen.test_scores.size(); ++eval_index) {
+    if (!parent_phen.test_evaluated[eval_index]) continue;
+    offspring_phen.known_test_scores[parent_phen.test_ids[eval_index]] = parent_phen.test_scores[eval_index];
+  }
 }
 
-bool BoolCalcWorld::ScreenSolution(const org_t & org) {
+template<typename CONFIG_T>
+bool BoolCalcWorld<CONFIG_T>::ScreenSolution(hardware_t & hw, const org_t & org) {
   // How many tests did this organism pass?
   const size_t max_passes = org.GetPhenotype().num_passes;
   // Did this organism pass all the tests it was run on?
@@ -647,6 +1242,7 @@ bool BoolCalcWorld::ScreenSolution(const org_t & org) {
   emp_assert(screen_org.GetGenome() == org.GetGenome());
   emp_assert(all_test_case_ids.size() == all_test_cases.size());
   EvaluateOrg(
+    hw,                       // Hardware to evaluate on
     screen_org,               // Organism to evaluate
     all_test_cases,           // Test cases to evaluate organism on
     all_test_case_ids,        // Order to evaluate tests in (doesn't super matter)
@@ -657,7 +1253,8 @@ bool BoolCalcWorld::ScreenSolution(const org_t & org) {
   return (screen_passes == all_test_cases.size());
 }
 
-void BoolCalcWorld::AnalyzeOrg(const org_t & org, size_t pop_id) {
+template<typename CONFIG_T>
+void BoolCalcWorld<CONFIG_T>::AnalyzeOrg(const org_t & org, size_t pop_id) {
   // Analyze organism w/knockouts
   org_t test_org(org);
 
@@ -674,80 +1271,64 @@ void BoolCalcWorld::AnalyzeOrg(const org_t & org, size_t pop_id) {
 
   // Run with knockouts
   // - ko memory
-  KO_GLOBAL_MEMORY=true;
-  KO_REGULATION=false;
-  KO_DOWN_REGULATION=false;
-  KO_UP_REGULATION=false;
   org_t ko_mem_org(org);
+  hardware_t & ko_mem_hw = GetKnockoutHardware(KnockoutMode::GLOBAL_MEMORY);
   EvaluateOrg(
+    ko_mem_hw,
     ko_mem_org,
     training_cases,
     training_case_ids,
     training_case_ids.size()
   );
-  ko_mem_org.GetPhenotype().is_solution = ScreenSolution(ko_mem_org);
+  ko_mem_org.GetPhenotype().is_solution = ScreenSolution(ko_mem_hw, ko_mem_org);
 
   // - ko regulation
-  KO_GLOBAL_MEMORY=false;
-  KO_REGULATION=true;
-  KO_DOWN_REGULATION=false;
-  KO_UP_REGULATION=false;
   org_t ko_reg_org(org);
+  hardware_t & ko_reg_hw = GetKnockoutHardware(KnockoutMode::REGULATION);
   EvaluateOrg(
+    ko_reg_hw,
     ko_reg_org,
     training_cases,
     training_case_ids,
     training_case_ids.size()
   );
-  ko_reg_org.GetPhenotype().is_solution = ScreenSolution(ko_reg_org);
+  ko_reg_org.GetPhenotype().is_solution = ScreenSolution(ko_reg_hw, ko_reg_org);
 
   // - ko memory & regulation
-  KO_GLOBAL_MEMORY=true;
-  KO_REGULATION=true;
-  KO_DOWN_REGULATION=false;
-  KO_UP_REGULATION=false;
   org_t ko_all_org(org);
+  hardware_t & ko_all_hw = GetKnockoutHardware(KnockoutMode::GLOBAL_MEMORY_AND_REGULATION);
   EvaluateOrg(
+    ko_all_hw,
     ko_all_org,
     training_cases,
     training_case_ids,
     training_case_ids.size()
   );
-  ko_all_org.GetPhenotype().is_solution = ScreenSolution(ko_all_org);
+  ko_all_org.GetPhenotype().is_solution = ScreenSolution(ko_all_hw, ko_all_org);
 
-  // - ko up regulation
-  KO_GLOBAL_MEMORY=false;
-  KO_REGULATION=false;
-  KO_DOWN_REGULATION=true;
-  KO_UP_REGULATION=false;
+  // - ko down regulation
   org_t ko_down_reg_org(org);
+  hardware_t & ko_down_reg_hw = GetKnockoutHardware(KnockoutMode::DOWN_REGULATION);
   EvaluateOrg(
+    ko_down_reg_hw,
     ko_down_reg_org,
     training_cases,
     training_case_ids,
     training_case_ids.size()
   );
-  ko_down_reg_org.GetPhenotype().is_solution = ScreenSolution(ko_down_reg_org);
+  ko_down_reg_org.GetPhenotype().is_solution = ScreenSolution(ko_down_reg_hw, ko_down_reg_org);
 
-  // - ko down regulation
-  KO_GLOBAL_MEMORY=false;
-  KO_REGULATION=false;
-  KO_DOWN_REGULATION=false;
-  KO_UP_REGULATION=true;
+  // - ko up regulation
   org_t ko_up_reg_org(org);
+  hardware_t & ko_up_reg_hw = GetKnockoutHardware(KnockoutMode::UP_REGULATION);
   EvaluateOrg(
+    ko_up_reg_hw,
     ko_up_reg_org,
     training_cases,
     training_case_ids,
     training_case_ids.size()
   );
-  ko_up_reg_org.GetPhenotype().is_solution = ScreenSolution(ko_up_reg_org);
-
-  // reset knockout variables
-  KO_GLOBAL_MEMORY=false;
-  KO_REGULATION=false;
-  KO_DOWN_REGULATION=false;
-  KO_UP_REGULATION=false;
+  ko_up_reg_org.GetPhenotype().is_solution = ScreenSolution(ko_up_reg_hw, ko_up_reg_org);
 
   emp::DataFile analysis_file(
     OUTPUT_DIR + "/analysis_org_" + emp::to_string(pop_id) + "_update_" + emp::to_string(GetUpdate()) + ".csv"
@@ -896,7 +1477,8 @@ void BoolCalcWorld::AnalyzeOrg(const org_t & org, size_t pop_id) {
   analysis_file.Update();
 }
 
-void BoolCalcWorld::TraceOrganism(const org_t & org, size_t org_id/*=0*/) {
+template<typename CONFIG_T>
+void BoolCalcWorld<CONFIG_T>::TraceOrganism(const org_t & org, size_t org_id/*=0*/) {
   org_t trace_org(org); // Make a copy of the the given organism so we don't mess with any of the original's
                         // data.
   // Data file to store trace information.
@@ -911,13 +1493,8 @@ void BoolCalcWorld::TraceOrganism(const org_t & org, size_t org_id/*=0*/) {
   tag_t cur_test_input_tag=tag_t();
   BoolCalcTestInfo::TestSignal cur_test_signal=BoolCalcTestInfo::TestSignal(0, hw_response_type_t::NONE);
 
-  emp::vector<inst_t> executed_instructions;
-
-  inst_lib->OnBeforeInstExec(
-    [&executed_instructions](hardware_t & hw, const inst_t & inst) {
-      executed_instructions.emplace_back(inst);
-    }
-  );
+  // trace_hardware runs the tracing instruction library, which records executed instructions.
+  traced_instructions.clear();
 
   // ----- Timing information -----
   trace_file.template AddFun<size_t>([&cur_test_id]() {
@@ -965,22 +1542,22 @@ void BoolCalcWorld::TraceOrganism(const org_t & org, size_t org_id/*=0*/) {
   // ----- Hardware Information -----
   //    * current response
   trace_file.template AddFun<int>([this]() {
-    return eval_hardware->GetCustomComponent().GetResponseValue();
+    return trace_hardware->GetCustomComponent().GetResponseValue();
   }, "cur_response_value");
 
   trace_file.template AddFun<std::string>([this]() {
-    return BoolCalcTestInfo::ResponseStr(eval_hardware->GetCustomComponent().GetResponseType());
+    return BoolCalcTestInfo::ResponseStr(trace_hardware->GetCustomComponent().GetResponseType());
   }, "cur_response_type");
 
   trace_file.template AddFun<int>([this]() {
-    return eval_hardware->GetCustomComponent().GetResponseFunctionID();
+    return trace_hardware->GetCustomComponent().GetResponseFunctionID();
   }, "cur_responding_function");
 
   //    * correct responses
   trace_file.template AddFun<bool>([&trace_org, &cur_test_signal, this]() {
     return cur_test_signal.IsCorrect(
-      eval_hardware->GetCustomComponent().GetResponseType(),
-      eval_hardware->GetCustomComponent().GetResponseValue()
+      trace_hardware->GetCustomComponent().GetResponseType(),
+      trace_hardware->GetCustomComponent().GetResponseValue()
     );
   }, "has_correct_response");
 
@@ -1025,15 +1602,15 @@ void BoolCalcWorld::TraceOrganism(const org_t & org, size_t org_id/*=0*/) {
   }, "num_active_threads");
 
   trace_file.template AddFun<std::string>(
-    [&executed_instructions, this]() {
+    [this]() {
       std::ostringstream stream;
       stream << "\"[";
-      for (size_t i = 0; i < executed_instructions.size(); ++i) {
+      for (size_t i = 0; i < traced_instructions.size(); ++i) {
         if (i) stream << ",";
-        stream << inst_lib->GetName(executed_instructions[i].GetID());
+        stream << inst_lib->GetName(traced_instructions[i].GetID());
       }
       stream << "]\"";
-      executed_instructions.clear();
+      traced_instructions.clear();
       return stream.str();
     },
     "executed_instructions"
@@ -1064,7 +1641,7 @@ void BoolCalcWorld::TraceOrganism(const org_t & org, size_t org_id/*=0*/) {
   phen.Reset(num_tests);
 
   // Ready the hardware
-  eval_hardware->SetProgram(trace_org.GetGenome().program); // This resets the hardware completely.
+  trace_hardware->SetProgram(trace_org.GetGenome().program); // This resets the hardware completely.
   // Evaluate program on each training example
   // cpu_step
   // cur_test_id [x]
@@ -1075,8 +1652,8 @@ void BoolCalcWorld::TraceOrganism(const org_t & org, size_t org_id/*=0*/) {
   for (size_t eval_index = 0; eval_index < num_tests; ++eval_index) {
     emp_assert(eval_index < phen.test_scores.size());
     emp_assert(phen.test_scores[eval_index] == 0);
-    eval_hardware->ResetMatchBin();       // Reset matchbin (regulation) between tests
-    eval_hardware->ResetHardwareState();  // Reset global memory between tests
+    trace_hardware->ResetMatchBin();       // Reset matchbin (regulation) between tests
+    trace_hardware->ResetHardwareState();  // Reset global memory between tests
     // grab the test case id
     const size_t test_id = test_eval_order[eval_index];
     phen.test_ids[eval_index] = test_id;
@@ -1097,42 +1674,42 @@ void BoolCalcWorld::TraceOrganism(const org_t & org, size_t org_id/*=0*/) {
       cur_test_input_tag = test_sig_tag;
 
       // Reset the hardware
-      eval_hardware->ResetBaseHardwareState(); // Only reset threads, not global memory
-      eval_hardware->GetCustomComponent().Reset();
-      emp_assert(eval_hardware->ValidateThreadState());
-      emp_assert(eval_hardware->GetActiveThreadIDs().size() == 0);
-      emp_assert(eval_hardware->GetNumQueuedEvents() == 0);
+      trace_hardware->ResetBaseHardwareState(); // Only reset threads, not global memory
+      trace_hardware->GetCustomComponent().Reset();
+      emp_assert(trace_hardware->ValidateThreadState());
+      emp_assert(trace_hardware->GetActiveThreadIDs().size() == 0);
+      emp_assert(trace_hardware->GetNumQueuedEvents() == 0);
       // Queue calculator button input
       if (test_sig.IsOperand()) {
-        eval_hardware->QueueEvent(
+        trace_hardware->QueueEvent(
           event_t(event_id_input_sig, test_sig_tag, {{0, (double)test_sig.GetOperand()}})
         );
       } else if (test_sig.IsOperator()) {
-        eval_hardware->QueueEvent(
+        trace_hardware->QueueEvent(
           event_t(event_id_input_sig, test_sig_tag)
         );
       }
 
       cpu_step = 0;
-      hw_state_info = GetHardwareStatePrintInfo(*eval_hardware);
+      hw_state_info = GetHardwareStatePrintInfo(*trace_hardware);
       trace_file.Update();
 
       // Step the hardware forward to process the signal
       while (cpu_step < CPU_CYCLES_PER_INPUT_SIGNAL) {
-        eval_hardware->SingleProcess();
+        trace_hardware->SingleProcess();
         ++cpu_step;
-        hw_state_info = GetHardwareStatePrintInfo(*eval_hardware);
+        hw_state_info = GetHardwareStatePrintInfo(*trace_hardware);
         trace_file.Update();
         // Stop early if no active or pending threads
-        const size_t num_active_threads = eval_hardware->GetNumActiveThreads();
-        const size_t num_pending_threads = eval_hardware->GetNumPendingThreads();
+        const size_t num_active_threads = trace_hardware->GetNumActiveThreads();
+        const size_t num_pending_threads = trace_hardware->GetNumPendingThreads();
         if (!( num_active_threads || num_pending_threads )) break;
       }
 
       // How did the organism respond?
-      const bool has_response = eval_hardware->GetCustomComponent().HasResponse();
-      const hw_response_type_t resp_type = eval_hardware->GetCustomComponent().GetResponseType();
-      const operand_t resp_val = eval_hardware->GetCustomComponent().GetResponseValue();
+      const bool has_response = trace_hardware->GetCustomComponent().HasResponse();
+      const hw_response_type_t resp_type = trace_hardware->GetCustomComponent().GetResponseType();
+      const operand_t resp_val = trace_hardware->GetCustomComponent().GetResponseValue();
       const bool is_correct = test_sig.IsCorrect(resp_type, resp_val);
       if (has_response && is_correct) {
         phen.test_scores[eval_index] += partial_credit;
@@ -1161,11 +1738,10 @@ void BoolCalcWorld::TraceOrganism(const org_t & org, size_t org_id/*=0*/) {
     // Update aggregate score
     phen.aggregate_score += phen.test_scores[eval_index];
   }
-
-  inst_lib->ResetBeforeInstExecSignal();
 }
 
-void BoolCalcWorld::InitConfigs(const config_t & config) {
+template<typename CONFIG_T>
+void BoolCalcWorld<CONFIG_T>::InitConfigs(const config_t & config) {
   // General
   SEED = config.SEED();
   GENERATIONS = config.GENERATIONS();
@@ -1176,10 +1752,15 @@ void BoolCalcWorld::InitConfigs(const config_t & config) {
   TRAINING_SET_FILE = config.TRAINING_SET_FILE();
   CPU_CYCLES_PER_INPUT_SIGNAL = config.CPU_CYCLES_PER_INPUT_SIGNAL();
   CATEGORICAL_OUTPUT = config.CATEGORICAL_OUTPUT();
+  NUM_EVAL_THREADS = config.NUM_EVAL_THREADS();
+  PHENOTYPE_CACHE_SIZE = config.PHENOTYPE_CACHE_SIZE();
+  INHERIT_NEUTRAL_PHENOTYPES = config.INHERIT_NEUTRAL_PHENOTYPES();
+  SHARE_TEST_PREFIXES = config.SHARE_TEST_PREFIXES();
   // Selection
   DOWN_SAMPLE = config.DOWN_SAMPLE();
   DOWN_SAMPLE_RATE = config.DOWN_SAMPLE_RATE();
   SAMPLE_BY_TEST_TYPE = config.SAMPLE_BY_TEST_TYPE();
+  LAZY_LEXICASE = config.LAZY_LEXICASE();
   // Program
   USE_FUNC_REGULATION = config.USE_FUNC_REGULATION();
   USE_GLOBAL_MEMORY = config.USE_GLOBAL_MEMORY();
@@ -1210,90 +1791,121 @@ void BoolCalcWorld::InitConfigs(const config_t & config) {
   OUTPUT_PROGRAMS = config.OUTPUT_PROGRAMS();
 }
 
-void BoolCalcWorld::InitInstLib() {
-  if (!setup) inst_lib = emp::NewPtr<inst_lib_t>();
-  inst_lib->Clear(); // Reset the instruction library
-  inst_lib->AddInst("Nop", [](hardware_t & hw, const inst_t & inst) { ; }, "No operation!");
-  inst_lib->AddInst("Inc", sgp::inst_impl::Inst_Inc<hardware_t, inst_t>, "Increment!");
-  inst_lib->AddInst("Dec", sgp::inst_impl::Inst_Dec<hardware_t, inst_t>, "Decrement!");
-  inst_lib->AddInst("Not", sgp::inst_impl::Inst_Not<hardware_t, inst_t>, "Logical not of ARG[0]");
-  inst_lib->AddInst("Add", sgp::inst_impl::Inst_Add<hardware_t, inst_t>, "");
-  inst_lib->AddInst("Sub", sgp::inst_impl::Inst_Sub<hardware_t, inst_t>, "");
-  inst_lib->AddInst("Mult", sgp::inst_impl::Inst_Mult<hardware_t, inst_t>, "");
-  inst_lib->AddInst("Div", sgp::inst_impl::Inst_Div<hardware_t, inst_t>, "");
-  inst_lib->AddInst("Mod", sgp::inst_impl::Inst_Mod<hardware_t, inst_t>, "");
-  inst_lib->AddInst("TestEqu", sgp::inst_impl::Inst_TestEqu<hardware_t, inst_t>, "");
-  inst_lib->AddInst("TestNEqu", sgp::inst_impl::Inst_TestNEqu<hardware_t, inst_t>, "");
-  inst_lib->AddInst("TestLess", sgp::inst_impl::Inst_TestLess<hardware_t, inst_t>, "");
-  inst_lib->AddInst("TestLessEqu", sgp::inst_impl::Inst_TestLessEqu<hardware_t, inst_t>, "");
-  inst_lib->AddInst("TestGreater", sgp::inst_impl::Inst_TestGreater<hardware_t, inst_t>, "");
-  inst_lib->AddInst("TestGreaterEqu", sgp::inst_impl::Inst_TestGreaterEqu<hardware_t, inst_t>, "");
-  inst_lib->AddInst("SetMem", sgp::inst_impl::Inst_SetMem<hardware_t, inst_t>, "");
-  inst_lib->AddInst("Close", sgp::inst_impl::Inst_Close<hardware_t, inst_t>, "", {inst_prop_t::BLOCK_CLOSE});
-  inst_lib->AddInst("Break", sgp::inst_impl::Inst_Break<hardware_t, inst_t>, "");
-  inst_lib->AddInst("Call", sgp::inst_impl::Inst_Call<hardware_t, inst_t>, "");
-  inst_lib->AddInst("Return", sgp::inst_impl::Inst_Return<hardware_t, inst_t>, "");
-  inst_lib->AddInst("CopyMem", sgp::inst_impl::Inst_CopyMem<hardware_t, inst_t>, "");
-  inst_lib->AddInst("SwapMem", sgp::inst_impl::Inst_SwapMem<hardware_t, inst_t>, "");
-  inst_lib->AddInst("InputToWorking", sgp::inst_impl::Inst_InputToWorking<hardware_t, inst_t>, "");
-  inst_lib->AddInst("WorkingToOutput", sgp::inst_impl::Inst_WorkingToOutput<hardware_t, inst_t>, "");
-  inst_lib->AddInst("Fork", sgp::inst_impl::Inst_Fork<hardware_t, inst_t>, "");
-  inst_lib->AddInst("Terminate", sgp::inst_impl::Inst_Terminate<hardware_t, inst_t>, "");
-  inst_lib->AddInst("If", sgp::lfp_inst_impl::Inst_If<hardware_t, inst_t>, "", {inst_prop_t::BLOCK_DEF});
-  inst_lib->AddInst("While", sgp::lfp_inst_impl::Inst_While<hardware_t, inst_t>, "", {inst_prop_t::BLOCK_DEF});
-  inst_lib->AddInst("Routine", sgp::lfp_inst_impl::Inst_Routine<hardware_t, inst_t>, "");
-  inst_lib->AddInst("Terminal", sgp::inst_impl::Inst_Terminal<hardware_t, inst_t,
-                                                              std::ratio<1>, std::ratio<-1>>, "");
-  inst_lib->AddInst("Nand", Inst_Nand<hardware_t, inst_t, operand_t>, "Perform NAND");
+template<typename CONFIG_T>
+void BoolCalcWorld<CONFIG_T>::InitInstLib() {
+  if (!setup) {
+    inst_lib = emp::NewPtr<inst_lib_t>();
+    trace_inst_lib = emp::NewPtr<inst_lib_t>();
+    for (size_t mode = 0; mode < NUM_KNOCKOUT_MODES; ++mode) ko_inst_libs.emplace_back(emp::NewPtr<inst_lib_t>());
+  }
+  AddInstructions<NoKnockouts>(*inst_lib);
+  AddInstructions<NoKnockouts>(*trace_inst_lib, InstRecorder<inst_t>(traced_instructions));
+  AddKnockoutInstructions<KnockoutMode::GLOBAL_MEMORY>();
+  AddKnockoutInstructions<KnockoutMode::REGULATION>();
+  AddKnockoutInstructions<KnockoutMode::GLOBAL_MEMORY_AND_REGULATION>();
+  AddKnockoutInstructions<KnockoutMode::UP_REGULATION>();
+  AddKnockoutInstructions<KnockoutMode::DOWN_REGULATION>();
+}
+
+template<typename CONFIG_T>
+template<typename KNOCKOUTS_T, typename OBSERVER_T>
+void BoolCalcWorld<CONFIG_T>::AddInstructions(inst_lib_t & target_lib, const OBSERVER_T & observer) {
+  ObservedInstLib<inst_lib_t, inst_prop_t, OBSERVER_T> lib(target_lib, observer);
+  lib.Clear(); // Reset the instruction library
+  // Categories configure neutral mutant detection (see InitMutator).
+  inst_categories.clear();
+  auto categorize = [this, &target_lib](InstCategory category) {
+    inst_categories.resize(target_lib.GetSize(), InstCategory::OTHER);
+    inst_categories.back() = category;
+  };
+  lib.AddInst("Nop", [](hardware_t & hw, const inst_t & inst) { ; }, "No operation!");
+  categorize(InstCategory::NOP);
+  lib.AddInst("Inc", DirectInst<sgp::inst_impl::Inst_Inc<hardware_t, inst_t>>{}, "Increment!");
+  lib.AddInst("Dec", DirectInst<sgp::inst_impl::Inst_Dec<hardware_t, inst_t>>{}, "Decrement!");
+  lib.AddInst("Not", DirectInst<sgp::inst_impl::Inst_Not<hardware_t, inst_t>>{}, "Logical not of ARG[0]");
+  lib.AddInst("Add", DirectInst<sgp::inst_impl::Inst_Add<hardware_t, inst_t>>{}, "");
+  lib.AddInst("Sub", DirectInst<sgp::inst_impl::Inst_Sub<hardware_t, inst_t>>{}, "");
+  lib.AddInst("Mult", DirectInst<sgp::inst_impl::Inst_Mult<hardware_t, inst_t>>{}, "");
+  lib.AddInst("Div", DirectInst<sgp::inst_impl::Inst_Div<hardware_t, inst_t>>{}, "");
+  lib.AddInst("Mod", DirectInst<sgp::inst_impl::Inst_Mod<hardware_t, inst_t>>{}, "");
+  lib.AddInst("TestEqu", DirectInst<sgp::inst_impl::Inst_TestEqu<hardware_t, inst_t>>{}, "");
+  lib.AddInst("TestNEqu", DirectInst<sgp::inst_impl::Inst_TestNEqu<hardware_t, inst_t>>{}, "");
+  lib.AddInst("TestLess", DirectInst<sgp::inst_impl::Inst_TestLess<hardware_t, inst_t>>{}, "");
+  lib.AddInst("TestLessEqu", DirectInst<sgp::inst_impl::Inst_TestLessEqu<hardware_t, inst_t>>{}, "");
+  lib.AddInst("TestGreater", DirectInst<sgp::inst_impl::Inst_TestGreater<hardware_t, inst_t>>{}, "");
+  lib.AddInst("TestGreaterEqu", DirectInst<sgp::inst_impl::Inst_TestGreaterEqu<hardware_t, inst_t>>{}, "");
+  lib.AddInst("SetMem", DirectInst<sgp::inst_impl::Inst_SetMem<hardware_t, inst_t>>{}, "");
+  lib.AddInst("Close", DirectInst<sgp::inst_impl::Inst_Close<hardware_t, inst_t>>{}, "", {inst_prop_t::BLOCK_CLOSE});
+  lib.AddInst("Break", DirectInst<sgp::inst_impl::Inst_Break<hardware_t, inst_t>>{}, "");
+  lib.AddInst("Call", DirectInst<sgp::inst_impl::Inst_Call<hardware_t, inst_t>>{}, "");
+  categorize(InstCategory::FLOW);
+  lib.AddInst("Return", DirectInst<sgp::inst_impl::Inst_Return<hardware_t, inst_t>>{}, "");
+  lib.AddInst("CopyMem", DirectInst<sgp::inst_impl::Inst_CopyMem<hardware_t, inst_t>>{}, "");
+  lib.AddInst("SwapMem", DirectInst<sgp::inst_impl::Inst_SwapMem<hardware_t, inst_t>>{}, "");
+  lib.AddInst("InputToWorking", DirectInst<sgp::inst_impl::Inst_InputToWorking<hardware_t, inst_t>>{}, "");
+  lib.AddInst("WorkingToOutput", DirectInst<sgp::inst_impl::Inst_WorkingToOutput<hardware_t, inst_t>>{}, "");
+  lib.AddInst("Fork", DirectInst<sgp::inst_impl::Inst_Fork<hardware_t, inst_t>>{}, "");
+  categorize(InstCategory::FLOW);
+  lib.AddInst("Terminate", DirectInst<sgp::inst_impl::Inst_Terminate<hardware_t, inst_t>>{}, "");
+  lib.AddInst("If", DirectInst<sgp::lfp_inst_impl::Inst_If<hardware_t, inst_t>>{}, "", {inst_prop_t::BLOCK_DEF});
+  lib.AddInst("While", DirectInst<sgp::lfp_inst_impl::Inst_While<hardware_t, inst_t>>{}, "", {inst_prop_t::BLOCK_DEF});
+  lib.AddInst("Routine", DirectInst<sgp::lfp_inst_impl::Inst_Routine<hardware_t, inst_t>>{}, "");
+  categorize(InstCategory::FLOW);
+  lib.AddInst("Terminal", DirectInst<sgp::inst_impl::Inst_Terminal<hardware_t, inst_t, std::ratio<1>, std::ratio<-1>>>{}, "");
+  lib.AddInst("Nand", DirectInst<Inst_Nand<hardware_t, inst_t, operand_t>>{}, "Perform NAND");
 
   // If we can use global memory, give programs access. Otherwise, nops.
   if (USE_GLOBAL_MEMORY) {
-    inst_lib->AddInst(
+    lib.AddInst(
       "WorkingToGlobal",
-      [this](hardware_t & hw, const inst_t & inst) {
-        if (!KO_GLOBAL_MEMORY) sgp::inst_impl::Inst_WorkingToGlobal<hardware_t, inst_t>(hw, inst);
+      [](hardware_t & hw, const inst_t & inst) {
+        if constexpr (!KNOCKOUTS_T::global_memory) sgp::inst_impl::Inst_WorkingToGlobal<hardware_t, inst_t>(hw, inst);
       },
       "Push working memory to global memory"
     );
-    inst_lib->AddInst(
+    lib.AddInst(
       "GlobalToWorking",
-      [this](hardware_t & hw, const inst_t & inst) {
-        if (!KO_GLOBAL_MEMORY) sgp::inst_impl::Inst_GlobalToWorking<hardware_t, inst_t>(hw, inst);
+      [](hardware_t & hw, const inst_t & inst) {
+        if constexpr (!KNOCKOUTS_T::global_memory) sgp::inst_impl::Inst_GlobalToWorking<hardware_t, inst_t>(hw, inst);
       },
       "Pull global memory into working memory"
     );
 
-    inst_lib->AddInst(
+    lib.AddInst(
       "FullWorkingToGlobal",
-      [this](hardware_t & hw, const inst_t & inst) {
-        if (!KO_GLOBAL_MEMORY) sgp::inst_impl::Inst_FullWorkingToGlobal<hardware_t, inst_t>(hw, inst);
+      [](hardware_t & hw, const inst_t & inst) {
+        if constexpr (!KNOCKOUTS_T::global_memory) sgp::inst_impl::Inst_FullWorkingToGlobal<hardware_t, inst_t>(hw, inst);
       },
       "Push all working memory to global memory"
     );
-    inst_lib->AddInst(
+    lib.AddInst(
       "FullGlobalToWorking",
-      [this](hardware_t & hw, const inst_t & inst) {
-        if (!KO_GLOBAL_MEMORY) sgp::inst_impl::Inst_FullGlobalToWorking<hardware_t, inst_t>(hw, inst);
+      [](hardware_t & hw, const inst_t & inst) {
+        if constexpr (!KNOCKOUTS_T::global_memory) sgp::inst_impl::Inst_FullGlobalToWorking<hardware_t, inst_t>(hw, inst);
       },
       "Pull all global memory into working memory"
     );
   } else {
-    inst_lib->AddInst("Nop-WorkingToGlobal", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "Nop");
-    inst_lib->AddInst("Nop-GlobalToWorking", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "Nop");
-    inst_lib->AddInst("Nop-FullWorkingToGlobal", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "Nop");
-    inst_lib->AddInst("Nop-FullGlobalToWorking", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "Nop");
+    lib.AddInst("Nop-WorkingToGlobal", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "Nop");
+    categorize(InstCategory::NOP);
+    lib.AddInst("Nop-GlobalToWorking", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "Nop");
+    categorize(InstCategory::NOP);
+    lib.AddInst("Nop-FullWorkingToGlobal", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "Nop");
+    categorize(InstCategory::NOP);
+    lib.AddInst("Nop-FullGlobalToWorking", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "Nop");
+    categorize(InstCategory::NOP);
   }
 
   // If we can use regulation, add instructions. Otherwise, nops.
   if (USE_FUNC_REGULATION) {
-    inst_lib->AddInst(
+    lib.AddInst(
       "SetRegulator",
-      [this](hardware_t & hw, const inst_t & inst) {
-        if (KO_REGULATION) {
+      [](hardware_t & hw, const inst_t & inst) {
+        if constexpr (KNOCKOUTS_T::regulation) {
           return;
-        } else if (KO_DOWN_REGULATION) {
+        } else if constexpr (KNOCKOUTS_T::down_regulation) {
           inst_impls::Inst_SetRegulator_KO_DOWN_REG<hardware_t, inst_t>(hw, inst);
-        } else if (KO_UP_REGULATION) {
+        } else if constexpr (KNOCKOUTS_T::up_regulation) {
           inst_impls::Inst_SetRegulator_KO_UP_REG<hardware_t, inst_t>(hw, inst);
         } else {
           sgp::inst_impl::Inst_SetRegulator<hardware_t, inst_t>(hw, inst);
@@ -1301,164 +1913,194 @@ void BoolCalcWorld::InitInstLib() {
       },
     ""
     );
-    inst_lib->AddInst("SetRegulator-", [this](hardware_t & hw, const inst_t & inst) {
-      if (KO_REGULATION) {
+    categorize(InstCategory::REGULATOR);
+    lib.AddInst("SetRegulator-", [](hardware_t & hw, const inst_t & inst) {
+      if constexpr (KNOCKOUTS_T::regulation) {
         return;
-      } else if (KO_DOWN_REGULATION) {
+      } else if constexpr (KNOCKOUTS_T::down_regulation) {
         inst_impls::Inst_SetRegulator_KO_DOWN_REG<hardware_t, inst_t, -1>(hw, inst);
-      } else if (KO_UP_REGULATION) {
+      } else if constexpr (KNOCKOUTS_T::up_regulation) {
         inst_impls::Inst_SetRegulator_KO_UP_REG<hardware_t, inst_t, -1>(hw, inst);
       } else {
         sgp::inst_impl::Inst_SetRegulator<hardware_t, inst_t, -1>(hw, inst);
       }
     }, "");
+    categorize(InstCategory::REGULATOR);
 
-    inst_lib->AddInst("SetOwnRegulator", [this](hardware_t & hw, const inst_t & inst) {
-      if (KO_REGULATION) {
+    lib.AddInst("SetOwnRegulator", [](hardware_t & hw, const inst_t & inst) {
+      if constexpr (KNOCKOUTS_T::regulation) {
         return;
-      } else if (KO_DOWN_REGULATION) {
+      } else if constexpr (KNOCKOUTS_T::down_regulation) {
         inst_impls::Inst_SetOwnRegulator_KO_DOWN_REG<hardware_t, inst_t>(hw, inst);
-      } else if (KO_UP_REGULATION) {
+      } else if constexpr (KNOCKOUTS_T::up_regulation) {
         inst_impls::Inst_SetOwnRegulator_KO_UP_REG<hardware_t, inst_t>(hw, inst);
       } else {
         sgp::inst_impl::Inst_SetOwnRegulator<hardware_t, inst_t>(hw, inst);
       }
     }, "");
-    inst_lib->AddInst("SetOwnRegulator-", [this](hardware_t & hw, const inst_t & inst) {
-      if (KO_REGULATION) {
+    categorize(InstCategory::OWN_REGULATOR);
+    lib.AddInst("SetOwnRegulator-", [](hardware_t & hw, const inst_t & inst) {
+      if constexpr (KNOCKOUTS_T::regulation) {
         return;
-      } else if (KO_DOWN_REGULATION) {
+      } else if constexpr (KNOCKOUTS_T::down_regulation) {
         inst_impls::Inst_SetOwnRegulator_KO_DOWN_REG<hardware_t, inst_t, -1>(hw, inst);
-      } else if (KO_UP_REGULATION) {
+      } else if constexpr (KNOCKOUTS_T::up_regulation) {
         inst_impls::Inst_SetOwnRegulator_KO_UP_REG<hardware_t, inst_t, -1>(hw, inst);
       } else {
         sgp::inst_impl::Inst_SetOwnRegulator<hardware_t, inst_t, -1>(hw, inst);
       }
     }, "");
+    categorize(InstCategory::OWN_REGULATOR);
 
-    inst_lib->AddInst("AdjRegulator", [this](hardware_t & hw, const inst_t & inst) {
-      if (KO_REGULATION) {
+    lib.AddInst("AdjRegulator", [](hardware_t & hw, const inst_t & inst) {
+      if constexpr (KNOCKOUTS_T::regulation) {
         return;
-      } else if (KO_DOWN_REGULATION) {
+      } else if constexpr (KNOCKOUTS_T::down_regulation) {
         inst_impls::Inst_AdjRegulator_KO_DOWN_REG<hardware_t, inst_t>(hw, inst);
-      } else if (KO_UP_REGULATION) {
+      } else if constexpr (KNOCKOUTS_T::up_regulation) {
         inst_impls::Inst_AdjRegulator_KO_UP_REG<hardware_t, inst_t>(hw, inst);
       } else {
         sgp::inst_impl::Inst_AdjRegulator<hardware_t, inst_t>(hw, inst);
       }
     }, "");
-    inst_lib->AddInst("AdjRegulator-", [this](hardware_t & hw, const inst_t & inst) {
-      if (KO_REGULATION) {
+    categorize(InstCategory::REGULATOR);
+    lib.AddInst("AdjRegulator-", [](hardware_t & hw, const inst_t & inst) {
+      if constexpr (KNOCKOUTS_T::regulation) {
         return;
-      } else if (KO_DOWN_REGULATION) {
+      } else if constexpr (KNOCKOUTS_T::down_regulation) {
         inst_impls::Inst_AdjRegulator_KO_DOWN_REG<hardware_t, inst_t, -1>(hw, inst);
-      } else if (KO_UP_REGULATION) {
+      } else if constexpr (KNOCKOUTS_T::up_regulation) {
         inst_impls::Inst_AdjRegulator_KO_UP_REG<hardware_t, inst_t, -1>(hw, inst);
       } else {
         sgp::inst_impl::Inst_AdjRegulator<hardware_t, inst_t, -1>(hw, inst);
       }
     }, "");
-    inst_lib->AddInst("AdjOwnRegulator", [this](hardware_t & hw, const inst_t & inst) {
-      if (KO_REGULATION) {
+    categorize(InstCategory::REGULATOR);
+    lib.AddInst("AdjOwnRegulator", [](hardware_t & hw, const inst_t & inst) {
+      if constexpr (KNOCKOUTS_T::regulation) {
         return;
-      } else if (KO_DOWN_REGULATION) {
+      } else if constexpr (KNOCKOUTS_T::down_regulation) {
         inst_impls::Inst_AdjOwnRegulator_KO_DOWN_REG<hardware_t, inst_t>(hw, inst);
-      } else if (KO_UP_REGULATION) {
+      } else if constexpr (KNOCKOUTS_T::up_regulation) {
         inst_impls::Inst_AdjOwnRegulator_KO_UP_REG<hardware_t, inst_t>(hw, inst);
       } else {
         sgp::inst_impl::Inst_AdjOwnRegulator<hardware_t, inst_t>(hw, inst);
       }
     }, "");
-    inst_lib->AddInst("AdjOwnRegulator-", [this](hardware_t & hw, const inst_t & inst) {
-      if (KO_REGULATION) {
+    categorize(InstCategory::OWN_REGULATOR);
+    lib.AddInst("AdjOwnRegulator-", [](hardware_t & hw, const inst_t & inst) {
+      if constexpr (KNOCKOUTS_T::regulation) {
         return;
-      } else if (KO_DOWN_REGULATION) {
+      } else if constexpr (KNOCKOUTS_T::down_regulation) {
         inst_impls::Inst_AdjOwnRegulator_KO_DOWN_REG<hardware_t, inst_t, -1>(hw, inst);
-      } else if (KO_UP_REGULATION) {
+      } else if constexpr (KNOCKOUTS_T::up_regulation) {
         inst_impls::Inst_AdjOwnRegulator_KO_UP_REG<hardware_t, inst_t, -1>(hw, inst);
       } else {
         sgp::inst_impl::Inst_AdjOwnRegulator<hardware_t, inst_t, -1>(hw, inst);
       }
     }, "");
+    categorize(InstCategory::OWN_REGULATOR);
 
-    inst_lib->AddInst("ClearRegulator", [this](hardware_t & hw, const inst_t & inst) {
-      if (KO_REGULATION) {
+    lib.AddInst("ClearRegulator", [](hardware_t & hw, const inst_t & inst) {
+      if constexpr (KNOCKOUTS_T::regulation) {
         return;
-      } else if (KO_DOWN_REGULATION) {
+      } else if constexpr (KNOCKOUTS_T::down_regulation) {
         inst_impls::Inst_ClearRegulator_KO_DOWN_REG<hardware_t, inst_t>(hw, inst);
-      } else if (KO_UP_REGULATION) {
+      } else if constexpr (KNOCKOUTS_T::up_regulation) {
         inst_impls::Inst_ClearRegulator_KO_UP_REG<hardware_t, inst_t>(hw, inst);
       } else {
         sgp::inst_impl::Inst_ClearRegulator<hardware_t, inst_t>(hw, inst);
       }
     }, "");
-    inst_lib->AddInst("ClearOwnRegulator", [this](hardware_t & hw, const inst_t & inst) {
-      if (KO_REGULATION) {
+    categorize(InstCategory::REGULATOR);
+    lib.AddInst("ClearOwnRegulator", [](hardware_t & hw, const inst_t & inst) {
+      if constexpr (KNOCKOUTS_T::regulation) {
         return;
-      } else if (KO_DOWN_REGULATION) {
+      } else if constexpr (KNOCKOUTS_T::down_regulation) {
         inst_impls::Inst_ClearOwnRegulator_KO_DOWN_REG<hardware_t, inst_t>(hw, inst);
-      } else if (KO_UP_REGULATION) {
+      } else if constexpr (KNOCKOUTS_T::up_regulation) {
         inst_impls::Inst_ClearOwnRegulator_KO_UP_REG<hardware_t, inst_t>(hw, inst);
       } else {
         sgp::inst_impl::Inst_ClearOwnRegulator<hardware_t, inst_t>(hw, inst);
       }
     }, "");
-    inst_lib->AddInst("SenseRegulator", [this](hardware_t & hw, const inst_t & inst) {
-      if (!KO_REGULATION) sgp::inst_impl::Inst_SenseRegulator<hardware_t, inst_t>(hw, inst);
+    categorize(InstCategory::OWN_REGULATOR);
+    lib.AddInst("SenseRegulator", [](hardware_t & hw, const inst_t & inst) {
+      if constexpr (!KNOCKOUTS_T::regulation) sgp::inst_impl::Inst_SenseRegulator<hardware_t, inst_t>(hw, inst);
     }, "");
-    inst_lib->AddInst("SenseOwnRegulator", [this](hardware_t & hw, const inst_t & inst) {
-      if (!KO_REGULATION) sgp::inst_impl::Inst_SenseOwnRegulator<hardware_t, inst_t>(hw, inst);
+    lib.AddInst("SenseOwnRegulator", [](hardware_t & hw, const inst_t & inst) {
+      if constexpr (!KNOCKOUTS_T::regulation) sgp::inst_impl::Inst_SenseOwnRegulator<hardware_t, inst_t>(hw, inst);
     }, "");
 
-    inst_lib->AddInst("IncRegulator", [this](hardware_t & hw, const inst_t & inst) {
-      if (KO_REGULATION || KO_DOWN_REGULATION) {
+    lib.AddInst("IncRegulator", [](hardware_t & hw, const inst_t & inst) {
+      if constexpr (KNOCKOUTS_T::regulation || KNOCKOUTS_T::down_regulation) {
         return;
       } else {
         sgp::inst_impl::Inst_IncRegulator<hardware_t, inst_t>(hw, inst);
       }
     }, "");
-    inst_lib->AddInst("IncOwnRegulator", [this](hardware_t & hw, const inst_t & inst) {
-      if (KO_REGULATION || KO_DOWN_REGULATION) {
+    categorize(InstCategory::REGULATOR);
+    lib.AddInst("IncOwnRegulator", [](hardware_t & hw, const inst_t & inst) {
+      if constexpr (KNOCKOUTS_T::regulation || KNOCKOUTS_T::down_regulation) {
         return;
       } else {
         sgp::inst_impl::Inst_IncOwnRegulator<hardware_t, inst_t>(hw, inst);
       }
      }, "");
-    inst_lib->AddInst("DecRegulator", [this](hardware_t & hw, const inst_t & inst) {
-      if (KO_REGULATION || KO_UP_REGULATION) {
+    categorize(InstCategory::OWN_REGULATOR);
+    lib.AddInst("DecRegulator", [](hardware_t & hw, const inst_t & inst) {
+      if constexpr (KNOCKOUTS_T::regulation || KNOCKOUTS_T::up_regulation) {
         return;
       } else {
         sgp::inst_impl::Inst_DecRegulator<hardware_t, inst_t>(hw, inst);
       }
     }, "");
-    inst_lib->AddInst("DecOwnRegulator", [this](hardware_t & hw, const inst_t & inst) {
-      if (KO_REGULATION || KO_UP_REGULATION) {
+    categorize(InstCategory::REGULATOR);
+    lib.AddInst("DecOwnRegulator", [](hardware_t & hw, const inst_t & inst) {
+      if constexpr (KNOCKOUTS_T::regulation || KNOCKOUTS_T::up_regulation) {
         return;
       } else {
         sgp::inst_impl::Inst_DecOwnRegulator<hardware_t, inst_t>(hw, inst);
       }
     }, "");
+    categorize(InstCategory::OWN_REGULATOR);
   } else {
-    inst_lib->AddInst("Nop-SetRegulator", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "");
-    inst_lib->AddInst("Nop-SetOwnRegulator", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "");
-    inst_lib->AddInst("Nop-AdjRegulator", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "");
-    inst_lib->AddInst("Nop-AdjOwnRegulator", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "");
-    inst_lib->AddInst("Nop-SetRegulator-", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "");
-    inst_lib->AddInst("Nop-SetOwnRegulator-", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "");
-    inst_lib->AddInst("Nop-AdjRegulator-", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "");
-    inst_lib->AddInst("Nop-AdjOwnRegulator-", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "");
-    inst_lib->AddInst("Nop-ClearRegulator", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "");
-    inst_lib->AddInst("Nop-ClearOwnRegulator", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "");
-    inst_lib->AddInst("Nop-SenseRegulator", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "");
-    inst_lib->AddInst("Nop-SenseOwnRegulator", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "");
-    inst_lib->AddInst("Nop-IncRegulator", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "");
-    inst_lib->AddInst("Nop-IncOwnRegulator", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "");
-    inst_lib->AddInst("Nop-DecRegulator", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "");
-    inst_lib->AddInst("Nop-DecOwnRegulator", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "");
+    lib.AddInst("Nop-SetRegulator", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "");
+    categorize(InstCategory::NOP);
+    lib.AddInst("Nop-SetOwnRegulator", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "");
+    categorize(InstCategory::NOP);
+    lib.AddInst("Nop-AdjRegulator", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "");
+    categorize(InstCategory::NOP);
+    lib.AddInst("Nop-AdjOwnRegulator", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "");
+    categorize(InstCategory::NOP);
+    lib.AddInst("Nop-SetRegulator-", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "");
+    categorize(InstCategory::NOP);
+    lib.AddInst("Nop-SetOwnRegulator-", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "");
+    categorize(InstCategory::NOP);
+    lib.AddInst("Nop-AdjRegulator-", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "");
+    categorize(InstCategory::NOP);
+    lib.AddInst("Nop-AdjOwnRegulator-", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "");
+    categorize(InstCategory::NOP);
+    lib.AddInst("Nop-ClearRegulator", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "");
+    categorize(InstCategory::NOP);
+    lib.AddInst("Nop-ClearOwnRegulator", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "");
+    categorize(InstCategory::NOP);
+    lib.AddInst("Nop-SenseRegulator", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "");
+    categorize(InstCategory::NOP);
+    lib.AddInst("Nop-SenseOwnRegulator", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "");
+    categorize(InstCategory::NOP);
+    lib.AddInst("Nop-IncRegulator", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "");
+    categorize(InstCategory::NOP);
+    lib.AddInst("Nop-IncOwnRegulator", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "");
+    categorize(InstCategory::NOP);
+    lib.AddInst("Nop-DecRegulator", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "");
+    categorize(InstCategory::NOP);
+    lib.AddInst("Nop-DecOwnRegulator", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "");
+    categorize(InstCategory::NOP);
   }
 
   // Add response instructions
-  inst_lib->AddInst(
+  lib.AddInst(
     "ExpressWAIT",
     [](hardware_t & hw, const inst_t & inst) {
       const auto & call_state = hw.GetCurThread().GetExecState().GetTopCallState();
@@ -1476,7 +2118,7 @@ void BoolCalcWorld::InitInstLib() {
     "Express WAIT response."
   );
 
-  inst_lib->AddInst(
+  lib.AddInst(
     "ExpressERROR",
     [](hardware_t & hw, const inst_t & inst) {
       const auto & call_state = hw.GetCurThread().GetExecState().GetTopCallState();
@@ -1497,7 +2139,7 @@ void BoolCalcWorld::InitInstLib() {
   // If output is categorical, create a separate instruction for each output category.
   if (CATEGORICAL_OUTPUT) {
     for (size_t resp : output_categories) {
-      inst_lib->AddInst(
+      lib.AddInst(
         "ExpressResp-" + emp::to_string(resp),
         [resp](hardware_t & hw, const inst_t & inst) {
           auto & call_state = hw.GetCurThread().GetExecState().GetTopCallState();
@@ -1515,7 +2157,7 @@ void BoolCalcWorld::InitInstLib() {
       );
     }
   } else {
-    inst_lib->AddInst(
+    lib.AddInst(
       "ExpressResult",
       [](hardware_t & hw, const inst_t & inst) {
         auto & call_state = hw.GetCurThread().GetExecState().GetTopCallState();
@@ -1538,7 +2180,8 @@ void BoolCalcWorld::InitInstLib() {
   }
 }
 
-void BoolCalcWorld::InitEventLib() {
+template<typename CONFIG_T>
+void BoolCalcWorld<CONFIG_T>::InitEventLib() {
   if (!setup) event_lib = emp::NewPtr<event_lib_t>();
   event_lib->Clear();
   event_id_input_sig = event_lib->AddEvent(
@@ -1553,26 +2196,51 @@ void BoolCalcWorld::InitEventLib() {
         if (thread.GetExecState().call_stack.size()) {
           auto & call_state = thread.GetExecState().GetTopCallState();
           auto & mem_state = call_state.GetMemory();
-          for (auto mem : event.GetData()) { mem_state.SetWorking(mem.first, mem.second); }
+          for (const auto & mem : event.GetData()) { mem_state.SetWorking(mem.first, mem.second); }
         }
       }
     }
   );
 }
 
-void BoolCalcWorld::InitHardware() {
+template<typename CONFIG_T>
+void BoolCalcWorld<CONFIG_T>::InitHardware() {
   // If this is the first time through, create a new virtual hardware object.
   if (!setup) {
     eval_hardware = emp::NewPtr<hardware_t>(*random_ptr, *inst_lib, *event_lib);
+    trace_hardware = emp::NewPtr<hardware_t>(*random_ptr, *trace_inst_lib, *event_lib);
+    // Knockout analysis runs on hardware bound to the matching knockout instruction library.
+    for (auto lib : ko_inst_libs) ko_hardware.emplace_back(emp::NewPtr<hardware_t>(*random_ptr, *lib, *event_lib));
   }
-  // Configure SignalGP CPU
-  eval_hardware->Reset();
-  eval_hardware->SetActiveThreadLimit(MAX_ACTIVE_THREAD_CNT);
-  eval_hardware->SetThreadCapacity(MAX_THREAD_CAPACITY);
-  emp_assert(eval_hardware->ValidateThreadState());
+  // Create one virtual hardware object per evaluation worker (if evaluating in parallel).
+  // Instructions in this world never draw random numbers, but each worker still gets its own random
+  // number generator so that no two threads ever share one.
+  const size_t num_workers = (NUM_EVAL_THREADS > 1) ? NUM_EVAL_THREADS : 0;
+  while (worker_hardware.size() < num_workers) {
+    worker_randoms.emplace_back(emp::NewPtr<emp::Random>(SEED));
+    worker_hardware.emplace_back(emp::NewPtr<hardware_t>(*worker_randoms.back(), *inst_lib, *event_lib));
+  }
+  while (worker_hardware.size() > num_workers) {
+    worker_hardware.back().Delete();
+    worker_hardware.pop_back();
+    worker_randoms.back().Delete();
+    worker_randoms.pop_back();
+  }
+  // Configure SignalGP CPUs
+  auto configure_hardware = [this](hardware_t & hw) {
+    hw.Reset();
+    hw.SetActiveThreadLimit(MAX_ACTIVE_THREAD_CNT);
+    hw.SetThreadCapacity(MAX_THREAD_CAPACITY);
+    emp_assert(hw.ValidateThreadState());
+  };
+  configure_hardware(*eval_hardware);
+  configure_hardware(*trace_hardware);
+  for (auto hw : ko_hardware) configure_hardware(*hw);
+  for (auto hw : worker_hardware) configure_hardware(*hw);
 }
 
-void BoolCalcWorld::InitMutator() {
+template<typename CONFIG_T>
+void BoolCalcWorld<CONFIG_T>::InitMutator() {
   if (!setup) { mutator = emp::NewPtr<mutator_t>(*inst_lib); }
   mutator->ResetLastMutationTracker();
   // Set program constraints
@@ -1580,9 +2248,9 @@ void BoolCalcWorld::InitMutator() {
   mutator->SetProgFunctionInstCntRange(FUNC_LEN_RANGE);
   mutator->SetProgInstArgValueRange(ARG_VAL_RANGE);
   mutator->SetTotalInstLimit(2*FUNC_LEN_RANGE.GetUpper()*FUNC_CNT_RANGE.GetUpper());
-  mutator->SetFuncNumTags(BoolCalcWorldDefs::FUNC_NUM_TAGS);
-  mutator->SetInstNumTags(BoolCalcWorldDefs::INST_TAG_CNT);
-  mutator->SetInstNumArgs(BoolCalcWorldDefs::INST_ARG_CNT);
+  mutator->SetFuncNumTags(defs_t::FUNC_NUM_TAGS);
+  mutator->SetInstNumTags(defs_t::INST_TAG_CNT);
+  mutator->SetInstNumArgs(defs_t::INST_ARG_CNT);
   // Set mutation rates
   mutator->SetRateInstArgSub(MUT_RATE__INST_ARG_SUB);
   mutator->SetRateInstTagBF(MUT_RATE__INST_TAG_BF);
@@ -1598,6 +2266,19 @@ void BoolCalcWorld::InitMutator() {
   mutator->SetRateInstTagSeqRand(MUT_RATE__INST_TAG_SEQ_RAND);
   mutator->SetRateFuncTagSeqRand(MUT_RATE__FUNC_TAG_SEQ_RAND);
 
+  // Configure neutral mutant detection.
+  if (!setup) { reachability = emp::NewPtr<reachability_t>(); }
+  for (size_t inst_id = 0; inst_id < inst_lib->GetSize(); ++inst_id) {
+    const InstCategory category = (inst_id < inst_categories.size()) ? inst_categories[inst_id] : InstCategory::OTHER;
+    switch (category) {
+      case InstCategory::NOP: mutator->AddOperandFreeInst(inst_id); break;
+      case InstCategory::FLOW: reachability->AddFlowInst(inst_id); break;
+      case InstCategory::REGULATOR: reachability->AddRegulatorInst(inst_id); break;
+      case InstCategory::OWN_REGULATOR: reachability->AddOwnRegulatorInst(inst_id); break;
+      case InstCategory::OTHER: break;
+    }
+  }
+
   // Set world mutation function.
   this->SetMutFun([this](org_t & org, emp::Random & rnd) {
     // org.ResetMutations();                // Reset organism's recorded mutations.
@@ -1607,7 +2288,8 @@ void BoolCalcWorld::InitMutator() {
   });
 }
 
-void BoolCalcWorld::InitSelection() {
+template<typename CONFIG_T>
+void BoolCalcWorld<CONFIG_T>::InitSelection() {
 
   // (1) Load training and testing sets
   training_cases = LoadTestCases(TRAINING_SET_FILE);
@@ -1690,7 +2372,7 @@ void BoolCalcWorld::InitSelection() {
   }
 
   // Generate random tags for each input signal
-  constexpr size_t tag_len = BoolCalcWorldDefs::TAG_LEN;
+  constexpr size_t tag_len = defs_t::TAG_LEN;
   test_input_signal_tags = emp::RandomBitSets<tag_len>(*random_ptr, test_input_signals.size(), true);
 
   // Build combined test bank (used for solution screenings)
@@ -1706,6 +2388,11 @@ void BoolCalcWorld::InitSelection() {
   std::cout << "# total cases: " << all_test_cases.size() << std::endl;
   all_test_case_ids.resize(all_test_cases.size());
   std::iota(all_test_case_ids.begin(), all_test_case_ids.end(), 0);
+  // Organize training case signal sequences into a trie (for sharing test prefixes).
+  test_prefixes.Clear();
+  for (const auto & test : training_cases) {
+    test_prefixes.Insert(test.test_signals.begin(), test.test_signals.end(), GetSignalKey);
+  }
 
   // (4) initialize lexicase fitness functions
   //  - Compute number of tests used during evaluation.
@@ -1755,13 +2442,30 @@ void BoolCalcWorld::InitSelection() {
 
   // (5) Wire up selection
   do_selection_sig.AddAction([this]() {
-    emp::LexicaseSelect(*this, lexicase_fit_funs, POP_SIZE);
+    if (LAZY_LEXICASE) {
+      LexicaseSelect_Lazy(
+        *this,
+        num_eval_tests,
+        POP_SIZE,
+        [this](size_t org_id, size_t eval_index) {
+          emp_assert(GetOrg(org_id).GetPhenotype().test_evaluated[eval_index]);
+          return GetOrg(org_id).GetPhenotype().test_scores[eval_index];
+        },
+        [this](const emp::vector<size_t> & org_ids, size_t eval_index) {
+          EvaluateOrgsOnTest_Lazy(org_ids, eval_index);
+        }
+      );
+      FinishEvaluation_Lazy();
+    } else {
+      emp::LexicaseSelect(*this, lexicase_fit_funs, POP_SIZE);
+    }
   });
 
   // TODO - output environment (as part of configuration)
 }
 
-void BoolCalcWorld::InitDataCollection() {
+template<typename CONFIG_T>
+void BoolCalcWorld<CONFIG_T>::InitDataCollection() {
   if (setup) {
     max_fit_file.Delete();
   } else {
@@ -1875,6 +2579,42 @@ void BoolCalcWorld::InitDataCollection() {
     },
     "test_eval_distribution"
   );
+  // -- phenotype cache hits/misses (this generation) --
+  max_fit_file->template AddFun<size_t>(
+    [this]() { return phen_cache.GetHits(); },
+    "phen_cache_hits"
+  );
+  max_fit_file->template AddFun<size_t>(
+    [this]() { return phen_cache.GetMisses(); },
+    "phen_cache_misses"
+  );
+  // -- offspring that inherited parent test scores (this generation) --
+  max_fit_file->template AddFun<size_t>(
+    [this]() { return neutral_offspring_cnt; },
+    "neutral_offspring"
+  );
+  // -- CPU cycles used by evaluation (this generation) --
+  max_fit_file->template AddFun<size_t>(
+    [this]() { return GetCyclesUsed(); },
+    "cpu_cycles_used"
+  );
+  // -- matchbin match counters (this generation; see MATCH_INDEX) --
+  max_fit_file->template AddFun<size_t>(
+    [this]() { return GetMatchBinStats().matches; },
+    "matchbin_matches"
+  );
+  max_fit_file->template AddFun<size_t>(
+    [this]() { return GetMatchBinStats().regulation_purges; },
+    "matchbin_regulation_purges"
+  );
+  max_fit_file->template AddFun<size_t>(
+    [this]() { return GetMatchBinStats().full_recomputes; },
+    "matchbin_full_recomputes"
+  );
+  max_fit_file->template AddFun<size_t>(
+    [this]() { return GetMatchBinStats().incremental_updates; },
+    "matchbin_incremental_updates"
+  );
   // -- num modules --
   max_fit_file->template AddFun<size_t>(
     [this]() {
@@ -1905,26 +2645,29 @@ void BoolCalcWorld::InitDataCollection() {
   max_fit_file->PrintHeaderKeys();
 }
 
-void BoolCalcWorld::InitPop() {
+template<typename CONFIG_T>
+void BoolCalcWorld<CONFIG_T>::InitPop() {
   this->Clear();
   InitPop_Random();
 }
 
-void BoolCalcWorld::InitPop_Random() {
+template<typename CONFIG_T>
+void BoolCalcWorld<CONFIG_T>::InitPop_Random() {
   for (size_t i = 0; i < POP_SIZE; ++i) {
-    this->Inject({sgp::GenRandLinearFunctionsProgram<hardware_t, BoolCalcWorldDefs::TAG_LEN>
+    this->Inject({sgp::GenRandLinearFunctionsProgram<hardware_t, defs_t::TAG_LEN>
                                   (*random_ptr, *inst_lib,
                                    FUNC_CNT_RANGE,
-                                   BoolCalcWorldDefs::FUNC_NUM_TAGS,
+                                   defs_t::FUNC_NUM_TAGS,
                                    FUNC_LEN_RANGE,
-                                   BoolCalcWorldDefs::INST_TAG_CNT,
-                                   BoolCalcWorldDefs::INST_ARG_CNT,
+                                   defs_t::INST_TAG_CNT,
+                                   defs_t::INST_ARG_CNT,
                                    ARG_VAL_RANGE)
                   }, 1);
   }
 }
 
-emp::vector<BoolCalcTestInfo::TestCase> BoolCalcWorld::LoadTestCases(const std::string & path) {
+template<typename CONFIG_T>
+emp::vector<BoolCalcTestInfo::TestCase> BoolCalcWorld<CONFIG_T>::LoadTestCases(const std::string & path) {
   std::ifstream tests_fstream(path);
   if (!tests_fstream.is_open()) {
     std::cout << "Failed to open test case file (" << path << "). Exiting..." << std::endl;
@@ -2013,7 +2756,8 @@ emp::vector<BoolCalcTestInfo::TestCase> BoolCalcWorld::LoadTestCases(const std::
   return testcases;
 }
 
-void BoolCalcWorld::DoPopulationSnapshot() {
+template<typename CONFIG_T>
+void BoolCalcWorld<CONFIG_T>::DoPopulationSnapshot() {
   using pop_t = emp::vector<emp::Ptr<org_t>>;
   const size_t cur_update = GetUpdate();
   emp::ContainerDataFile snapshot_file = emp::MakeContainerDataFile(
@@ -2172,7 +2916,8 @@ void BoolCalcWorld::DoPopulationSnapshot() {
   snapshot_file.Update();
 }
 
-void BoolCalcWorld::DoWorldConfigSnapshot(const config_t & config) {
+template<typename CONFIG_T>
+void BoolCalcWorld<CONFIG_T>::DoWorldConfigSnapshot(const config_t & config) {
   // Print matchbin metric
   std::cout << "Requested MatchBin Metric: " << STRINGVIEWIFY(MATCH_METRIC) << std::endl;
   std::cout << "Requested MatchBin Match Thresh: " << STRINGVIEWIFY(MATCH_THRESH) << std::endl;
@@ -2198,19 +2943,19 @@ void BoolCalcWorld::DoWorldConfigSnapshot(const config_t & config) {
   snapshot_file.Update();
   // TAG_LEN
   get_cur_param = []() { return "TAG_LEN"; };
-  get_cur_value = []() { return emp::to_string(BoolCalcWorldDefs::TAG_LEN); };
+  get_cur_value = []() { return emp::to_string(defs_t::TAG_LEN); };
   snapshot_file.Update();
   // INST_TAG_CNT
   get_cur_param = []() { return "INST_TAG_CNT"; };
-  get_cur_value = []() { return emp::to_string(BoolCalcWorldDefs::INST_TAG_CNT); };
+  get_cur_value = []() { return emp::to_string(defs_t::INST_TAG_CNT); };
   snapshot_file.Update();
   // INST_ARG_CNT
   get_cur_param = []() { return "INST_ARG_CNT"; };
-  get_cur_value = []() { return emp::to_string(BoolCalcWorldDefs::INST_ARG_CNT); };
+  get_cur_value = []() { return emp::to_string(defs_t::INST_ARG_CNT); };
   snapshot_file.Update();
   // FUNC_NUM_TAGS
   get_cur_param = []() { return "FUNC_NUM_TAGS"; };
-  get_cur_value = []() { return emp::to_string(BoolCalcWorldDefs::FUNC_NUM_TAGS); };
+  get_cur_value = []() { return emp::to_string(defs_t::FUNC_NUM_TAGS); };
   snapshot_file.Update();
   // input signals
   get_cur_param = []() { return "input_signals"; };
@@ -2245,7 +2990,8 @@ void BoolCalcWorld::DoWorldConfigSnapshot(const config_t & config) {
   }
 }
 
-void BoolCalcWorld::PrintProgramSingleLine(const program_t & prog, std::ostream & out) {
+template<typename CONFIG_T>
+void BoolCalcWorld<CONFIG_T>::PrintProgramSingleLine(const program_t & prog, std::ostream & out) {
   out << "[";
   for (size_t func_id = 0; func_id < prog.GetSize(); ++func_id) {
     if (func_id) out << ",";
@@ -2254,7 +3000,8 @@ void BoolCalcWorld::PrintProgramSingleLine(const program_t & prog, std::ostream
   out << "]";
 }
 
-void BoolCalcWorld::PrintProgramFunction(const program_function_t & func, std::ostream & out) {
+template<typename CONFIG_T>
+void BoolCalcWorld<CONFIG_T>::PrintProgramFunction(const program_function_t & func, std::ostream & out) {
   out << "{";
   // print function tags
   out << "[";
@@ -2273,7 +3020,8 @@ void BoolCalcWorld::PrintProgramFunction(const program_function_t & func, std::o
   out << "}";
 }
 
-void BoolCalcWorld::PrintProgramInstruction(const inst_t & inst, std::ostream & out) {
+template<typename CONFIG_T>
+void BoolCalcWorld<CONFIG_T>::PrintProgramInstruction(const inst_t & inst, std::ostream & out) {
   out << inst_lib->GetName(inst.GetID()) << "[";
   // print tags
   for (size_t tag_id = 0; tag_id < inst.GetTags().size(); ++tag_id) {
@@ -2289,7 +3037,8 @@ void BoolCalcWorld::PrintProgramInstruction(const inst_t & inst, std::ostream &
   out << ")";
 }
 
-BoolCalcWorld::HardwareStatePrintInfo BoolCalcWorld::GetHardwareStatePrintInfo(hardware_t & hw) {
+template<typename CONFIG_T>
+typename BoolCalcWorld<CONFIG_T>::HardwareStatePrintInfo BoolCalcWorld<CONFIG_T>::GetHardwareStatePrintInfo(hardware_t & hw) {
   HardwareStatePrintInfo print_info;
   // Collect global memory
   std::ostringstream gmem_stream;
@@ -2389,5 +3138,4 @@ BoolCalcWorld::HardwareStatePrintInfo BoolCalcWorld::GetHardwareStatePrintInfo(h
   return print_info;
 }
 
-
-#endif
\ No newline at end of file
+#endif
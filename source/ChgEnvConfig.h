@@ -12,6 +12,7 @@ EMP_BUILD_CONFIG(ChgEnvConfig,
 
   GROUP(EVALUATION_GROUP, "Organism evaluation settings"),
     VALUE(EVAL_TRIAL_CNT, size_t, 3, "How many times should we evaluate individuals (where fitness = min trial performance)?"),
+    VALUE(NUM_TRIAL_THREADS, size_t, 1, "How many worker threads should run an organism's evaluation trials? (1 = run trials serially)"),
 
   GROUP(ENVIRONMENT_GROUP, "Environment settings"),
     VALUE(NUM_ENV_STATES, size_t, 8, "How many responses are there to the environment signal?"),
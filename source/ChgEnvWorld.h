@@ -26,6 +26,8 @@
 #include <sys/stat.h>
 #include <string_view>
 #include <limits>
+#include <algorithm>
+#include <thread>
 // Empirical
 #include "emp/bits/BitSet.hpp"
 #include "emp/matchbin/MatchBin.hpp"
@@ -45,7 +47,19 @@
 #include "ChgEnvConfig.h"
 #include "mutation_utils.h"
 #include "Event.h"
+#include "hardware_run.h"
 #include "matchbin_regulators.h"
+#include "precomputed_matchbin.h"
+#include "simd_streak_metric.h"
+#include "batch_metrics.h"
+#include "indexed_matchbin.h"
+#include "timer_wheel_matchbin.h"
+#include "tag_index.h"
+#include "cached_raw_matchbin.h"
+#include "dirty_reset_matchbin.h"
+#include "inst_dispatch.h"
+#include "knockouts.h"
+#include "inst_observers.h"
 
 /// Globally-scoped, static variables.
 namespace ChgEnvWorldDefs {
@@ -63,9 +77,21 @@ namespace ChgEnvWorldDefs {
   #ifndef MATCH_REG
   #define MATCH_REG add
   #endif
+  #ifndef MATCH_REG_RES
+  #define MATCH_REG_RES 16
+  #endif
   #ifndef MATCH_METRIC
   #define MATCH_METRIC streak
   #endif
+  #ifndef MATCH_INDEX
+  #define MATCH_INDEX emp
+  #endif
+  #ifndef MATCH_DECAY
+  #define MATCH_DECAY step
+  #endif
+  #ifndef MATCH_TAG_INDEX
+  #define MATCH_TAG_INDEX none
+  #endif
   using matchbin_val_t = size_t;  ///< SignalGP function ID type (how are functions identified in the matchbin?)
 
   // What match threshold should we use?
@@ -91,23 +117,26 @@ namespace ChgEnvWorldDefs {
   using matchbin_metric_t =
   #ifdef MATCH_METRIC
     std::conditional<STRINGVIEWIFY(MATCH_METRIC) == "integer",
-      emp::AsymmetricWrapMetric<TAG_LEN>,
+      BatchAsymmetricWrapMetric<TAG_LEN>,
     std::conditional<STRINGVIEWIFY(MATCH_METRIC) == "integer-symmetric",
-      emp::SymmetricWrapMetric<TAG_LEN>,
+      BatchSymmetricWrapMetric<TAG_LEN>,
     std::conditional<STRINGVIEWIFY(MATCH_METRIC) == "hamming",
-      emp::HammingMetric<TAG_LEN>,
+      BatchHammingMetric<TAG_LEN>,
     std::conditional<STRINGVIEWIFY(MATCH_METRIC) == "hash",
       emp::CryptoHashMetric<TAG_LEN>,
     std::conditional<STRINGVIEWIFY(MATCH_METRIC) == "streak",
       emp::StreakMetric<TAG_LEN>,
     std::conditional<STRINGVIEWIFY(MATCH_METRIC) == "streak-exact",
       emp::ExactDualStreakMetric<TAG_LEN>,
+    std::conditional<STRINGVIEWIFY(MATCH_METRIC) == "streak-simd",
+      SimdStreakMetric<TAG_LEN>,
     std::enable_if<false>
     >::type
     >::type
     >::type
     >::type
     >::type
+    >::type
     >::type;
   #endif
 
@@ -120,9 +149,12 @@ namespace ChgEnvWorldDefs {
       emp::MultiplicativeCountdownRegulator<>,
     std::conditional<STRINGVIEWIFY(MATCH_REG) == "exp",
       ExponentialCountdownRegulator<>,
+    std::conditional<STRINGVIEWIFY(MATCH_REG) == "exp-quant",
+      QuantizedExponentialCountdownRegulator<std::ratio<11,10>, 100, MATCH_REG_RES>,
     std::enable_if<false>
     >::type
     >::type
+    >::type
     >::type;
   #endif
 
@@ -133,6 +165,7 @@ namespace ChgEnvWorldDefs {
 struct ChgEnvCustomHardware {
   int response = -1;       ///< Organism-set response to environment signal.
   bool responded = false;  ///< Flag: did organism express a response yet?
+  size_t cycles_used = 0;  ///< CPU cycles run by evaluation (profiling; Reset() leaves it alone).
 
   void Reset() {
     response = -1;
@@ -160,10 +193,44 @@ public:
   using org_t = ChgEnvOrganism<tag_t,inst_arg_t>;
   using phenotype_t = typename org_t::ChgEnvPhenotype;
 
-  using matchbin_t = emp::MatchBin<ChgEnvWorldDefs::matchbin_val_t,
-                                   ChgEnvWorldDefs::matchbin_metric_t,
-                                   ChgEnvWorldDefs::matchbin_selector_t,
-                                   ChgEnvWorldDefs::matchbin_regulator_t>;
+  using matchbin_metric_t = ChgEnvWorldDefs::matchbin_metric_t;
+  // How should the matchbin find regulated matches? (emp: emp::MatchBin, with raw scores kept per program;
+  // counting: emp::MatchBin + match counters; incremental: regulation-aware match index + match counters)
+  using matchbin_index_t =
+    std::conditional<STRINGVIEWIFY(MATCH_INDEX) == "emp",
+      PrecomputedMatchBin<emp::MatchBin<ChgEnvWorldDefs::matchbin_val_t, matchbin_metric_t, ChgEnvWorldDefs::matchbin_selector_t, ChgEnvWorldDefs::matchbin_regulator_t>,
+                          matchbin_metric_t, ChgEnvWorldDefs::matchbin_selector_t>,
+    std::conditional<STRINGVIEWIFY(MATCH_INDEX) == "counting",
+      IndexedMatchBin<ChgEnvWorldDefs::matchbin_val_t, matchbin_metric_t, ChgEnvWorldDefs::matchbin_selector_t, ChgEnvWorldDefs::matchbin_regulator_t, false>,
+    std::conditional<STRINGVIEWIFY(MATCH_INDEX) == "incremental",
+      IndexedMatchBin<ChgEnvWorldDefs::matchbin_val_t, matchbin_metric_t, ChgEnvWorldDefs::matchbin_selector_t, ChgEnvWorldDefs::matchbin_regulator_t, true>,
+    std::enable_if<false>
+    >::type
+    >::type
+    >::type;
+  // How should regulators decay? (step: every regulator on every step; wheel: timer wheel, touching only
+  // regulators whose countdown expires)
+  using matchbin_decay_t =
+    std::conditional<STRINGVIEWIFY(MATCH_DECAY) == "step",
+      matchbin_index_t,
+    std::conditional<STRINGVIEWIFY(MATCH_DECAY) == "wheel",
+      TimerWheelMatchBin<matchbin_index_t>,
+    std::enable_if<false>
+    >::type
+    >::type;
+  // How should top-1 matches be found? (none: matchbin scan; nearest: nearest-tag index, falling back
+  // to the scan whenever the index can't give the exact answer)
+  using matchbin_search_t =
+    std::conditional<STRINGVIEWIFY(MATCH_TAG_INDEX) == "none",
+      matchbin_decay_t,
+    std::conditional<STRINGVIEWIFY(MATCH_TAG_INDEX) == "nearest",
+      TagIndexMatchBin<matchbin_decay_t, typename tag_index_for<matchbin_metric_t>::type, ChgEnvWorldDefs::matchbin_selector_t>,
+    std::enable_if<false>
+    >::type
+    >::type;
+  // Raw matches (regulation instruction targets) are resolved once per program; resets between tests
+  // only undo regulation that happened since the last reset.
+  using matchbin_t = DirtyResetMatchBin<CachedRawMatchBin<matchbin_search_t>>;
   using mem_model_t = sgp::SimpleMemoryModel;
   using hardware_t = sgp::LinearFunctionsProgramSignalGP<mem_model_t,
                                                          tag_t,
@@ -213,11 +280,13 @@ public:
 
 protected:
   // Default group
+  int SEED;
   size_t GENERATIONS;
   size_t POP_SIZE;
   bool STOP_ON_SOLUTION;
   // Evaluation group
   size_t EVAL_TRIAL_CNT;
+  size_t NUM_TRIAL_THREADS;
   // Environment group
   size_t NUM_ENV_STATES;
   size_t NUM_ENV_UPDATES;
@@ -253,13 +322,21 @@ protected:
 
   bool setup = false;               ///< Has this world been setup already?
   emp::Ptr<inst_lib_t> inst_lib;    ///< Manages SignalGP instruction set.
+  emp::vector<emp::Ptr<inst_lib_t>> ko_inst_libs; ///< Instruction set specialized for each analyzed knockout mode (by KnockoutMode; null if not analyzed).
+  emp::Ptr<inst_lib_t> trace_inst_lib;  ///< Instruction set that records executed instructions (into traced_instructions); used for traces.
+  emp::vector<inst_t> traced_instructions;  ///< Instructions executed on trace_hardware (cleared by the trace).
   emp::Ptr<event_lib_t> event_lib;  ///< Manages SignalGP events.
   emp::Ptr<mutator_t> mutator;      ///< Mutates SignalGP programs.
 
   size_t event_id__env_sig; ///< Event library ID for environment signals.
 
   emp::Ptr<hardware_t> eval_hardware;        ///< Used to evaluate programs.
+  emp::vector<emp::Ptr<hardware_t>> ko_hardware;     ///< Used to evaluate programs under each analyzed knockout mode (by KnockoutMode; null if not analyzed).
+  emp::Ptr<hardware_t> trace_hardware;  ///< Used to trace programs (runs trace_inst_lib).
   emp::vector<phenotype_t> trial_phenotypes; ///< Used to track phenotypes across organism evaluation trials.
+  emp::vector<emp::Ptr<hardware_t>> trial_hardware;   ///< One per trial worker (only used when NUM_TRIAL_THREADS > 1).
+  emp::vector<emp::Ptr<emp::Random>> trial_randoms;   ///< Per-worker random number generators (hardware never shares the world's).
+  emp::vector<Environment> trial_environments;        ///< Per-trial environments (only used when NUM_TRIAL_THREADS > 1).
 
   emp::Signal<void(size_t)> after_eval_sig; ///< Triggered after organism (ID given by size_t argument) evaluation
   emp::Signal<void(void)> end_setup_sig;    ///< Triggered at end of world setup.
@@ -271,13 +348,20 @@ protected:
   double MAX_SCORE=0.0;       ///< Maximum possible score.
   bool found_solution=false;  ///< Found an organism that achieves a perfect score *DURING EVALUATION*
 
-  bool KO_REGULATION=false;     ///< Is regulation knocked out right now?
-  bool KO_GLOBAL_MEMORY=false;  ///< Is global memory access knocked out right now?
-
   /// Localize configuration parameters from input config object.
   void InitConfigs(const config_t & config);
-  /// Initialize the instruction library.
+  /// Initialize the instruction library (and one library per analyzed knockout mode).
   void InitInstLib();
+  /// Add default instructions to target_lib, with knockouts KNOCKOUTS_T compiled in (see knockouts.h)
+  /// and observer applied to each instruction (see inst_observers.h).
+  template<typename KNOCKOUTS_T, typename OBSERVER_T=NoInstObserver>
+  void AddInstructions(inst_lib_t & target_lib, const OBSERVER_T & observer=OBSERVER_T());
+  /// Initialize the instruction library for knockout mode MODE.
+  template<KnockoutMode MODE>
+  void AddKnockoutInstructions() {
+    if (!ko_inst_libs[(size_t)MODE]) ko_inst_libs[(size_t)MODE] = emp::NewPtr<inst_lib_t>();
+    AddInstructions<typename knockouts_for<MODE>::type>(*ko_inst_libs[(size_t)MODE]);
+  }
   /// Initialize the event library.
   void InitEventLib();
   /// Initialize the SignalGP virtual hardware used to evaluate programs.
@@ -305,6 +389,12 @@ protected:
 
   /// Evaluate org_t org on changing signal task.
   void EvaluateOrg(org_t & org, bool shuffle_env=true);
+  /// Evaluate org_t org on changing signal task using the given virtual hardware (trials run serially).
+  void EvaluateOrg(hardware_t & hw, org_t & org, bool shuffle_env=true);
+  /// Evaluate org_t org on changing signal task, running trials concurrently.
+  void EvaluateOrg_Parallel(org_t & org, bool shuffle_env=true);
+  /// Run a single evaluation trial on hardware that already has the organism's program loaded.
+  void RunTrial(hardware_t & hw, Environment & env, phenotype_t & trial_phen);
 
   /// Monster function that runs analyses on given organisms.
   /// - e.g., knockout experiments, traces, etc
@@ -329,6 +419,16 @@ protected:
   bool IsSolution(const phenotype_t & phen) const {
     return phen.GetScore() >= MAX_SCORE;
   }
+  /// CPU cycles run by evaluation, summed over all evaluation hardware.
+  size_t GetCyclesUsed() {
+    size_t cycles = eval_hardware->GetCustomComponent().cycles_used;
+    for (auto hw : trial_hardware) cycles += hw->GetCustomComponent().cycles_used;
+    return cycles;
+  }
+  void ResetCyclesUsed() {
+    eval_hardware->GetCustomComponent().cycles_used = 0;
+    for (auto hw : trial_hardware) hw->GetCustomComponent().cycles_used = 0;
+  }
 public:
   ChgEnvWorld() {}
   ChgEnvWorld(emp::Random & r) : emp::World<org_t>(r) {}
@@ -336,8 +436,14 @@ public:
   ~ChgEnvWorld() {
     if (setup) {
       inst_lib.Delete();
+      for (auto lib : ko_inst_libs) { if (lib) lib.Delete(); }
+      trace_inst_lib.Delete();
       event_lib.Delete();
       eval_hardware.Delete();
+      for (auto hw : ko_hardware) { if (hw) hw.Delete(); }
+      trace_hardware.Delete();
+      for (auto hw : trial_hardware) hw.Delete();
+      for (auto rnd : trial_randoms) rnd.Delete();
       mutator.Delete();
       max_fit_file.Delete();
     }
@@ -356,11 +462,13 @@ public:
 // ----- Protected implementation ------
 void ChgEnvWorld::InitConfigs(const config_t & config) {
   // Default group
+  SEED = config.SEED();
   GENERATIONS = config.GENERATIONS();
   POP_SIZE = config.POP_SIZE();
   STOP_ON_SOLUTION = config.STOP_ON_SOLUTION();
   // Evaluation group
   EVAL_TRIAL_CNT = config.EVAL_TRIAL_CNT();
+  NUM_TRIAL_THREADS = config.NUM_TRIAL_THREADS();
   // Environment group
   NUM_ENV_STATES = config.NUM_ENV_STATES();
   NUM_ENV_UPDATES = config.NUM_ENV_UPDATES();
@@ -394,154 +502,169 @@ void ChgEnvWorld::InitConfigs(const config_t & config) {
 }
 
 void ChgEnvWorld::InitInstLib() {
-  if (!setup) inst_lib = emp::NewPtr<inst_lib_t>();
-  inst_lib->Clear(); // Reset the instruction library
+  if (!setup) {
+    inst_lib = emp::NewPtr<inst_lib_t>();
+    trace_inst_lib = emp::NewPtr<inst_lib_t>();
+    ko_inst_libs.resize(NUM_KNOCKOUT_MODES, nullptr);
+  }
+  AddInstructions<NoKnockouts>(*inst_lib);
+  AddInstructions<NoKnockouts>(*trace_inst_lib, InstRecorder<inst_t>(traced_instructions));
+  AddKnockoutInstructions<KnockoutMode::GLOBAL_MEMORY>();
+  AddKnockoutInstructions<KnockoutMode::REGULATION>();
+  AddKnockoutInstructions<KnockoutMode::GLOBAL_MEMORY_AND_REGULATION>();
+}
+
+template<typename KNOCKOUTS_T, typename OBSERVER_T>
+void ChgEnvWorld::AddInstructions(inst_lib_t & target_lib, const OBSERVER_T & observer) {
+  ObservedInstLib<inst_lib_t, inst_prop_t, OBSERVER_T> lib(target_lib, observer);
+  static_assert(!KNOCKOUTS_T::up_regulation && !KNOCKOUTS_T::down_regulation,
+                "ChgEnvWorld only knocks out regulation in both directions.");
+  lib.Clear(); // Reset the instruction library
   /// Add default instructions.
-  inst_lib->AddInst("Nop", [](hardware_t & hw, const inst_t & inst) { ; }, "No operation!");
-  inst_lib->AddInst("Inc", sgp::inst_impl::Inst_Inc<hardware_t, inst_t>, "Increment!");
-  inst_lib->AddInst("Dec", sgp::inst_impl::Inst_Dec<hardware_t, inst_t>, "Decrement!");
-  inst_lib->AddInst("Not", sgp::inst_impl::Inst_Not<hardware_t, inst_t>, "Logical not of ARG[0]");
-  inst_lib->AddInst("Add", sgp::inst_impl::Inst_Add<hardware_t, inst_t>, "");
-  inst_lib->AddInst("Sub", sgp::inst_impl::Inst_Sub<hardware_t, inst_t>, "");
-  inst_lib->AddInst("Mult", sgp::inst_impl::Inst_Mult<hardware_t, inst_t>, "");
-  inst_lib->AddInst("Div", sgp::inst_impl::Inst_Div<hardware_t, inst_t>, "");
-  inst_lib->AddInst("Mod", sgp::inst_impl::Inst_Mod<hardware_t, inst_t>, "");
-  inst_lib->AddInst("TestEqu", sgp::inst_impl::Inst_TestEqu<hardware_t, inst_t>, "");
-  inst_lib->AddInst("TestNEqu", sgp::inst_impl::Inst_TestNEqu<hardware_t, inst_t>, "");
-  inst_lib->AddInst("TestLess", sgp::inst_impl::Inst_TestLess<hardware_t, inst_t>, "");
-  inst_lib->AddInst("TestLessEqu", sgp::inst_impl::Inst_TestLessEqu<hardware_t, inst_t>, "");
-  inst_lib->AddInst("TestGreater", sgp::inst_impl::Inst_TestGreater<hardware_t, inst_t>, "");
-  inst_lib->AddInst("TestGreaterEqu", sgp::inst_impl::Inst_TestGreaterEqu<hardware_t, inst_t>, "");
-  inst_lib->AddInst("SetMem", sgp::inst_impl::Inst_SetMem<hardware_t, inst_t>, "");
-  inst_lib->AddInst("Close", sgp::inst_impl::Inst_Close<hardware_t, inst_t>, "", {inst_prop_t::BLOCK_CLOSE});
-  inst_lib->AddInst("Break", sgp::inst_impl::Inst_Break<hardware_t, inst_t>, "");
-  inst_lib->AddInst("Call", sgp::inst_impl::Inst_Call<hardware_t, inst_t>, "");
-  inst_lib->AddInst("Return", sgp::inst_impl::Inst_Return<hardware_t, inst_t>, "");
-  inst_lib->AddInst("CopyMem", sgp::inst_impl::Inst_CopyMem<hardware_t, inst_t>, "");
-  inst_lib->AddInst("SwapMem", sgp::inst_impl::Inst_SwapMem<hardware_t, inst_t>, "");
-  inst_lib->AddInst("InputToWorking", sgp::inst_impl::Inst_InputToWorking<hardware_t, inst_t>, "");
-  inst_lib->AddInst("WorkingToOutput", sgp::inst_impl::Inst_WorkingToOutput<hardware_t, inst_t>, "");
-  inst_lib->AddInst("Fork", sgp::inst_impl::Inst_Fork<hardware_t, inst_t>, "");
-  inst_lib->AddInst("Terminate", sgp::inst_impl::Inst_Terminate<hardware_t, inst_t>, "");
-  inst_lib->AddInst("If", sgp::lfp_inst_impl::Inst_If<hardware_t, inst_t>, "", {inst_prop_t::BLOCK_DEF});
-  inst_lib->AddInst("While", sgp::lfp_inst_impl::Inst_While<hardware_t, inst_t>, "", {inst_prop_t::BLOCK_DEF});
-  inst_lib->AddInst("Routine", sgp::lfp_inst_impl::Inst_Routine<hardware_t, inst_t>, "");
-  inst_lib->AddInst("Terminal", sgp::inst_impl::Inst_Terminal<hardware_t, inst_t,
-                                                            std::ratio<1>, std::ratio<-1>>, "");
+  lib.AddInst("Nop", [](hardware_t & hw, const inst_t & inst) { ; }, "No operation!");
+  lib.AddInst("Inc", DirectInst<sgp::inst_impl::Inst_Inc<hardware_t, inst_t>>{}, "Increment!");
+  lib.AddInst("Dec", DirectInst<sgp::inst_impl::Inst_Dec<hardware_t, inst_t>>{}, "Decrement!");
+  lib.AddInst("Not", DirectInst<sgp::inst_impl::Inst_Not<hardware_t, inst_t>>{}, "Logical not of ARG[0]");
+  lib.AddInst("Add", DirectInst<sgp::inst_impl::Inst_Add<hardware_t, inst_t>>{}, "");
+  lib.AddInst("Sub", DirectInst<sgp::inst_impl::Inst_Sub<hardware_t, inst_t>>{}, "");
+  lib.AddInst("Mult", DirectInst<sgp::inst_impl::Inst_Mult<hardware_t, inst_t>>{}, "");
+  lib.AddInst("Div", DirectInst<sgp::inst_impl::Inst_Div<hardware_t, inst_t>>{}, "");
+  lib.AddInst("Mod", DirectInst<sgp::inst_impl::Inst_Mod<hardware_t, inst_t>>{}, "");
+  lib.AddInst("TestEqu", DirectInst<sgp::inst_impl::Inst_TestEqu<hardware_t, inst_t>>{}, "");
+  lib.AddInst("TestNEqu", DirectInst<sgp::inst_impl::Inst_TestNEqu<hardware_t, inst_t>>{}, "");
+  lib.AddInst("TestLess", DirectInst<sgp::inst_impl::Inst_TestLess<hardware_t, inst_t>>{}, "");
+  lib.AddInst("TestLessEqu", DirectInst<sgp::inst_impl::Inst_TestLessEqu<hardware_t, inst_t>>{}, "");
+  lib.AddInst("TestGreater", DirectInst<sgp::inst_impl::Inst_TestGreater<hardware_t, inst_t>>{}, "");
+  lib.AddInst("TestGreaterEqu", DirectInst<sgp::inst_impl::Inst_TestGreaterEqu<hardware_t, inst_t>>{}, "");
+  lib.AddInst("SetMem", DirectInst<sgp::inst_impl::Inst_SetMem<hardware_t, inst_t>>{}, "");
+  lib.AddInst("Close", DirectInst<sgp::inst_impl::Inst_Close<hardware_t, inst_t>>{}, "", {inst_prop_t::BLOCK_CLOSE});
+  lib.AddInst("Break", DirectInst<sgp::inst_impl::Inst_Break<hardware_t, inst_t>>{}, "");
+  lib.AddInst("Call", DirectInst<sgp::inst_impl::Inst_Call<hardware_t, inst_t>>{}, "");
+  lib.AddInst("Return", DirectInst<sgp::inst_impl::Inst_Return<hardware_t, inst_t>>{}, "");
+  lib.AddInst("CopyMem", DirectInst<sgp::inst_impl::Inst_CopyMem<hardware_t, inst_t>>{}, "");
+  lib.AddInst("SwapMem", DirectInst<sgp::inst_impl::Inst_SwapMem<hardware_t, inst_t>>{}, "");
+  lib.AddInst("InputToWorking", DirectInst<sgp::inst_impl::Inst_InputToWorking<hardware_t, inst_t>>{}, "");
+  lib.AddInst("WorkingToOutput", DirectInst<sgp::inst_impl::Inst_WorkingToOutput<hardware_t, inst_t>>{}, "");
+  lib.AddInst("Fork", DirectInst<sgp::inst_impl::Inst_Fork<hardware_t, inst_t>>{}, "");
+  lib.AddInst("Terminate", DirectInst<sgp::inst_impl::Inst_Terminate<hardware_t, inst_t>>{}, "");
+  lib.AddInst("If", DirectInst<sgp::lfp_inst_impl::Inst_If<hardware_t, inst_t>>{}, "", {inst_prop_t::BLOCK_DEF});
+  lib.AddInst("While", DirectInst<sgp::lfp_inst_impl::Inst_While<hardware_t, inst_t>>{}, "", {inst_prop_t::BLOCK_DEF});
+  lib.AddInst("Routine", DirectInst<sgp::lfp_inst_impl::Inst_Routine<hardware_t, inst_t>>{}, "");
+  lib.AddInst("Terminal", DirectInst<sgp::inst_impl::Inst_Terminal<hardware_t, inst_t, std::ratio<1>, std::ratio<-1>>>{}, "");
 
   // If we can use global memory, give programs access. Otherwise, nops.
   if (USE_GLOBAL_MEMORY) {
-    inst_lib->AddInst(
+    lib.AddInst(
       "WorkingToGlobal",
-      [this](hardware_t & hw, const inst_t & inst) {
-        if (!KO_GLOBAL_MEMORY) sgp::inst_impl::Inst_WorkingToGlobal<hardware_t, inst_t>(hw, inst);
+      [](hardware_t & hw, const inst_t & inst) {
+        if constexpr (!KNOCKOUTS_T::global_memory) sgp::inst_impl::Inst_WorkingToGlobal<hardware_t, inst_t>(hw, inst);
       },
       "Push working memory to global memory"
     );
-    inst_lib->AddInst(
+    lib.AddInst(
       "GlobalToWorking",
-      [this](hardware_t & hw, const inst_t & inst) {
-        if (!KO_GLOBAL_MEMORY) sgp::inst_impl::Inst_GlobalToWorking<hardware_t, inst_t>(hw, inst);
+      [](hardware_t & hw, const inst_t & inst) {
+        if constexpr (!KNOCKOUTS_T::global_memory) sgp::inst_impl::Inst_GlobalToWorking<hardware_t, inst_t>(hw, inst);
       },
       "Pull global memory into working memory"
     );
 
-    inst_lib->AddInst(
+    lib.AddInst(
       "FullWorkingToGlobal",
-      [this](hardware_t & hw, const inst_t & inst) {
-        if (!KO_GLOBAL_MEMORY) sgp::inst_impl::Inst_FullWorkingToGlobal<hardware_t, inst_t>(hw, inst);
+      [](hardware_t & hw, const inst_t & inst) {
+        if constexpr (!KNOCKOUTS_T::global_memory) sgp::inst_impl::Inst_FullWorkingToGlobal<hardware_t, inst_t>(hw, inst);
       },
       "Push all working memory to global memory"
     );
-    inst_lib->AddInst(
+    lib.AddInst(
       "FullGlobalToWorking",
-      [this](hardware_t & hw, const inst_t & inst) {
-        if (!KO_GLOBAL_MEMORY) sgp::inst_impl::Inst_FullGlobalToWorking<hardware_t, inst_t>(hw, inst);
+      [](hardware_t & hw, const inst_t & inst) {
+        if constexpr (!KNOCKOUTS_T::global_memory) sgp::inst_impl::Inst_FullGlobalToWorking<hardware_t, inst_t>(hw, inst);
       },
       "Pull all global memory into working memory"
     );
   } else {
-    inst_lib->AddInst("Nop-WorkingToGlobal", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "Nop");
-    inst_lib->AddInst("Nop-GlobalToWorking", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "Nop");
-    inst_lib->AddInst("Nop-FullWorkingToGlobal", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "Nop");
-    inst_lib->AddInst("Nop-FullGlobalToWorking", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "Nop");
+    lib.AddInst("Nop-WorkingToGlobal", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "Nop");
+    lib.AddInst("Nop-GlobalToWorking", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "Nop");
+    lib.AddInst("Nop-FullWorkingToGlobal", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "Nop");
+    lib.AddInst("Nop-FullGlobalToWorking", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "Nop");
   }
 
   // If we can use regulation, add regulation instructions; otherwise, add an equivalent number of
   // no-operation instructions.
   if (USE_FUNC_REGULATION) {
-    inst_lib->AddInst("SetRegulator", [this](hardware_t & hw, const inst_t & inst) {
-      if (!KO_REGULATION) sgp::inst_impl::Inst_SetRegulator<hardware_t, inst_t>(hw, inst);
+    lib.AddInst("SetRegulator", [](hardware_t & hw, const inst_t & inst) {
+      if constexpr (!KNOCKOUTS_T::regulation) sgp::inst_impl::Inst_SetRegulator<hardware_t, inst_t>(hw, inst);
     }, "");
-    inst_lib->AddInst("SetOwnRegulator", [this](hardware_t & hw, const inst_t & inst) {
-      if (!KO_REGULATION) sgp::inst_impl::Inst_SetOwnRegulator<hardware_t, inst_t>(hw, inst);
+    lib.AddInst("SetOwnRegulator", [](hardware_t & hw, const inst_t & inst) {
+      if constexpr (!KNOCKOUTS_T::regulation) sgp::inst_impl::Inst_SetOwnRegulator<hardware_t, inst_t>(hw, inst);
     }, "");
-    inst_lib->AddInst("AdjRegulator", [this](hardware_t & hw, const inst_t & inst) {
-      if (!KO_REGULATION) sgp::inst_impl::Inst_AdjRegulator<hardware_t, inst_t>(hw, inst);
+    lib.AddInst("AdjRegulator", [](hardware_t & hw, const inst_t & inst) {
+      if constexpr (!KNOCKOUTS_T::regulation) sgp::inst_impl::Inst_AdjRegulator<hardware_t, inst_t>(hw, inst);
     }, "");
-    inst_lib->AddInst("AdjOwnRegulator", [this](hardware_t & hw, const inst_t & inst) {
-      if (!KO_REGULATION) sgp::inst_impl::Inst_AdjOwnRegulator<hardware_t, inst_t>(hw, inst);
+    lib.AddInst("AdjOwnRegulator", [](hardware_t & hw, const inst_t & inst) {
+      if constexpr (!KNOCKOUTS_T::regulation) sgp::inst_impl::Inst_AdjOwnRegulator<hardware_t, inst_t>(hw, inst);
     }, "");
 
-    inst_lib->AddInst("SetRegulator-", [this](hardware_t & hw, const inst_t & inst) {
-      if (!KO_REGULATION) sgp::inst_impl::Inst_SetRegulator<hardware_t, inst_t, -1>(hw, inst);
+    lib.AddInst("SetRegulator-", [](hardware_t & hw, const inst_t & inst) {
+      if constexpr (!KNOCKOUTS_T::regulation) sgp::inst_impl::Inst_SetRegulator<hardware_t, inst_t, -1>(hw, inst);
     }, "");
-    inst_lib->AddInst("SetOwnRegulator-", [this](hardware_t & hw, const inst_t & inst) {
-      if (!KO_REGULATION) sgp::inst_impl::Inst_SetOwnRegulator<hardware_t, inst_t, -1>(hw, inst);
+    lib.AddInst("SetOwnRegulator-", [](hardware_t & hw, const inst_t & inst) {
+      if constexpr (!KNOCKOUTS_T::regulation) sgp::inst_impl::Inst_SetOwnRegulator<hardware_t, inst_t, -1>(hw, inst);
     }, "");
-    inst_lib->AddInst("AdjRegulator-", [this](hardware_t & hw, const inst_t & inst) {
-      if (!KO_REGULATION) sgp::inst_impl::Inst_AdjRegulator<hardware_t, inst_t, -1>(hw, inst);
+    lib.AddInst("AdjRegulator-", [](hardware_t & hw, const inst_t & inst) {
+      if constexpr (!KNOCKOUTS_T::regulation) sgp::inst_impl::Inst_AdjRegulator<hardware_t, inst_t, -1>(hw, inst);
     }, "");
-    inst_lib->AddInst("AdjOwnRegulator-", [this](hardware_t & hw, const inst_t & inst) {
-      if (!KO_REGULATION) sgp::inst_impl::Inst_AdjOwnRegulator<hardware_t, inst_t, -1>(hw, inst);
+    lib.AddInst("AdjOwnRegulator-", [](hardware_t & hw, const inst_t & inst) {
+      if constexpr (!KNOCKOUTS_T::regulation) sgp::inst_impl::Inst_AdjOwnRegulator<hardware_t, inst_t, -1>(hw, inst);
     }, "");
 
-    inst_lib->AddInst("SenseRegulator", [this](hardware_t & hw, const inst_t & inst) {
-      if (!KO_REGULATION) sgp::inst_impl::Inst_SenseRegulator<hardware_t, inst_t>(hw, inst);
+    lib.AddInst("SenseRegulator", [](hardware_t & hw, const inst_t & inst) {
+      if constexpr (!KNOCKOUTS_T::regulation) sgp::inst_impl::Inst_SenseRegulator<hardware_t, inst_t>(hw, inst);
     }, "");
-    inst_lib->AddInst("SenseOwnRegulator", [this](hardware_t & hw, const inst_t & inst) {
-      if (!KO_REGULATION) sgp::inst_impl::Inst_SenseOwnRegulator<hardware_t, inst_t>(hw, inst);
+    lib.AddInst("SenseOwnRegulator", [](hardware_t & hw, const inst_t & inst) {
+      if constexpr (!KNOCKOUTS_T::regulation) sgp::inst_impl::Inst_SenseOwnRegulator<hardware_t, inst_t>(hw, inst);
     }, "");
-    inst_lib->AddInst("IncRegulator", [this](hardware_t & hw, const inst_t & inst) {
-      if (!KO_REGULATION) sgp::inst_impl::Inst_IncRegulator<hardware_t, inst_t>(hw, inst);
+    lib.AddInst("IncRegulator", [](hardware_t & hw, const inst_t & inst) {
+      if constexpr (!KNOCKOUTS_T::regulation) sgp::inst_impl::Inst_IncRegulator<hardware_t, inst_t>(hw, inst);
     }, "");
-    inst_lib->AddInst("IncOwnRegulator", [this](hardware_t & hw, const inst_t & inst) {
-      if (!KO_REGULATION) sgp::inst_impl::Inst_IncOwnRegulator<hardware_t, inst_t>(hw, inst);
+    lib.AddInst("IncOwnRegulator", [](hardware_t & hw, const inst_t & inst) {
+      if constexpr (!KNOCKOUTS_T::regulation) sgp::inst_impl::Inst_IncOwnRegulator<hardware_t, inst_t>(hw, inst);
      }, "");
-    inst_lib->AddInst("DecRegulator", [this](hardware_t & hw, const inst_t & inst) {
-      if (!KO_REGULATION) sgp::inst_impl::Inst_DecRegulator<hardware_t, inst_t>(hw, inst);
+    lib.AddInst("DecRegulator", [](hardware_t & hw, const inst_t & inst) {
+      if constexpr (!KNOCKOUTS_T::regulation) sgp::inst_impl::Inst_DecRegulator<hardware_t, inst_t>(hw, inst);
     }, "");
-    inst_lib->AddInst("DecOwnRegulator", [this](hardware_t & hw, const inst_t & inst) {
-      if (!KO_REGULATION) sgp::inst_impl::Inst_DecOwnRegulator<hardware_t, inst_t>(hw, inst);
+    lib.AddInst("DecOwnRegulator", [](hardware_t & hw, const inst_t & inst) {
+      if constexpr (!KNOCKOUTS_T::regulation) sgp::inst_impl::Inst_DecOwnRegulator<hardware_t, inst_t>(hw, inst);
     }, "");
-    inst_lib->AddInst("ClearRegulator", [this](hardware_t & hw, const inst_t & inst) {
-      if (!KO_REGULATION) sgp::inst_impl::Inst_ClearRegulator<hardware_t, inst_t>(hw, inst);
+    lib.AddInst("ClearRegulator", [](hardware_t & hw, const inst_t & inst) {
+      if constexpr (!KNOCKOUTS_T::regulation) sgp::inst_impl::Inst_ClearRegulator<hardware_t, inst_t>(hw, inst);
     }, "");
-    inst_lib->AddInst("ClearOwnRegulator", [this](hardware_t & hw, const inst_t & inst) {
-      if (!KO_REGULATION) sgp::inst_impl::Inst_ClearOwnRegulator<hardware_t, inst_t>(hw, inst);
+    lib.AddInst("ClearOwnRegulator", [](hardware_t & hw, const inst_t & inst) {
+      if constexpr (!KNOCKOUTS_T::regulation) sgp::inst_impl::Inst_ClearOwnRegulator<hardware_t, inst_t>(hw, inst);
     }, "");
   } else {
-    inst_lib->AddInst("Nop-SetRegulator", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "");
-    inst_lib->AddInst("Nop-SetOwnRegulator", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "");
-    inst_lib->AddInst("Nop-AdjRegulator", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "");
-    inst_lib->AddInst("Nop-AdjOwnRegulator", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "");
-    inst_lib->AddInst("Nop-SetRegulator-", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "");
-    inst_lib->AddInst("Nop-SetOwnRegulator-", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "");
-    inst_lib->AddInst("Nop-AdjRegulator-", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "");
-    inst_lib->AddInst("Nop-AdjOwnRegulator-", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "");
-    inst_lib->AddInst("Nop-ClearRegulator", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "");
-    inst_lib->AddInst("Nop-ClearOwnRegulator", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "");
-    inst_lib->AddInst("Nop-SenseRegulator", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "");
-    inst_lib->AddInst("Nop-SenseOwnRegulator", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "");
-    inst_lib->AddInst("Nop-IncRegulator", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "");
-    inst_lib->AddInst("Nop-IncOwnRegulator", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "");
-    inst_lib->AddInst("Nop-DecRegulator", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "");
-    inst_lib->AddInst("Nop-DecOwnRegulator", sgp::inst_impl::Inst_Nop<hardware_t, inst_t>, "");
+    lib.AddInst("Nop-SetRegulator", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "");
+    lib.AddInst("Nop-SetOwnRegulator", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "");
+    lib.AddInst("Nop-AdjRegulator", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "");
+    lib.AddInst("Nop-AdjOwnRegulator", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "");
+    lib.AddInst("Nop-SetRegulator-", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "");
+    lib.AddInst("Nop-SetOwnRegulator-", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "");
+    lib.AddInst("Nop-AdjRegulator-", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "");
+    lib.AddInst("Nop-AdjOwnRegulator-", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "");
+    lib.AddInst("Nop-ClearRegulator", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "");
+    lib.AddInst("Nop-ClearOwnRegulator", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "");
+    lib.AddInst("Nop-SenseRegulator", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "");
+    lib.AddInst("Nop-SenseOwnRegulator", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "");
+    lib.AddInst("Nop-IncRegulator", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "");
+    lib.AddInst("Nop-IncOwnRegulator", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "");
+    lib.AddInst("Nop-DecRegulator", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "");
+    lib.AddInst("Nop-DecOwnRegulator", DirectInst<sgp::inst_impl::Inst_Nop<hardware_t, inst_t>>{}, "");
   }
 
   // Add response instructions
   for (size_t i = 0; i < NUM_ENV_STATES; ++i) {
-    inst_lib->AddInst("Response-" + emp::to_string(i), [this, i](hardware_t & hw, const inst_t & inst) {
+    lib.AddInst("Response-" + emp::to_string(i), [this, i](hardware_t & hw, const inst_t & inst) {
       // Mark response in hardware.
       hw.GetCustomComponent().SetResponse(i);
       // Remove all pending threads.
@@ -562,7 +685,9 @@ void ChgEnvWorld::InitEventLib() {
   event_id__env_sig = event_lib->AddEvent("EnvironmentSignal",
                                           [this](hardware_t & hw, const base_event_t & e) {
                                             const event_t & event = static_cast<const event_t&>(e);
-                                            emp_assert(eval_environment.GetCurEnvTag() == event.GetTag());
+                                            emp_assert(std::find(eval_environment.env_state_tags.begin(),
+                                                                 eval_environment.env_state_tags.end(),
+                                                                 event.GetTag()) != eval_environment.env_state_tags.end());
                                             hw.SpawnThreadWithTag(event.GetTag());
                                           });
 }
@@ -571,12 +696,36 @@ void ChgEnvWorld::InitHardware() {
   // If being configured for the first time, create a new hardware object.
   if (!setup) {
     eval_hardware = emp::NewPtr<hardware_t>(*random_ptr, *inst_lib, *event_lib);
+    trace_hardware = emp::NewPtr<hardware_t>(*random_ptr, *trace_inst_lib, *event_lib);
+    // Knockout analysis runs on hardware bound to the matching knockout instruction library.
+    ko_hardware.resize(NUM_KNOCKOUT_MODES, nullptr);
+    for (size_t mode = 0; mode < NUM_KNOCKOUT_MODES; ++mode) {
+      if (ko_inst_libs[mode]) ko_hardware[mode] = emp::NewPtr<hardware_t>(*random_ptr, *ko_inst_libs[mode], *event_lib);
+    }
+  }
+  // Create one hardware object per trial worker (if running trials in parallel).
+  const size_t num_workers = (NUM_TRIAL_THREADS > 1) ? NUM_TRIAL_THREADS : 0;
+  while (trial_hardware.size() < num_workers) {
+    trial_randoms.emplace_back(emp::NewPtr<emp::Random>(SEED));
+    trial_hardware.emplace_back(emp::NewPtr<hardware_t>(*trial_randoms.back(), *inst_lib, *event_lib));
+  }
+  while (trial_hardware.size() > num_workers) {
+    trial_hardware.back().Delete();
+    trial_hardware.pop_back();
+    trial_randoms.back().Delete();
+    trial_randoms.pop_back();
   }
-  // Configure SignalGP CPU
-  eval_hardware->Reset();
-  eval_hardware->SetActiveThreadLimit(MAX_ACTIVE_THREAD_CNT);
-  eval_hardware->SetThreadCapacity(MAX_THREAD_CAPACITY);
-  emp_assert(eval_hardware->ValidateThreadState());
+  // Configure SignalGP CPUs
+  auto configure_hardware = [this](hardware_t & hw) {
+    hw.Reset();
+    hw.SetActiveThreadLimit(MAX_ACTIVE_THREAD_CNT);
+    hw.SetThreadCapacity(MAX_THREAD_CAPACITY);
+    emp_assert(hw.ValidateThreadState());
+  };
+  configure_hardware(*eval_hardware);
+  configure_hardware(*trace_hardware);
+  for (auto hw : ko_hardware) { if (hw) configure_hardware(*hw); }
+  for (auto hw : trial_hardware) configure_hardware(*hw);
 }
 
 void ChgEnvWorld::InitEnvironment() {
@@ -595,6 +744,8 @@ void ChgEnvWorld::InitEnvironment() {
   for (phenotype_t & phen : trial_phenotypes) {
     phen.Reset();
   }
+  trial_environments.clear();
+  if (NUM_TRIAL_THREADS > 1) trial_environments.resize(EVAL_TRIAL_CNT, eval_environment);
 }
 
 void ChgEnvWorld::InitMutator() {
@@ -827,6 +978,7 @@ void ChgEnvWorld::InitDataCollection() {
   max_fit_file->template AddFun<size_t>([this]() {
     return this->GetOrg(max_fit_org_id).GetGenome().GetProgram().GetInstCount();
   }, "num_instructions");
+  max_fit_file->template AddFun<size_t>([this]() { return GetCyclesUsed(); }, "cpu_cycles_used");
   max_fit_file->template AddFun<std::string>([this]() {
     std::ostringstream stream;
     stream << "\"";
@@ -942,51 +1094,31 @@ void ChgEnvWorld::DoPopulationSnapshot() {
 }
 
 void ChgEnvWorld::EvaluateOrg(org_t & org, bool shuffle_env/*=true*/) {
+  // Should we fan this organism's trials out across worker threads?
+  if (NUM_TRIAL_THREADS > 1 && EVAL_TRIAL_CNT > 1) {
+    EvaluateOrg_Parallel(org, shuffle_env);
+  } else {
+    EvaluateOrg(*eval_hardware, org, shuffle_env);
+  }
+}
+
+void ChgEnvWorld::EvaluateOrg(hardware_t & hw, org_t & org, bool shuffle_env/*=true*/) {
   // Evaluate org NUM_TRIALS times, keep worst phenotype.
   // Reset organism phenotype.
   org.GetPhenotype().Reset();
   // Ready the hardware!
-  eval_hardware->SetProgram(org.GetGenome().program);
+  hw.SetProgram(org.GetGenome().program);
+  hw.GetMatchBin().LoadProgram(hw.GetProgram());
   size_t min_trial_id = 0;
   for (size_t trial_id = 0; trial_id < EVAL_TRIAL_CNT; ++trial_id) {
     emp_assert(trial_id < trial_phenotypes.size());
-    // Reset trial phenotype
-    phenotype_t & trial_phen = trial_phenotypes[trial_id];
-    trial_phen.Reset();
     // reset the environment
     eval_environment.ResetEnv();
     // shuffle environment schedule for this trial
     if (shuffle_env) { emp::Shuffle(*random_ptr, eval_environment.env_schedule); }
-    // reset hardware matchbin between trials
-    eval_hardware->ResetMatchBin();
-    eval_hardware->ResetHardwareState();
     // Evaluate the organism in the environment.
-    for (size_t env_update = 0; env_update < NUM_ENV_UPDATES; ++env_update) {
-      // Reset the hardware!
-      eval_hardware->ResetBaseHardwareState();
-      eval_hardware->GetCustomComponent().Reset();
-      emp_assert(eval_hardware->ValidateThreadState());
-      emp_assert(eval_hardware->GetActiveThreadIDs().size() == 0);
-      emp_assert(eval_hardware->GetNumQueuedEvents() == 0);
-      // Select a random environment.
-      emp_assert(env_update % NUM_ENV_STATES < eval_environment.env_schedule.size());
-      emp_assert(eval_environment.env_schedule[env_update % NUM_ENV_STATES] < eval_environment.env_state_tags.size());
-      eval_environment.cur_state = eval_environment.env_schedule[env_update % NUM_ENV_STATES]; //random_ptr->GetUInt(0, NUM_ENV_STATES);
-      eval_hardware->QueueEvent(event_t(event_id__env_sig, eval_environment.GetCurEnvTag()));
-      // Step the hardware! If at any point, there are not active || pending threads, we're done!
-      for (size_t step = 0; step < CPU_CYCLES_PER_ENV_UPDATE; ++step) {
-        eval_hardware->SingleProcess();
-        if (!( eval_hardware->GetNumActiveThreads() || eval_hardware->GetNumPendingThreads() )) break;
-      }
-      // Did the hardware match, miss, or not respond to environment signal?
-      if (eval_hardware->GetCustomComponent().HasResponse()) {
-        trial_phen.env_matches += (size_t)(eval_hardware->GetCustomComponent().GetResponse() == (int)eval_environment.cur_state);
-        trial_phen.env_misses += (size_t)(eval_hardware->GetCustomComponent().GetResponse() != (int)eval_environment.cur_state);
-      } else {
-        trial_phen.no_responses += 1;
-      }
-    }
-    trial_phen.score = (double)trial_phen.env_matches; // Score = number of times organism matched environment.
+    phenotype_t & trial_phen = trial_phenotypes[trial_id];
+    RunTrial(hw, eval_environment, trial_phen);
     if (trial_phen.GetScore() < trial_phenotypes[min_trial_id].GetScore()) {
       min_trial_id = trial_id;
     }
@@ -998,6 +1130,85 @@ void ChgEnvWorld::EvaluateOrg(org_t & org, bool shuffle_env/*=true*/) {
   org.GetPhenotype().score = trial_phenotypes[min_trial_id].score;
 }
 
+/// Same as EvaluateOrg, but trials run concurrently (each worker with its own hardware).
+/// Environment schedules are drawn up front, in trial order, from the world's random number
+/// generator. Each trial therefore sees exactly the schedule it would have seen in serial mode,
+/// and the world's random number stream is consumed identically.
+void ChgEnvWorld::EvaluateOrg_Parallel(org_t & org, bool shuffle_env/*=true*/) {
+  emp_assert(trial_hardware.size() == NUM_TRIAL_THREADS);
+  emp_assert(trial_environments.size() == EVAL_TRIAL_CNT);
+  emp_assert(trial_phenotypes.size() == EVAL_TRIAL_CNT);
+  org.GetPhenotype().Reset();
+  // Draw each trial's environment schedule.
+  for (size_t trial_id = 0; trial_id < EVAL_TRIAL_CNT; ++trial_id) {
+    Environment & env = trial_environments[trial_id];
+    env.env_schedule = (trial_id) ? trial_environments[trial_id-1].env_schedule : eval_environment.env_schedule;
+    env.ResetEnv();
+    if (shuffle_env) { emp::Shuffle(*random_ptr, env.env_schedule); }
+  }
+  // Carry the last schedule forward (as serial evaluation would).
+  eval_environment.env_schedule = trial_environments.back().env_schedule;
+  // Run trials. Worker i runs trials i, i+NUM_TRIAL_THREADS, i+2*NUM_TRIAL_THREADS, etc.
+  auto run_trials = [this, &org](size_t worker_id) {
+    hardware_t & hw = *trial_hardware[worker_id];
+    hw.SetProgram(org.GetGenome().program);
+    hw.GetMatchBin().LoadProgram(hw.GetProgram());
+    for (size_t trial_id = worker_id; trial_id < EVAL_TRIAL_CNT; trial_id += NUM_TRIAL_THREADS) {
+      RunTrial(hw, trial_environments[trial_id], trial_phenotypes[trial_id]);
+    }
+  };
+  const size_t num_workers = std::min(NUM_TRIAL_THREADS, EVAL_TRIAL_CNT);
+  emp::vector<std::thread> workers;
+  for (size_t worker_id = 1; worker_id < num_workers; ++worker_id) {
+    workers.emplace_back(run_trials, worker_id);
+  }
+  run_trials(0);
+  for (auto & worker : workers) worker.join();
+  // Organism phenotype = min trial phenotype (first minimum wins, as in serial mode)
+  size_t min_trial_id = 0;
+  for (size_t trial_id = 1; trial_id < EVAL_TRIAL_CNT; ++trial_id) {
+    if (trial_phenotypes[trial_id].GetScore() < trial_phenotypes[min_trial_id].GetScore()) {
+      min_trial_id = trial_id;
+    }
+  }
+  org.GetPhenotype().env_matches = trial_phenotypes[min_trial_id].env_matches;
+  org.GetPhenotype().env_misses = trial_phenotypes[min_trial_id].env_misses;
+  org.GetPhenotype().no_responses = trial_phenotypes[min_trial_id].no_responses;
+  org.GetPhenotype().score = trial_phenotypes[min_trial_id].score;
+}
+
+void ChgEnvWorld::RunTrial(hardware_t & hw, Environment & env, phenotype_t & trial_phen) {
+  // Reset trial phenotype
+  trial_phen.Reset();
+  // reset hardware matchbin between trials
+  hw.ResetMatchBin();
+  hw.ResetHardwareState();
+  // Evaluate the organism in the environment.
+  for (size_t env_update = 0; env_update < NUM_ENV_UPDATES; ++env_update) {
+    // Reset the hardware!
+    hw.ResetBaseHardwareState();
+    hw.GetCustomComponent().Reset();
+    emp_assert(hw.ValidateThreadState());
+    emp_assert(hw.GetActiveThreadIDs().size() == 0);
+    emp_assert(hw.GetNumQueuedEvents() == 0);
+    // Select a random environment.
+    emp_assert(env_update % NUM_ENV_STATES < env.env_schedule.size());
+    emp_assert(env.env_schedule[env_update % NUM_ENV_STATES] < env.env_state_tags.size());
+    env.cur_state = env.env_schedule[env_update % NUM_ENV_STATES]; //random_ptr->GetUInt(0, NUM_ENV_STATES);
+    hw.QueueEvent(event_t(event_id__env_sig, env.GetCurEnvTag()));
+    // Step the hardware! If at any point, there are not active || pending threads, we're done!
+    hw.GetCustomComponent().cycles_used += RunUntilQuiescent(hw, CPU_CYCLES_PER_ENV_UPDATE);
+    // Did the hardware match, miss, or not respond to environment signal?
+    if (hw.GetCustomComponent().HasResponse()) {
+      trial_phen.env_matches += (size_t)(hw.GetCustomComponent().GetResponse() == (int)env.cur_state);
+      trial_phen.env_misses += (size_t)(hw.GetCustomComponent().GetResponse() != (int)env.cur_state);
+    } else {
+      trial_phen.no_responses += 1;
+    }
+  }
+  trial_phen.score = (double)trial_phen.env_matches; // Score = number of times organism matched environment.
+}
+
 /// Analyze organism
 void ChgEnvWorld::AnalyzeOrg(const org_t & org, size_t org_id/*=0*/) {
 
@@ -1061,24 +1272,15 @@ void ChgEnvWorld::AnalyzeOrg(const org_t & org, size_t org_id/*=0*/) {
     emp::Shuffle(*random_ptr, eval_environment.env_schedule);
     // Evaluate org normally.
     EvaluateOrg(test_org, false);
-    KO_GLOBAL_MEMORY = true;
-    KO_REGULATION = false;
-    EvaluateOrg(ko_mem_org, false);
+    // Evaluate org with knockouts (each on hardware running the matching knockout instruction library).
+    //     - ko memory
+    EvaluateOrg(*ko_hardware[(size_t)KnockoutMode::GLOBAL_MEMORY], ko_mem_org, false);
     //     - ko regulation
-    KO_GLOBAL_MEMORY = false;
-    KO_REGULATION = true;
-    EvaluateOrg(ko_reg_org, false);
+    EvaluateOrg(*ko_hardware[(size_t)KnockoutMode::REGULATION], ko_reg_org, false);
     //     - ko memory & ko regulation
-    KO_GLOBAL_MEMORY = true;
-    KO_REGULATION = true;
-    EvaluateOrg(ko_all_org, false);
-    // Reset KO variables to both be false
-    KO_GLOBAL_MEMORY = false;
-    KO_REGULATION = false;
+    EvaluateOrg(*ko_hardware[(size_t)KnockoutMode::GLOBAL_MEMORY_AND_REGULATION], ko_all_org, false);
     analysis_file.Update();
   }
-  KO_GLOBAL_MEMORY = false;
-  KO_REGULATION = false;
   EVAL_TRIAL_CNT = orig_eval_trial_cnt;
   ////////////////////////////////////////////////
   // (2) Run a full trace of this organism.
@@ -1095,13 +1297,8 @@ void ChgEnvWorld::TraceOrganism(const org_t & org, size_t org_id/*=0*/) {
   HardwareStatePrintInfo hw_state_info;
   size_t env_update=0;
   size_t cpu_step=0;
-  emp::vector<inst_t> executed_instructions;
-
-  inst_lib->OnBeforeInstExec(
-    [&executed_instructions](hardware_t & hw, const inst_t & inst) {
-      executed_instructions.emplace_back(inst);
-    }
-  );
+  // trace_hardware runs the tracing instruction library, which records executed instructions.
+  traced_instructions.clear();
 
   // ----- Timing information -----
   trace_file.template AddFun<size_t>([&env_update]() {
@@ -1128,11 +1325,11 @@ void ChgEnvWorld::TraceOrganism(const org_t & org, size_t org_id/*=0*/) {
   // ----- Hardware Information -----
   //    * current response
   trace_file.template AddFun<int>([this]() {
-    return eval_hardware->GetCustomComponent().GetResponse();
+    return trace_hardware->GetCustomComponent().GetResponse();
   }, "cur_response");
   //    * correct responses
   trace_file.template AddFun<bool>([&trace_org, this]() {
-    return eval_hardware->GetCustomComponent().response == (int)eval_environment.cur_state;
+    return trace_hardware->GetCustomComponent().response == (int)eval_environment.cur_state;
   }, "has_correct_response");
   //    * num_modules
   trace_file.template AddFun<size_t>([&hw_state_info]() {
@@ -1151,14 +1348,14 @@ void ChgEnvWorld::TraceOrganism(const org_t & org, size_t org_id/*=0*/) {
   }, "module_regulator_states");
   //    * which module would be triggered by the environment signal?
   trace_file.template AddFun<int>([this]() {
-    const auto matches = eval_hardware->GetMatchBin().Match(eval_environment.env_state_tags[eval_environment.cur_state]);
+    const auto matches = trace_hardware->GetMatchBin().Match(eval_environment.env_state_tags[eval_environment.cur_state]);
     if (matches.size()) return (int)matches[0];
     else return -1;
   }, "env_signal_closest_match");
   //    * match scores against environment signal tag for each module
   trace_file.template AddFun<std::string>([this]() {
-    const auto match_scores = eval_hardware->GetMatchBin().ComputeMatchScores(eval_environment.env_state_tags[eval_environment.cur_state]);
-    emp::vector<double> scores(eval_hardware->GetNumModules());
+    const auto match_scores = trace_hardware->GetMatchBin().ComputeMatchScores(eval_environment.env_state_tags[eval_environment.cur_state]);
+    emp::vector<double> scores(trace_hardware->GetNumModules());
     std::ostringstream stream;
     for (const auto & pair : match_scores) {
       const size_t module_id = pair.first;
@@ -1194,15 +1391,15 @@ void ChgEnvWorld::TraceOrganism(const org_t & org, size_t org_id/*=0*/) {
   }, "num_active_threads");
 
   trace_file.template AddFun<std::string>(
-    [&executed_instructions, this]() {
+    [this]() {
       std::ostringstream stream;
       stream << "\"[";
-      for (size_t i = 0; i < executed_instructions.size(); ++i) {
+      for (size_t i = 0; i < traced_instructions.size(); ++i) {
         if (i) stream << ",";
-        stream << inst_lib->GetName(executed_instructions[i].GetID());
+        stream << inst_lib->GetName(traced_instructions[i].GetID());
       }
       stream << "]\"";
-      executed_instructions.clear();
+      traced_instructions.clear();
       return stream.str();
     },
     "executed_instructions"
@@ -1217,7 +1414,7 @@ void ChgEnvWorld::TraceOrganism(const org_t & org, size_t org_id/*=0*/) {
   // ---- Do an traced-evaluation ----
   trace_org.GetPhenotype().Reset();
   // Ready the hardware!
-  eval_hardware->SetProgram(trace_org.GetGenome().program);
+  trace_hardware->SetProgram(trace_org.GetGenome().program);
   // Reset trial phenotype
   phenotype_t trace_phen = trace_org.GetPhenotype();
   trace_phen.Reset();
@@ -1226,46 +1423,45 @@ void ChgEnvWorld::TraceOrganism(const org_t & org, size_t org_id/*=0*/) {
   // shuffle environment schedule for this trial
   emp::Shuffle(*random_ptr, eval_environment.env_schedule);
   // reset hardware matchbin between trials
-  eval_hardware->ResetMatchBin();
+  trace_hardware->ResetMatchBin();
   // Evaluate the organism in the environment.
   for (env_update = 0; env_update < NUM_ENV_UPDATES; ++env_update) {
     // Reset the hardware!
-    eval_hardware->ResetHardwareState();
-    eval_hardware->GetCustomComponent().Reset();
-    emp_assert(eval_hardware->ValidateThreadState());
-    emp_assert(eval_hardware->GetActiveThreadIDs().size() == 0);
-    emp_assert(eval_hardware->GetNumQueuedEvents() == 0);
+    trace_hardware->ResetHardwareState();
+    trace_hardware->GetCustomComponent().Reset();
+    emp_assert(trace_hardware->ValidateThreadState());
+    emp_assert(trace_hardware->GetActiveThreadIDs().size() == 0);
+    emp_assert(trace_hardware->GetNumQueuedEvents() == 0);
     // Select a random environment.
     emp_assert(env_update % NUM_ENV_STATES < eval_environment.env_schedule.size());
     emp_assert(eval_environment.env_schedule[env_update % NUM_ENV_STATES] < eval_environment.env_state_tags.size());
     eval_environment.cur_state = eval_environment.env_schedule[env_update % NUM_ENV_STATES]; //random_ptr->GetUInt(0, NUM_ENV_STATES);
-    eval_hardware->QueueEvent(event_t(event_id__env_sig, eval_environment.GetCurEnvTag()));
+    trace_hardware->QueueEvent(event_t(event_id__env_sig, eval_environment.GetCurEnvTag()));
     // Step the hardware! If at any point, there are not active || pending threads, we're done!
     cpu_step = 0;
-    hw_state_info = GetHardwareStatePrintInfo(*eval_hardware);
+    hw_state_info = GetHardwareStatePrintInfo(*trace_hardware);
     trace_file.Update(); // Always output state BEFORE time step advances
     while (cpu_step < CPU_CYCLES_PER_ENV_UPDATE) {
-      eval_hardware->SingleProcess();
+      trace_hardware->SingleProcess();
       ++cpu_step;
-      hw_state_info = GetHardwareStatePrintInfo(*eval_hardware);
+      hw_state_info = GetHardwareStatePrintInfo(*trace_hardware);
       trace_file.Update();
-      if (!( eval_hardware->GetNumActiveThreads() || eval_hardware->GetNumPendingThreads() )) break;
+      if (!( trace_hardware->GetNumActiveThreads() || trace_hardware->GetNumPendingThreads() )) break;
     }
     // Did the hardware match, miss, or not respond to environment signal?
-    if (eval_hardware->GetCustomComponent().HasResponse()) {
-      trace_phen.env_matches += (size_t)(eval_hardware->GetCustomComponent().GetResponse() == (int)eval_environment.cur_state);
-      trace_phen.env_misses += (size_t)(eval_hardware->GetCustomComponent().GetResponse() != (int)eval_environment.cur_state);
+    if (trace_hardware->GetCustomComponent().HasResponse()) {
+      trace_phen.env_matches += (size_t)(trace_hardware->GetCustomComponent().GetResponse() == (int)eval_environment.cur_state);
+      trace_phen.env_misses += (size_t)(trace_hardware->GetCustomComponent().GetResponse() != (int)eval_environment.cur_state);
     } else {
       trace_phen.no_responses += 1;
     }
   }
   trace_phen.score = (double)trace_phen.env_matches; // Score = number of times organism matched environment.
-
-  inst_lib->ResetBeforeInstExecSignal();
 }
 
 void ChgEnvWorld::DoEvaluation() {
   max_fit_org_id = 0;
+  ResetCyclesUsed();
   for (size_t org_id = 0; org_id < this->GetSize(); ++org_id) {
     emp_assert(this->IsOccupied(org_id));
     EvaluateOrg(this->GetOrg(org_id));
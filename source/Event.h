@@ -3,8 +3,10 @@
 #define _CUSTOM_EVENTS_H
 
 // Standard includes
+#include <array>
+#include <initializer_list>
 #include <ostream>
-#include <unordered_map>
+#include <utility>
 // Empirical includes
 #include "emp/bits/BitSet.hpp"
 // SignalGP includes
@@ -30,12 +32,56 @@ struct Event : public sgp::BaseEvent {
   }
 };
 
+/// Fixed-capacity key/value payload stored inline (no heap allocation).
+/// - Iterates as (key, value) pairs in insertion order, like the map it replaces.
+/// - Setting an existing key overwrites its value; at most CAPACITY distinct keys (in every build,
+///   setting a new key on a full payload leaves the payload unchanged and returns false).
+template<typename KEY_T, typename VALUE_T, size_t CAPACITY>
+class InlinePayload {
+public:
+  using entry_t = std::pair<KEY_T, VALUE_T>;
+
+protected:
+  std::array<entry_t, CAPACITY> entries;
+  size_t num_entries=0;
+
+public:
+  InlinePayload() { ; }
+  InlinePayload(std::initializer_list<entry_t> init) {
+    for (const entry_t & entry : init) Set(entry.first, entry.second);
+  }
+
+  size_t size() const { return num_entries; }
+  bool empty() const { return num_entries == 0; }
+  static constexpr size_t capacity() { return CAPACITY; }
+
+  const entry_t * begin() const { return entries.data(); }
+  const entry_t * end() const { return entries.data() + num_entries; }
+
+  bool Has(const KEY_T & key) const {
+    for (const entry_t & entry : *this) { if (entry.first == key) return true; }
+    return false;
+  }
+
+  /// Set key's value. Returns false (and drops the entry) if key is new and the payload is full.
+  bool Set(const KEY_T & key, const VALUE_T & value) {
+    for (size_t i = 0; i < num_entries; ++i) {
+      if (entries[i].first == key) { entries[i].second = value; return true; }
+    }
+    if (num_entries == CAPACITY) return false;
+    entries[num_entries++] = {key, value};
+    return true;
+  }
+
+  void Clear() { num_entries = 0; }
+};
+
 /// Message event type
-/// - contains a tag and data
-template<size_t W>
+/// - contains a tag and data (up to DATA_CAPACITY key/value pairs, stored inline)
+template<size_t W, size_t DATA_CAPACITY=4>
 struct MessageEvent : public Event<W> {
   using tag_t = typename Event<W>::tag_t;
-  using data_t = std::unordered_map<int, double>;
+  using data_t = InlinePayload<int, double, DATA_CAPACITY>;
   data_t data;
 
   MessageEvent(size_t _id, tag_t _tag, const data_t & _data=data_t())
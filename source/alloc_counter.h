@@ -0,0 +1,95 @@
+#ifndef TAG_LGP_ALLOC_COUNTER_H
+#define TAG_LGP_ALLOC_COUNTER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+/// Heap allocation counters (e.g., to check that steady-state evaluation does not allocate).
+/// - These only measure allocations. Thread execution states (call/flow stacks and per-call memory
+///   buffers) belong to SignalGP's hardware, which rebuilds them on every spawn (SpawnThreadWithTag);
+///   pooling them is left to SignalGP.
+/// - Counting replaces the global operator new/delete, so it is opt-in: define
+///   TAG_LGP_COUNT_ALLOCATIONS before including this header in exactly one translation unit of an
+///   executable (benchmarks only; experiments never count).
+/// - Without it, counts stay at zero and AllocationCountingEnabled() is false.
+/// Counts cover every thread.
+namespace alloc_counter {
+  inline std::atomic<size_t> allocations{0};    ///< Calls to operator new (any form).
+  inline std::atomic<size_t> deallocations{0};  ///< Calls to operator delete (any form) on non-null pointers.
+  inline std::atomic<size_t> bytes{0};          ///< Bytes requested from operator new.
+  inline bool enabled=false;                    ///< Were the counting operators linked in?
+}
+
+/// Allocation counts at a point in time (or differences between two points in time).
+struct AllocCounts {
+  size_t allocations=0;
+  size_t deallocations=0;
+  size_t bytes=0;
+
+  AllocCounts operator-(const AllocCounts & other) const {
+    return {allocations - other.allocations, deallocations - other.deallocations, bytes - other.bytes};
+  }
+
+  AllocCounts & operator+=(const AllocCounts & other) {
+    allocations += other.allocations;
+    deallocations += other.deallocations;
+    bytes += other.bytes;
+    return *this;
+  }
+};
+
+inline AllocCounts GetAllocCounts() {
+  return {alloc_counter::allocations.load(std::memory_order_relaxed),
+          alloc_counter::deallocations.load(std::memory_order_relaxed),
+          alloc_counter::bytes.load(std::memory_order_relaxed)};
+}
+
+inline bool AllocationCountingEnabled() { return alloc_counter::enabled; }
+
+#ifdef TAG_LGP_COUNT_ALLOCATIONS
+
+namespace alloc_counter {
+  inline void * CountedAlloc(size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    bytes.fetch_add(size, std::memory_order_relaxed);
+    void * ptr = std::malloc(size ? size : 1);
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+  }
+
+  inline void * CountedAlignedAlloc(size_t size, std::align_val_t align) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    bytes.fetch_add(size, std::memory_order_relaxed);
+    const size_t alignment = static_cast<size_t>(align);
+    void * ptr = std::aligned_alloc(alignment, ((size ? size : 1) + alignment - 1) / alignment * alignment);
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+  }
+
+  inline void CountedFree(void * ptr) {
+    if (!ptr) return;
+    deallocations.fetch_add(1, std::memory_order_relaxed);
+    std::free(ptr);
+  }
+
+  inline const bool installed = (enabled = true);
+}
+
+void * operator new(size_t size) { return alloc_counter::CountedAlloc(size); }
+void * operator new[](size_t size) { return alloc_counter::CountedAlloc(size); }
+void * operator new(size_t size, std::align_val_t align) { return alloc_counter::CountedAlignedAlloc(size, align); }
+void * operator new[](size_t size, std::align_val_t align) { return alloc_counter::CountedAlignedAlloc(size, align); }
+void operator delete(void * ptr) noexcept { alloc_counter::CountedFree(ptr); }
+void operator delete[](void * ptr) noexcept { alloc_counter::CountedFree(ptr); }
+void operator delete(void * ptr, size_t) noexcept { alloc_counter::CountedFree(ptr); }
+void operator delete[](void * ptr, size_t) noexcept { alloc_counter::CountedFree(ptr); }
+void operator delete(void * ptr, std::align_val_t) noexcept { alloc_counter::CountedFree(ptr); }
+void operator delete[](void * ptr, std::align_val_t) noexcept { alloc_counter::CountedFree(ptr); }
+void operator delete(void * ptr, size_t, std::align_val_t) noexcept { alloc_counter::CountedFree(ptr); }
+void operator delete[](void * ptr, size_t, std::align_val_t) noexcept { alloc_counter::CountedFree(ptr); }
+
+#endif
+
+#endif
@@ -0,0 +1,112 @@
+#ifndef TAG_LGP_BATCH_METRICS_H
+#define TAG_LGP_BATCH_METRICS_H
+
+#include <algorithm>
+#include <cstdint>
+
+#include "emp/base/assert.hpp"
+#include "emp/base/vector.hpp"
+#include "emp/bits/BitSet.hpp"
+#include "emp/matchbin/matchbin_metrics.hpp"
+
+#include "tag_store.h"
+
+/// One-vs-many versions of emp's Hamming and integer (wrap) metrics.
+/// Each metric scores pairs exactly as the emp metric it extends; ScoreBlock additionally scores one
+/// query against every tag in a structure-of-arrays tag store. Kernels walk the store word by word,
+/// so the inner loops (over tags) are independent and vectorize.
+
+/// Wrapping difference (tag - query) for every tag in tags: diffs[i] = tags[i] - query.
+template<size_t WIDTH>
+void WrapDifferences(const packed_tag_t<WIDTH> & query,
+                     const SoATagStore<WIDTH> & tags,
+                     emp::vector<packed_tag_t<WIDTH>> & diffs)
+{
+  constexpr size_t NUM_WORDS = TagWordCount<WIDTH>();
+  const size_t count = tags.GetSize();
+  diffs.resize(count);
+  emp::vector<uint64_t> borrow(count, 0);
+  for (size_t k = 0; k < NUM_WORDS; ++k) {
+    const uint64_t * tag_words = tags.GetWords(k);
+    const uint64_t q = query[k];
+    for (size_t i = 0; i < count; ++i) {
+      const uint64_t t = tag_words[i];
+      const uint64_t d = t - q - borrow[i];
+      borrow[i] = (t < q) | ((t == q) & borrow[i]);
+      diffs[i][k] = d;
+    }
+  }
+  for (size_t i = 0; i < count; ++i) diffs[i][NUM_WORDS - 1] &= TagLastWordMask<WIDTH>();
+}
+
+/// Hamming metric with popcount block scoring.
+template<size_t WIDTH>
+struct BatchHammingMetric : public emp::HammingMetric<WIDTH> {
+  using query_t = typename emp::HammingMetric<WIDTH>::query_t;
+  using tag_t = typename emp::HammingMetric<WIDTH>::tag_t;
+  using tag_store_t = SoATagStore<WIDTH>;
+
+  /// Score query against every tag in tags, writing results into scores.
+  void ScoreBlock(const query_t & query, const tag_store_t & tags, double * scores) const {
+    constexpr size_t NUM_WORDS = TagWordCount<WIDTH>();
+    const auto packed_query = PackTag<WIDTH>(query);
+    const size_t count = tags.GetSize();
+    emp::vector<uint32_t> distances(count, 0);
+    for (size_t k = 0; k < NUM_WORDS; ++k) {
+      const uint64_t * tag_words = tags.GetWords(k);
+      const uint64_t q = packed_query[k];
+      for (size_t i = 0; i < count; ++i) {
+        distances[i] += static_cast<uint32_t>(__builtin_popcountll(tag_words[i] ^ q));
+      }
+    }
+    for (size_t i = 0; i < count; ++i) scores[i] = static_cast<double>(distances[i]) / WIDTH;
+  }
+};
+
+/// Asymmetric wrap (integer) metric with wide-subtraction block scoring.
+template<size_t WIDTH>
+struct BatchAsymmetricWrapMetric : public emp::AsymmetricWrapMetric<WIDTH> {
+  using query_t = typename emp::AsymmetricWrapMetric<WIDTH>::query_t;
+  using tag_t = typename emp::AsymmetricWrapMetric<WIDTH>::tag_t;
+  using tag_store_t = SoATagStore<WIDTH>;
+
+  /// Score query against every tag in tags, writing results into scores.
+  void ScoreBlock(const query_t & query, const tag_store_t & tags, double * scores) const {
+    emp::vector<packed_tag_t<WIDTH>> diffs;
+    WrapDifferences<WIDTH>(PackTag<WIDTH>(query), tags, diffs);
+    for (size_t i = 0; i < diffs.size(); ++i) {
+      scores[i] = UnpackTag<WIDTH>(diffs[i]).GetDouble() / emp::BitSet<WIDTH>::MaxDouble();
+    }
+  }
+};
+
+/// Symmetric wrap (integer) metric with wide-subtraction block scoring.
+template<size_t WIDTH>
+struct BatchSymmetricWrapMetric : public emp::SymmetricWrapMetric<WIDTH> {
+  using query_t = typename emp::SymmetricWrapMetric<WIDTH>::query_t;
+  using tag_t = typename emp::SymmetricWrapMetric<WIDTH>::tag_t;
+  using tag_store_t = SoATagStore<WIDTH>;
+
+  /// Score query against every tag in tags, writing results into scores.
+  void ScoreBlock(const query_t & query, const tag_store_t & tags, double * scores) const {
+    constexpr size_t NUM_WORDS = TagWordCount<WIDTH>();
+    const double max_dist = (emp::BitSet<WIDTH>::MaxDouble() + 1.0) / 2.0;
+    emp::vector<packed_tag_t<WIDTH>> diffs;
+    WrapDifferences<WIDTH>(PackTag<WIDTH>(query), tags, diffs);
+    for (size_t i = 0; i < diffs.size(); ++i) {
+      // Distance is the smaller of (tag - query) and (query - tag) = -(tag - query).
+      packed_tag_t<WIDTH> neg;
+      uint64_t borrow = 0;
+      for (size_t k = 0; k < NUM_WORDS; ++k) {
+        neg[k] = 0 - diffs[i][k] - borrow;
+        borrow = (diffs[i][k] != 0) | borrow;
+      }
+      neg[NUM_WORDS - 1] &= TagLastWordMask<WIDTH>();
+      const bool neg_smaller = std::lexicographical_compare(neg.rbegin(), neg.rend(),
+                                                            diffs[i].rbegin(), diffs[i].rend());
+      scores[i] = UnpackTag<WIDTH>(neg_smaller ? neg : diffs[i]).GetDouble() / max_dist;
+    }
+  }
+};
+
+#endif
@@ -0,0 +1,90 @@
+#ifndef TAG_LGP_BLOCK_SCORING_H
+#define TAG_LGP_BLOCK_SCORING_H
+
+#include <type_traits>
+
+#include "emp/base/assert.hpp"
+#include "emp/base/vector.hpp"
+
+/// Does METRIC_T provide block scoring (ScoreBlock over a tag_store_t)?
+template<typename METRIC_T, typename=void>
+struct has_block_scoring : std::false_type { };
+
+template<typename METRIC_T>
+struct has_block_scoring<METRIC_T, std::void_t<typename METRIC_T::tag_store_t>> : std::true_type { };
+
+/// A matchbin's function tags (by uid), kept ready to score one query against all of them.
+/// Metrics with block scoring (e.g., SimdStreakMetric, BatchHammingMetric) score every tag with a
+/// single ScoreBlock call over a tag store; other metrics score one tag at a time.
+/// Call Build whenever the function tags change.
+template<typename METRIC_T, bool BLOCK=has_block_scoring<METRIC_T>::value>
+class FunctionTagScorer {
+public:
+  using query_t = typename METRIC_T::query_t;
+  using tag_t = typename METRIC_T::tag_t;
+  using uid_t = size_t;
+
+protected:
+  METRIC_T metric;
+  emp::vector<tag_t> tags;  ///< Tag of each function in uids
+  emp::vector<uid_t> uids;  ///< uids of functions in the matchbin (increasing)
+
+public:
+  void Build(const emp::vector<tag_t> & tags_by_uid, const emp::vector<bool> & has_tag) {
+    tags.clear();
+    uids.clear();
+    for (uid_t uid = 0; uid < tags_by_uid.size(); ++uid) {
+      if (!has_tag[uid]) continue;
+      tags.emplace_back(tags_by_uid[uid]);
+      uids.emplace_back(uid);
+    }
+  }
+
+  /// Raw score of query against every function: scores[uid] (scores must be big enough to index
+  /// every uid; entries for missing uids are left alone).
+  void Score(const query_t & query, double * scores) const {
+    for (size_t i = 0; i < uids.size(); ++i) scores[uids[i]] = metric(query, tags[i]);
+  }
+};
+
+template<typename METRIC_T>
+class FunctionTagScorer<METRIC_T, true> {
+public:
+  using query_t = typename METRIC_T::query_t;
+  using tag_t = typename METRIC_T::tag_t;
+  using tag_store_t = typename METRIC_T::tag_store_t;
+  using uid_t = size_t;
+
+protected:
+  METRIC_T metric;
+  tag_store_t tag_store;
+  emp::vector<uid_t> uids;                    ///< uid of each tag in tag_store (increasing)
+  bool contiguous=true;                       ///< Are uids exactly 0..count-1?
+  mutable emp::vector<double> block_scores;   ///< Scratch (used when uids are not contiguous)
+
+public:
+  void Build(const emp::vector<tag_t> & tags_by_uid, const emp::vector<bool> & has_tag) {
+    tag_store.Clear();
+    uids.clear();
+    for (uid_t uid = 0; uid < tags_by_uid.size(); ++uid) {
+      if (!has_tag[uid]) continue;
+      tag_store.Add(tags_by_uid[uid]);
+      uids.emplace_back(uid);
+    }
+    contiguous = uids.empty() || uids.back() == uids.size() - 1;
+  }
+
+  /// Raw score of query against every function: scores[uid] (scores must be big enough to index
+  /// every uid; entries for missing uids are left alone).
+  void Score(const query_t & query, double * scores) const {
+    if (contiguous) {
+      metric.ScoreBlock(query, tag_store, scores);
+      return;
+    }
+    block_scores.resize(uids.size());
+    metric.ScoreBlock(query, tag_store, block_scores.data());
+    for (size_t i = 0; i < uids.size(); ++i) scores[uids[i]] = block_scores[i];
+  }
+};
+
+#endif
@@ -0,0 +1,161 @@
+#ifndef TAG_LGP_CACHED_RAW_MATCHBIN_H
+#define TAG_LGP_CACHED_RAW_MATCHBIN_H
+
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+#include "emp/base/assert.hpp"
+#include "emp/base/vector.hpp"
+
+/// Matchbin (e.g., emp::MatchBin, IndexedMatchBin, or TimerWheelMatchBin) that resolves the raw
+/// (unregulated) best match of every instruction tag in the loaded program once.
+/// - Raw matches depend only on the query tag and the function tags in the matchbin, so the
+///   regulation instructions (SetRegulator, AdjRegulator, ClearRegulator, and their knockout
+///   variants), which look up their target with MatchRaw(inst tag, 1) every time they execute, only
+///   need to resolve each instruction tag once per program.
+/// - LoadProgram stores the best raw match of each instruction in a per-(function, instruction)
+///   table. Call it with the hardware's own copy of the program (hw.GetProgram()) after SetProgram:
+///   MatchRaw(inst.GetTag(0), 1) finds the instruction by the address of its tag, so the tag is not
+///   hashed. One tag comparison guards against a program loaded without LoadProgram.
+/// - The table is kept for as long as the matchbin holds the same function tags. Clearing and
+///   re-adding the same tags (e.g., ResetMatchBin between tests) keeps it.
+/// Other raw matches (n > 1, or queries that are not instruction tags of the loaded program) and
+/// regulated matches (e.g., Call) are left to the wrapped matchbin.
+template<typename MATCHBIN_T>
+class CachedRawMatchBin : public MATCHBIN_T {
+public:
+  using base_t = MATCHBIN_T;
+  using uid_t = size_t;
+  using tag_t = std::decay_t<decltype(std::declval<MATCHBIN_T&>().GetTag(0))>;
+  using query_t = tag_t;
+
+  static constexpr uid_t NO_MATCH = (uid_t)-1;
+
+protected:
+  /// Raw best match of one instruction in the loaded program.
+  struct inst_match_t {
+    query_t tag;             ///< The instruction's tag (untagged instructions: unused).
+    uid_t uid=NO_MATCH;      ///< MatchRaw(tag, 1), or NO_MATCH if nothing matched.
+  };
+
+  emp::vector<emp::vector<inst_match_t>> program_matches;  ///< By function, then instruction.
+  std::unordered_map<const query_t *, std::pair<size_t, size_t>> inst_positions; ///< Instruction tag address -> (function, instruction).
+  emp::vector<tag_t> tags;          ///< Function tags currently in the matchbin (by uid).
+  emp::vector<bool> has_tag;        ///< Is there a function with this uid in the matchbin?
+  emp::vector<tag_t> cached_tags;   ///< Function tags program_matches was computed for (by uid).
+  emp::vector<bool> cached_has_tag;
+  bool tags_changed=false;          ///< Have the function tags been touched since program_matches was checked?
+  size_t raw_cache_hits=0;          ///< MatchRaw calls answered from program_matches.
+  size_t raw_cache_misses=0;        ///< MatchRaw calls passed on to the wrapped matchbin.
+
+  void RecordTag(uid_t uid, const tag_t & tag) {
+    if (uid >= tags.size()) {
+      tags.resize(uid + 1);
+      has_tag.resize(uid + 1, false);
+    }
+    tags[uid] = tag;
+    has_tag[uid] = true;
+    tags_changed = true;
+  }
+
+  /// Drop the program's matches if the function tags differ from those they were computed for.
+  void CheckTags() {
+    if (!tags_changed) return;
+    tags_changed = false;
+    if (has_tag == cached_has_tag && tags == cached_tags) return;
+    program_matches.clear();
+    inst_positions.clear();
+    cached_tags = tags;
+    cached_has_tag = has_tag;
+  }
+
+public:
+  template <typename... Ts>
+  CachedRawMatchBin(Ts &&... args) : base_t(std::forward<Ts>(args)...) { ; }
+
+  /// Find the (up to) n best raw (unregulated) matches for query.
+  emp::vector<uid_t> MatchRaw(const query_t & query, size_t n=1) {
+    CheckTags();
+    if (n == 1) {
+      const auto pos = inst_positions.find(&query);
+      if (pos != inst_positions.end()) {
+        const inst_match_t & match = program_matches[pos->second.first][pos->second.second];
+        if (match.tag == query) {
+          ++raw_cache_hits;
+          if (match.uid == NO_MATCH) return {};
+          return {match.uid};
+        }
+      }
+    }
+    ++raw_cache_misses;
+    return base_t::MatchRaw(query, n);
+  }
+
+  /// Raw best match of the loaded program's instruction inst_id in function func_id (NO_MATCH if
+  /// the instruction is untagged, nothing matched, or the program has not been loaded).
+  uid_t GetProgramMatch(size_t func_id, size_t inst_id) {
+    CheckTags();
+    if (func_id >= program_matches.size() || inst_id >= program_matches[func_id].size()) return NO_MATCH;
+    return program_matches[func_id][inst_id].uid;
+  }
+
+  size_t GetRawCacheHits() const { return raw_cache_hits; }
+  size_t GetRawCacheMisses() const { return raw_cache_misses; }
+
+  void ResetRawCacheStats() {
+    raw_cache_hits = 0;
+    raw_cache_misses = 0;
+  }
+
+  /// Resolve the raw best match of every tagged instruction in program (the program the hardware
+  /// runs, i.e., hw.GetProgram(): instructions are found by the address of their tags).
+  template<typename PROGRAM_T>
+  void LoadProgram(const PROGRAM_T & program) {
+    CheckTags();
+    program_matches.clear();
+    inst_positions.clear();
+    program_matches.resize(program.GetSize());
+    for (size_t func_id = 0; func_id < program.GetSize(); ++func_id) {
+      const auto & func = program[func_id];
+      program_matches[func_id].resize(func.GetSize());
+      for (size_t inst_id = 0; inst_id < func.GetSize(); ++inst_id) {
+        const auto & inst = func[inst_id];
+        if (!inst.GetTags().size()) continue;
+        inst_match_t & match = program_matches[func_id][inst_id];
+        match.tag = inst.GetTag(0);
+        const emp::vector<uid_t> best = base_t::MatchRaw(match.tag, 1);
+        if (best.size()) match.uid = best[0];
+        inst_positions[&inst.GetTag(0)] = {func_id, inst_id};
+      }
+    }
+  }
+
+  template <typename V>
+  uid_t Put(const V & v, const tag_t & tag) {
+    const uid_t uid = base_t::Put(v, tag);
+    RecordTag(uid, tag);
+    return uid;
+  }
+
+  template <typename V>
+  void Set(const V & v, const tag_t & tag, const uid_t uid) {
+    base_t::Set(v, tag, uid);
+    RecordTag(uid, tag);
+  }
+
+  void Delete(const uid_t uid) {
+    base_t::Delete(uid);
+    if (uid < has_tag.size()) has_tag[uid] = false;
+    tags_changed = true;
+  }
+
+  void Clear() {
+    base_t::Clear();
+    tags.clear();
+    has_tag.clear();
+    tags_changed = true;
+  }
+};
+
+#endif
@@ -0,0 +1,234 @@
+#ifndef TAG_LGP_DIRTY_RESET_MATCHBIN_H
+#define TAG_LGP_DIRTY_RESET_MATCHBIN_H
+
+#include <type_traits>
+#include <utility>
+
+#include "emp/base/assert.hpp"
+#include "emp/base/vector.hpp"
+
+/// Matchbin (e.g., CachedRawMatchBin) whose resets only undo what changed since the last reset.
+/// - SignalGP's ResetMatchBin (called between test cases) clears the matchbin and re-adds every
+///   function (Clear, then Set for each function). That rebuilds the wrapped matchbin and drops all
+///   of its match caches, even when the program is unchanged and the test only touched one
+///   function's regulator.
+/// - Here, Clear only starts a reset. A Set that re-adds a function with the tag and value it already
+///   has restores that function's regulator to its default, and only if the regulator was touched
+///   (SetRegulator, AdjRegulator, DecayRegulator, GetRegulator) since the last reset. Functions that
+///   are not re-added are deleted when the matchbin is next used. A Set that differs from what the
+///   matchbin holds (e.g., a new program) falls back to a full reset.
+/// - Forward decay never moves a regulator out of its default state, so DecayRegulators only marks
+///   regulators as touched when asked to decay in reverse.
+/// Debug builds check that every regulator is back in its default state after a reset.
+/// Only matchbin (regulation) resets are dirty-tracked. Thread slots, global memory, and the event
+/// queue are reset by SignalGP's ResetBaseHardwareState/ResetHardwareState, which always reset them
+/// in full.
+/// Functions are identified by uid (SignalGP uses function ids as uids).
+template<typename MATCHBIN_T>
+class DirtyResetMatchBin : public MATCHBIN_T {
+public:
+  using base_t = MATCHBIN_T;
+  using uid_t = size_t;
+  using tag_t = std::decay_t<decltype(std::declval<MATCHBIN_T&>().GetTag(0))>;
+  using query_t = tag_t;
+  using val_t = std::decay_t<decltype(std::declval<MATCHBIN_T&>().GetVal(0))>;
+  using regulator_t = std::decay_t<decltype(std::declval<MATCHBIN_T&>().GetRegulator(0))>;
+
+protected:
+  emp::vector<tag_t> tags;      ///< Function tags in the matchbin (by uid).
+  emp::vector<val_t> vals;      ///< Function values in the matchbin (by uid).
+  emp::vector<bool> has_tag;    ///< Is there a function with this uid in the matchbin?
+  emp::vector<bool> touched;    ///< Has this function's regulator been touched since the last reset?
+  emp::vector<bool> readded;    ///< Has this function been re-added since the current reset began?
+  size_t num_funcs=0;           ///< Functions in the wrapped matchbin.
+  size_t num_readded=0;         ///< Functions re-added since the current reset began.
+  bool resetting=false;         ///< Has Clear been called without the matchbin being used since?
+
+  void Record(uid_t uid, const val_t & val, const tag_t & tag) {
+    if (uid >= has_tag.size()) {
+      tags.resize(uid + 1);
+      vals.resize(uid + 1);
+      has_tag.resize(uid + 1, false);
+      touched.resize(uid + 1, false);
+    }
+    // Overwriting a function: don't assume anything about its regulator.
+    touched[uid] = has_tag[uid];
+    num_funcs += !has_tag[uid];
+    tags[uid] = tag;
+    vals[uid] = val;
+    has_tag[uid] = true;
+  }
+
+  void Touch(uid_t uid) {
+    if (uid < touched.size()) touched[uid] = true;
+  }
+
+  /// Finish the current reset: delete functions that were not re-added.
+  void FinishReset() {
+    if (!resetting) return;
+    resetting = false;
+    if (num_readded != num_funcs) {
+      for (uid_t uid = 0; uid < has_tag.size(); ++uid) {
+        if (!has_tag[uid] || readded[uid]) continue;
+        base_t::Delete(uid);
+        has_tag[uid] = false;
+        --num_funcs;
+      }
+    }
+    emp_assert(RegulatorsReset());
+  }
+
+  /// Abandon the current reset: fully reset the wrapped matchbin, keeping the functions re-added so far.
+  void FullReset() {
+    emp_assert(resetting);
+    resetting = false;
+    base_t::Clear();
+    num_funcs = 0;
+    for (uid_t uid = 0; uid < has_tag.size(); ++uid) {
+      touched[uid] = false;
+      has_tag[uid] = has_tag[uid] && readded[uid];
+      if (!has_tag[uid]) continue;
+      base_t::Set(vals[uid], tags[uid], uid);
+      ++num_funcs;
+    }
+  }
+
+  /// Is every function's regulator in its default state?
+  bool RegulatorsReset() {
+    const auto neutral = regulator_t().View();
+    for (uid_t uid = 0; uid < has_tag.size(); ++uid) {
+      if (has_tag[uid] && base_t::ViewRegulator(uid) != neutral) return false;
+    }
+    return true;
+  }
+
+public:
+  template <typename... Ts>
+  DirtyResetMatchBin(Ts &&... args) : base_t(std::forward<Ts>(args)...) { ; }
+
+  size_t Size() const { return resetting ? num_readded : base_t::Size(); }
+
+  emp::vector<uid_t> Match(const query_t & query, size_t n=1) {
+    FinishReset();
+    return base_t::Match(query, n);
+  }
+
+  emp::vector<uid_t> MatchRaw(const query_t & query, size_t n=1) {
+    FinishReset();
+    return base_t::MatchRaw(query, n);
+  }
+
+  template<typename PROGRAM_T>
+  void LoadProgram(const PROGRAM_T & program) {
+    FinishReset();
+    base_t::LoadProgram(program);
+  }
+
+  template <typename T>
+  void SetRegulator(const uid_t uid, const T & set) {
+    FinishReset();
+    Touch(uid);
+    base_t::SetRegulator(uid, set);
+  }
+
+  template <typename T>
+  void AdjRegulator(const uid_t uid, const T & amt) {
+    FinishReset();
+    Touch(uid);
+    base_t::AdjRegulator(uid, amt);
+  }
+
+  void DecayRegulator(const uid_t uid, const int steps) {
+    FinishReset();
+    Touch(uid);
+    base_t::DecayRegulator(uid, steps);
+  }
+
+  void DecayRegulators(const int steps=1) {
+    FinishReset();
+    if (steps < 0) {
+      for (uid_t uid = 0; uid < touched.size(); ++uid) touched[uid] = true;
+    }
+    base_t::DecayRegulators(steps);
+  }
+
+  /// Access uid's regulator. Callers may change it, so it is reset at the next reset.
+  decltype(auto) GetRegulator(const uid_t uid) {
+    FinishReset();
+    Touch(uid);
+    return base_t::GetRegulator(uid);
+  }
+
+  uid_t Put(const val_t & v, const tag_t & tag) {
+    FinishReset();
+    const uid_t uid = base_t::Put(v, tag);
+    Record(uid, v, tag);
+    return uid;
+  }
+
+  void Set(const val_t & v, const tag_t & tag, const uid_t uid) {
+    if (resetting) {
+      const bool unchanged = uid < has_tag.size() && has_tag[uid] && !readded[uid]
+                             && tags[uid] == tag && vals[uid] == v;
+      if (unchanged) {
+        readded[uid] = true;
+        ++num_readded;
+        if (touched[uid]) {
+          base_t::SetRegulator(uid, regulator_t());
+          touched[uid] = false;
+        }
+        return;
+      }
+      FullReset();
+    }
+    base_t::Set(v, tag, uid);
+    Record(uid, v, tag);
+  }
+
+  void Delete(const uid_t uid) {
+    FinishReset();
+    base_t::Delete(uid);
+    if (uid < has_tag.size() && has_tag[uid]) {
+      has_tag[uid] = false;
+      --num_funcs;
+    }
+  }
+
+  /// Save the regulators touched since the last reset into snapshot (as (uid, regulator) pairs);
+  /// every other regulator is in its default state.
+  template<typename SNAPSHOT_T>
+  void SaveRegulators(SNAPSHOT_T & snapshot) {
+    FinishReset();
+    snapshot.clear();
+    for (uid_t uid = 0; uid < has_tag.size(); ++uid) {
+      if (has_tag[uid] && touched[uid]) snapshot.emplace_back(uid, base_t::GetRegulator(uid));
+    }
+  }
+
+  /// Put every regulator back into the state saved by SaveRegulators (for the same functions).
+  /// Only regulators touched since the last reset or saved in snapshot are changed.
+  template<typename SNAPSHOT_T>
+  void RestoreRegulators(const SNAPSHOT_T & snapshot) {
+    FinishReset();
+    for (uid_t uid = 0; uid < has_tag.size(); ++uid) {
+      if (!touched[uid]) continue;
+      if (has_tag[uid]) base_t::SetRegulator(uid, regulator_t());
+      touched[uid] = false;
+    }
+    for (const auto & saved : snapshot) {
+      emp_assert(saved.first < has_tag.size() && has_tag[saved.first]);
+      base_t::SetRegulator(saved.first, saved.second);
+      touched[saved.first] = true;
+    }
+  }
+
+  /// Begin a reset (see above).
+  void Clear() {
+    FinishReset();
+    resetting = true;
+    readded.assign(has_tag.size(), false);
+    num_readded = 0;
+  }
+};
+
+#endif
@@ -0,0 +1,21 @@
+#ifndef TAG_LGP_HARDWARE_RUN_H
+#define TAG_LGP_HARDWARE_RUN_H
+
+#include <cstddef>
+
+/// Run hw for up to max_cycles CPU cycles (one SingleProcess each), stopping early once the
+/// hardware goes quiescent (no active or pending threads). Returns the number of cycles run.
+/// - Worlds add the result to their custom component's cycles_used counter (see GetCyclesUsed)
+///   to profile how much of the cycle budget evaluation actually uses.
+template<typename HARDWARE_T>
+size_t RunUntilQuiescent(HARDWARE_T & hw, size_t max_cycles) {
+  size_t cycles = 0;
+  while (cycles < max_cycles) {
+    hw.SingleProcess();
+    ++cycles;
+    if (!(hw.GetNumActiveThreads() || hw.GetNumPendingThreads())) break;
+  }
+  return cycles;
+}
+
+#endif
@@ -0,0 +1,251 @@
+#ifndef TAG_LGP_INDEXED_MATCHBIN_H
+#define TAG_LGP_INDEXED_MATCHBIN_H
+
+#include <algorithm>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include "emp/base/assert.hpp"
+#include "emp/base/vector.hpp"
+#include "emp/matchbin/MatchBin.hpp"
+
+#include "block_scoring.h"
+
+/// Match counters kept by IndexedMatchBin.
+struct MatchBinStats {
+  size_t matches=0;             ///< Calls to Match.
+  size_t regulation_purges=0;   ///< Regulator changes seen between matches (each purges emp::MatchBin's whole cache).
+  size_t full_recomputes=0;     ///< Matches that scored every function from scratch.
+  size_t incremental_updates=0; ///< Single-function regulated score updates (incremental index only).
+
+  void Reset() { *this = MatchBinStats(); }
+
+  MatchBinStats & operator+=(const MatchBinStats & other) {
+    matches += other.matches;
+    regulation_purges += other.regulation_purges;
+    full_recomputes += other.full_recomputes;
+    incremental_updates += other.incremental_updates;
+    return *this;
+  }
+};
+
+/// Does MATCHBIN_T keep MatchBinStats?
+template<typename MATCHBIN_T, typename=void>
+struct has_matchbin_stats : std::false_type { };
+
+template<typename MATCHBIN_T>
+struct has_matchbin_stats<MATCHBIN_T, std::void_t<decltype(std::declval<const MATCHBIN_T&>().GetStats())>> : std::true_type { };
+
+/// Is SELECTOR_T a ranked selector without a match threshold (i.e., emp::RankedSelector<>)?
+template<typename SELECTOR_T>
+struct is_unthresholded_ranked_selector : std::false_type { };
+
+template<>
+struct is_unthresholded_ranked_selector<emp::RankedSelector<>> : std::true_type { };
+
+/// emp::MatchBin with a regulation-aware match index and counters for match (re)computation.
+/// - emp::MatchBin purges every cached match whenever any regulator changes. With INCREMENTAL, this
+///   matchbin instead keeps, for each query it has seen, every function's raw score and a ranking of
+///   regulated scores; when a function's regulator changes, only that function's regulated score is
+///   recomputed and re-ranked in each cached query's ranking. New queries are scored against every
+///   function tag at once (one ScoreBlock call for metrics with block scoring, e.g., BatchHammingMetric).
+/// - Without INCREMENTAL, matching is left to emp::MatchBin; the counters report how often its cache
+///   is purged and how many full recomputes that causes (i.e., the baseline to compare against).
+/// Regulator changes are caught by the regulator mutators (SetRegulator, AdjRegulator, DecayRegulator,
+/// DecayRegulators, and GetRegulator, whose caller may change the regulator): each marks the functions
+/// it may have changed, and the next match compares only those functions' regulator views
+/// (ViewRegulator) against the views the index was built with.
+/// Functions are identified by uid (SignalGP uses function ids as uids). The incremental index
+/// requires an unthresholded ranked selector; ties in regulated score go to the lower uid.
+template <typename Val, typename Metric, typename Selector, typename Regulator, bool INCREMENTAL=true>
+class IndexedMatchBin : public emp::MatchBin<Val, Metric, Selector, Regulator> {
+public:
+  using base_t = emp::MatchBin<Val, Metric, Selector, Regulator>;
+  using query_t = typename Metric::query_t;
+  using tag_t = typename Metric::tag_t;
+  using uid_t = size_t;
+
+  static_assert(!INCREMENTAL || is_unthresholded_ranked_selector<Selector>::value,
+                "Incremental match index only supports emp::RankedSelector<> (MATCH_THRESH=0).");
+
+protected:
+  struct Entry {
+    emp::vector<double> raw;        ///< Raw (unregulated) score by uid.
+    emp::vector<double> regulated;  ///< Regulated score by uid.
+    emp::vector<uid_t> ranking;     ///< uids ordered by (regulated score, uid).
+  };
+
+  FunctionTagScorer<Metric> scorer;          ///< Scores new queries against every function tag.
+  std::unordered_map<query_t, Entry> index;
+  std::unordered_set<query_t> fresh_queries;  ///< (counting only) queries matched since the last purge.
+  emp::vector<double> reg_views;              ///< Regulator views the index is up to date with (by uid).
+  emp::vector<uid_t> pending;                 ///< uids whose regulator may have changed since the last match
+  emp::vector<bool> is_pending;
+  bool index_valid=false;                     ///< False once the set of tags changes.
+  MatchBinStats stats;
+
+  bool RankedBefore(const Entry & entry, uid_t a, uid_t b) const {
+    return std::make_pair(entry.regulated[a], a) < std::make_pair(entry.regulated[b], b);
+  }
+
+  /// Recompute uid's regulated score in entry and move it to its new place in the ranking.
+  void UpdateEntry(Entry & entry, uid_t uid) {
+    auto & ranking = entry.ranking;
+    ranking.erase(std::find(ranking.begin(), ranking.end(), uid));
+    entry.regulated[uid] = base_t::GetRegulator(uid)(entry.raw[uid]);
+    auto pos = std::lower_bound(ranking.begin(), ranking.end(), uid,
+                                [this, &entry](uid_t a, uid_t b) { return RankedBefore(entry, a, b); });
+    ranking.insert(pos, uid);
+    ++stats.incremental_updates;
+  }
+
+  Entry & BuildEntry(const query_t & query) {
+    const size_t size = reg_views.size();
+    Entry & entry = index[query];
+    entry.raw.resize(size);
+    entry.regulated.resize(size);
+    entry.ranking.resize(size);
+    scorer.Score(query, entry.raw.data());
+    for (uid_t uid = 0; uid < size; ++uid) {
+      entry.regulated[uid] = base_t::GetRegulator(uid)(entry.raw[uid]);
+      entry.ranking[uid] = uid;
+    }
+    std::sort(entry.ranking.begin(), entry.ranking.end(),
+              [this, &entry](uid_t a, uid_t b) { return RankedBefore(entry, a, b); });
+    ++stats.full_recomputes;
+    return entry;
+  }
+
+  /// Note that uid's regulator may have changed. (Nothing to note while the index is invalid: it is
+  /// rebuilt from the current regulators.)
+  void MarkPending(uid_t uid) {
+    if (!index_valid || uid >= is_pending.size() || is_pending[uid]) return;
+    is_pending[uid] = true;
+    pending.emplace_back(uid);
+  }
+
+  /// Bring the index up to date with regulator changes made since the last match.
+  void SyncRegulators() {
+    if (!index_valid) {
+      ResetIndex();
+      return;
+    }
+    bool changed = false;
+    for (uid_t uid : pending) {
+      is_pending[uid] = false;
+      const double view = this->ViewRegulator(uid);
+      if (view == reg_views[uid]) continue;
+      reg_views[uid] = view;
+      changed = true;
+      if constexpr (INCREMENTAL) {
+        for (auto & query_entry : index) UpdateEntry(query_entry.second, uid);
+      }
+    }
+    pending.clear();
+    if (changed) {
+      ++stats.regulation_purges;
+      fresh_queries.clear();
+    }
+  }
+
+  void ResetIndex() {
+    index.clear();
+    fresh_queries.clear();
+    reg_views.resize(base_t::Size());
+    for (uid_t uid = 0; uid < reg_views.size(); ++uid) reg_views[uid] = this->ViewRegulator(uid);
+    pending.clear();
+    is_pending.assign(reg_views.size(), false);
+    if constexpr (INCREMENTAL) {
+      emp::vector<tag_t> tags;
+      for (uid_t uid = 0; uid < reg_views.size(); ++uid) tags.emplace_back(this->GetTag(uid));
+      scorer.Build(tags, emp::vector<bool>(tags.size(), true));
+    }
+    index_valid = true;
+  }
+
+public:
+  template <typename... Ts>
+  IndexedMatchBin(Ts &&... args) : base_t(std::forward<Ts>(args)...) { ; }
+
+  const MatchBinStats & GetStats() const { return stats; }
+  void ResetStats() { stats.Reset(); }
+
+  /// Find the (up to) n best regulated matches for query.
+  emp::vector<uid_t> Match(const query_t & query, size_t n=1) {
+    SyncRegulators();
+    ++stats.matches;
+    if constexpr (INCREMENTAL) {
+      auto it = index.find(query);
+      const Entry & entry = (it == index.end()) ? BuildEntry(query) : it->second;
+      const size_t count = std::min(n, entry.ranking.size());
+      return emp::vector<uid_t>(entry.ranking.begin(), entry.ranking.begin() + count);
+    } else {
+      if (fresh_queries.emplace(query).second) ++stats.full_recomputes;
+      return base_t::Match(query, n);
+    }
+  }
+
+  template <typename T>
+  void SetRegulator(const uid_t uid, const T & set) {
+    base_t::SetRegulator(uid, set);
+    MarkPending(uid);
+  }
+
+  template <typename T>
+  void AdjRegulator(const uid_t uid, const T & amt) {
+    base_t::AdjRegulator(uid, amt);
+    MarkPending(uid);
+  }
+
+  void DecayRegulator(const uid_t uid, const int steps) {
+    base_t::DecayRegulator(uid, steps);
+    MarkPending(uid);
+  }
+
+  /// Decay every regulator by steps, marking only the functions whose regulator view changed.
+  void DecayRegulators(const int steps=1) {
+    if (!index_valid) {
+      base_t::DecayRegulators(steps);
+      return;
+    }
+    for (uid_t uid = 0; uid < reg_views.size(); ++uid) {
+      const double view = this->ViewRegulator(uid);
+      base_t::DecayRegulator(uid, steps);
+      if (this->ViewRegulator(uid) != view) MarkPending(uid);
+    }
+  }
+
+  /// Access uid's regulator. Callers may change it, so it is checked at the next match.
+  decltype(auto) GetRegulator(const uid_t uid) {
+    MarkPending(uid);
+    return base_t::GetRegulator(uid);
+  }
+
+  // Changes to the set of tags invalidate the index (rebuilt on the next match).
+  template <typename... Ts>
+  auto Put(Ts &&... args) {
+    index_valid = false;
+    return base_t::Put(std::forward<Ts>(args)...);
+  }
+
+  template <typename... Ts>
+  void Set(Ts &&... args) {
+    index_valid = false;
+    base_t::Set(std::forward<Ts>(args)...);
+  }
+
+  template <typename... Ts>
+  void Delete(Ts &&... args) {
+    index_valid = false;
+    base_t::Delete(std::forward<Ts>(args)...);
+  }
+
+  void Clear() {
+    index_valid = false;
+    base_t::Clear();
+  }
+};
+
+#endif
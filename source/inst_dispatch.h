@@ -0,0 +1,21 @@
+#ifndef TAG_LGP_INST_DISPATCH_H
+#define TAG_LGP_INST_DISPATCH_H
+
+/// Instruction callables for SignalGP instruction libraries.
+/// - The instruction library stores each instruction as a std::function, and the hardware calls
+///   instructions through it. A std::function holding a function pointer (e.g., registering
+///   sgp::inst_impl::Inst_Inc<hardware_t, inst_t> directly) costs two indirect calls per executed
+///   instruction: the std::function's invoker, then the stored pointer.
+/// - DirectInst<INST_FUN> is an empty callable that names INST_FUN at compile time. Stored in a
+///   std::function, its invoker calls INST_FUN directly (and can inline it), so dispatch is a single
+///   indirect call through the library's flat instruction table (as for instructions registered
+///   as lambdas).
+/// Worlds register instruction functions as DirectInst<INST_FUN>{} (registration is otherwise
+/// unchanged: inst_lib->AddInst(name, callable, desc, properties)).
+template<auto INST_FUN>
+struct DirectInst {
+  template<typename HARDWARE_T, typename INST_T>
+  void operator()(HARDWARE_T & hw, const INST_T & inst) const { INST_FUN(hw, inst); }
+};
+
+#endif
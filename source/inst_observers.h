@@ -0,0 +1,68 @@
+#ifndef TAG_LGP_INST_OBSERVERS_H
+#define TAG_LGP_INST_OBSERVERS_H
+
+#include <initializer_list>
+#include <string>
+#include <type_traits>
+
+#include "emp/base/Ptr.hpp"
+#include "emp/base/vector.hpp"
+
+/// Instruction execution observers, compiled into an instruction library.
+/// - SignalGP's OnBeforeInstExec hook belongs to the instruction library: while it is installed,
+///   every program run with that library (on any hardware) goes through it.
+/// - Here, an observer is a policy applied to each instruction when the library is built
+///   (ObservedInstLib). Worlds build their evolution libraries with NoInstObserver (instructions are
+///   registered unchanged) and a separate tracing library with InstRecorder, so tracing never
+///   touches the libraries used for evaluation.
+
+/// Observes nothing.
+struct NoInstObserver { };
+
+/// Records every executed instruction (before it executes) into a caller-owned vector.
+template<typename INST_T>
+class InstRecorder {
+protected:
+  emp::Ptr<emp::vector<INST_T>> executed;
+
+public:
+  InstRecorder(emp::vector<INST_T> & _executed) : executed(&_executed) { ; }
+
+  template<typename HARDWARE_T>
+  void BeforeInst(HARDWARE_T & hw, const INST_T & inst) const { executed->emplace_back(inst); }
+};
+
+/// Adds instructions to an instruction library, applying OBSERVER_T to each one.
+/// Supports the instruction library calls used to build instruction sets (Clear, AddInst).
+template<typename INST_LIB_T, typename INST_PROP_T, typename OBSERVER_T=NoInstObserver>
+class ObservedInstLib {
+protected:
+  INST_LIB_T & lib;
+  OBSERVER_T observer;
+
+public:
+  ObservedInstLib(INST_LIB_T & _lib, const OBSERVER_T & _observer=OBSERVER_T())
+    : lib(_lib), observer(_observer) { ; }
+
+  void Clear() { lib.Clear(); }
+
+  template<typename FUN_T>
+  void AddInst(const std::string & name, const FUN_T & fun, const std::string & desc="",
+               std::initializer_list<INST_PROP_T> properties={}) {
+    if constexpr (std::is_same<OBSERVER_T, NoInstObserver>::value) {
+      lib.AddInst(name, fun, desc, properties);
+    } else {
+      lib.AddInst(
+        name,
+        [fun, observer=observer](auto & hw, const auto & inst) {
+          observer.BeforeInst(hw, inst);
+          fun(hw, inst);
+        },
+        desc,
+        properties
+      );
+    }
+  }
+};
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef TAG_LGP_KNOCKOUTS_H
+#define TAG_LGP_KNOCKOUTS_H
+
+#include <cstddef>
+
+/// Knockouts compiled into an instruction library.
+/// - Worlds build one instruction library per knockout mode (plus the normal, knockout-free library),
+///   each with its knocked-out instructions specialized away, and evaluate knockout variants on
+///   hardware bound to the matching library. Instructions never check knockout flags at run time,
+///   and analysis never changes shared world (or hardware) state to switch modes.
+/// - Knocking out regulation knocks out both directions; UP_REGULATION/DOWN_REGULATION knock out one.
+template<bool GLOBAL_MEMORY, bool REGULATION, bool UP_REGULATION, bool DOWN_REGULATION>
+struct Knockouts {
+  static constexpr bool global_memory = GLOBAL_MEMORY;      ///< Is global memory access knocked out?
+  static constexpr bool regulation = REGULATION;            ///< Is regulation knocked out?
+  static constexpr bool up_regulation = UP_REGULATION;      ///< Is up-regulation knocked out?
+  static constexpr bool down_regulation = DOWN_REGULATION;  ///< Is down-regulation knocked out?
+};
+
+using NoKnockouts = Knockouts<false, false, false, false>;
+
+/// Knockout modes run during organism analysis (indexes into a world's knockout libraries/hardware).
+enum class KnockoutMode : size_t {
+  GLOBAL_MEMORY=0,             ///< Global memory access knocked out.
+  REGULATION,                  ///< Regulation knocked out.
+  GLOBAL_MEMORY_AND_REGULATION, ///< Global memory access and regulation knocked out.
+  UP_REGULATION,               ///< Up-regulation (promotion) knocked out.
+  DOWN_REGULATION              ///< Down-regulation (repression) knocked out.
+};
+
+constexpr size_t NUM_KNOCKOUT_MODES = 5;
+
+/// Knockouts for each knockout mode.
+template<KnockoutMode MODE>
+struct knockouts_for;
+
+template<> struct knockouts_for<KnockoutMode::GLOBAL_MEMORY> { using type = Knockouts<true, false, false, false>; };
+template<> struct knockouts_for<KnockoutMode::REGULATION> { using type = Knockouts<false, true, false, false>; };
+template<> struct knockouts_for<KnockoutMode::GLOBAL_MEMORY_AND_REGULATION> { using type = Knockouts<true, true, false, false>; };
+template<> struct knockouts_for<KnockoutMode::UP_REGULATION> { using type = Knockouts<false, false, true, false>; };
+template<> struct knockouts_for<KnockoutMode::DOWN_REGULATION> { using type = Knockouts<false, false, false, true>; };
+
+#endif
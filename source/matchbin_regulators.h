@@ -1,10 +1,12 @@
 #ifndef TAG_LGP_MATCH_BIN_REGULATORS_H
 #define TAG_LGP_MATCH_BIN_REGULATORS_H
 
+#include <array>
 #include <cmath>
 #include <ratio>
 #include <algorithm>
 #include <utility>
+#include <string>
 #include "emp/matchbin/MatchBin.hpp"
 #include "emp/matchbin/matchbin_regulators.hpp"
 #include "emp/math/math.hpp"
@@ -99,4 +101,88 @@ struct ExponentialCountdownRegulator : emp::RegulatorBase<double, double, double
 
 };
 
+namespace regulator_utils {
+  /// Natural log (x > 0), usable in constant expressions.
+  constexpr double ConstexprLog(double x) {
+    // Reduce to [0.5, 2), then ln(x) = 2 * atanh((x-1)/(x+1)).
+    constexpr double ln2 = 0.693147180559945309417;
+    double result = 0.0;
+    while (x >= 2.0) { x /= 2.0; result += ln2; }
+    while (x < 0.5) { x *= 2.0; result -= ln2; }
+    const double y = (x - 1.0) / (x + 1.0);
+    const double y2 = y * y;
+    double term = y;
+    for (size_t k = 1; k < 200; k += 2) {
+      result += 2.0 * term / static_cast<double>(k);
+      term *= y2;
+    }
+    return result;
+  }
+
+  /// e^x, usable in constant expressions.
+  constexpr double ConstexprExp(double x) {
+    // e^x = e^n * e^r, with integer n and |r| <= 0.5.
+    constexpr double e = 2.71828182845904523536;
+    const long n = static_cast<long>(x < 0 ? x - 0.5 : x + 0.5);
+    const double r = x - static_cast<double>(n);
+    double result = 0.0;
+    double term = 1.0;
+    for (size_t k = 1; k < 30; ++k) {
+      result += term;
+      term *= r / static_cast<double>(k);
+    }
+    for (long i = 0; i < n; ++i) result *= e;
+    for (long i = 0; i > n; --i) result /= e;
+    return result;
+  }
+}
+
+/// Exponential regulator that reads BASE^state from a precomputed (constexpr) table instead of
+/// calling std::pow on every regulated match.
+/// - For the multiplier, state is rounded to the nearest 1/RESOLUTION. The regulator's state itself
+///   (Set, Adj, Decay, View) is kept at full precision and behaves exactly as
+///   ExponentialCountdownRegulator.
+/// - Accuracy: rounding changes the exponent by at most 1/(2*RESOLUTION), so the regulated score is
+///   within a relative error of MaxRelativeError() = BASE^(1/(2*RESOLUTION)) - 1 of the
+///   ExponentialCountdownRegulator score (for the default BASE=1.1 and RESOLUTION=16: < 0.3%).
+///   Functions whose regulated scores are closer than that may be ranked differently.
+template <typename Base=std::ratio<11,10>, size_t STATE_LIMIT=100, size_t RESOLUTION=16>
+struct QuantizedExponentialCountdownRegulator : ExponentialCountdownRegulator<Base, STATE_LIMIT> {
+  using base_t = ExponentialCountdownRegulator<Base, STATE_LIMIT>;
+
+  static_assert(RESOLUTION > 0, "Quantized regulator resolution must be positive.");
+
+  static constexpr size_t TABLE_SIZE = 2 * STATE_LIMIT * RESOLUTION + 1;
+
+  /// table[i] = BASE^(min_state + i/RESOLUTION)
+  struct PowerTable {
+    std::array<double, TABLE_SIZE> values{};
+    constexpr PowerTable() {
+      const double log_base = regulator_utils::ConstexprLog(base_t::base);
+      for (size_t i = 0; i < TABLE_SIZE; ++i) {
+        const double exponent = base_t::min_state + static_cast<double>(i) / static_cast<double>(RESOLUTION);
+        values[i] = regulator_utils::ConstexprExp(exponent * log_base);
+      }
+    }
+  };
+
+  static constexpr PowerTable table{};
+
+  /// Upper bound on |quantized score - exact score| / exact score.
+  static double MaxRelativeError() {
+    return std::pow(base_t::base, 0.5 / static_cast<double>(RESOLUTION)) - 1.0;
+  }
+
+  /// Apply regulation to a raw match score.
+  double operator()(const double raw_score) const override {
+    // state is clamped to [min_state, max_state], so the index is always in range.
+    const size_t i = static_cast<size_t>((this->state - base_t::min_state) * RESOLUTION + 0.5);
+    return raw_score * table.values[i];
+  }
+
+  std::string name() const override {
+    return "Quantized Exponential Countdown Regulator";
+  }
+};
+
 #endif
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define _SIGNALGP_MUTATION_UTILS_H
 
 #include <unordered_map>
+#include <unordered_set>
 #include "emp/bits/BitSet.hpp"
 #include "emp/math/Random.hpp"
 #include "emp/math/random_utils.hpp"
@@ -74,6 +75,10 @@ protected:
 
   std::unordered_map<MUTATION_TYPES, int> last_mutation_tracker;
 
+  std::unordered_set<size_t> operand_free_inst_ids; ///< Instructions that never use their arguments or tags (e.g., Nop).
+  std::unordered_set<size_t> touched_funcs;         ///< Functions (by position) whose behavior may have changed since the last tracker reset.
+  bool func_set_changed=false;                      ///< Were functions duplicated, deleted, or re-tagged since the last tracker reset?
+
   // emp::vector<std::function<size_t(emp::Random &, program_t &)>> active_mutations;
 
 public:
@@ -94,11 +99,22 @@ public:
     last_mutation_tracker[MUTATION_TYPES::FUNC_DUP] = 0;
     last_mutation_tracker[MUTATION_TYPES::FUNC_DEL] = 0;
     last_mutation_tracker[MUTATION_TYPES::FUNC_TAG_BIT_FLIP] = 0;
+    touched_funcs.clear();
+    func_set_changed = false;
   }
 
   const std::unordered_map<MUTATION_TYPES, int> & GetLastMutations() const { return last_mutation_tracker; }
   std::unordered_map<MUTATION_TYPES, int> & GetLastMutations() { return last_mutation_tracker; }
 
+  /// Functions (by position in the pre-mutation program) with mutated instructions.
+  /// Argument/tag changes to operand-free instructions do not count.
+  const std::unordered_set<size_t> & GetTouchedFunctions() const { return touched_funcs; }
+  /// Did mutations add, remove, or re-tag functions? (if so, function positions/matches may have shifted)
+  bool GetFunctionSetChanged() const { return func_set_changed; }
+
+  /// Mark an instruction as never using its arguments or tags (changing them is always neutral).
+  void AddOperandFreeInst(size_t inst_id) { operand_free_inst_ids.emplace(inst_id); }
+
   void SetProgFunctionCntRange(const emp::Range<size_t> & val) { prog_func_cnt_range = val; }
   void SetProgFunctionInstCntRange(const emp::Range<size_t> & val) { prog_func_inst_range = val; }
   void SetProgInstArgValueRange(const emp::Range<int> & val) { prog_inst_arg_val_range = val; }
@@ -196,6 +212,8 @@ public:
     for (size_t fID = 0; fID < program.GetSize(); ++fID) {
       for (size_t iID = 0; iID < program[fID].GetSize(); ++iID) {
         inst_t & inst = program[fID][iID];
+        bool operands_changed = false;
+        bool operation_changed = false;
 
         // Mutate instruction tag(s).
         size_t tag_bf_cnt = 0;
@@ -213,16 +231,19 @@ public:
             ApplyTagSeqRandomization(rnd, tag);
             ++mut_cnt;  // Count this as only one mutation
             ++last_mutation_tracker[MUTATION_TYPES::INST_TAG_BIT_SEQ_RANDOMIZATION];
+            operands_changed = true;
           }
         }
         mut_cnt += tag_bf_cnt;
         last_mutation_tracker[MUTATION_TYPES::INST_TAG_BIT_FLIP] += tag_bf_cnt;
+        operands_changed |= (bool)tag_bf_cnt;
 
         // Mutate instruction operation.
         if (rnd.P(rate_inst_sub)) {
           inst.id = rnd.GetUInt(inst_lib.GetSize());
           ++last_mutation_tracker[MUTATION_TYPES::INST_SUB];
           ++mut_cnt;
+          operation_changed = true;
         }
 
         // Mutate instruction arguments.
@@ -232,8 +253,13 @@ public:
                                            prog_inst_arg_val_range.GetUpper()+1);
             ++mut_cnt;
             ++last_mutation_tracker[MUTATION_TYPES::INST_ARG_SUB];
+            operands_changed = true;
           }
         }
+
+        if (operation_changed || (operands_changed && !operand_free_inst_ids.count(inst.id))) {
+          touched_funcs.emplace(fID);
+        }
       }
     }
     return mut_cnt;
@@ -271,6 +297,7 @@ public:
             new_function.PushInst(sgp::GenRandInst<hardware_t, TAG_W>(rnd,inst_lib, prog_inst_num_tags, prog_inst_num_args, prog_inst_arg_val_range));
             ++mut_cnt;
             ++last_mutation_tracker[MUTATION_TYPES::INST_INS];
+            touched_funcs.emplace(fID);
             ++expected_func_len;
             ++expected_prog_len;
             ins_locs.pop_back();
@@ -281,6 +308,7 @@ public:
         if (rnd.P(rate_inst_del) && expected_func_len > prog_func_inst_range.GetLower()) {
           ++mut_cnt;
           ++last_mutation_tracker[MUTATION_TYPES::INST_DEL];
+          touched_funcs.emplace(fID);
           --expected_func_len;
           --expected_prog_len;
         } else {
@@ -320,6 +348,7 @@ public:
         program[fID] = new_function;
         ++mut_cnt;
         ++last_mutation_tracker[MUTATION_TYPES::SEQ_SLIP_DUP];
+        touched_funcs.emplace(fID);
         expected_prog_len += (size_t)dup_size;
       } else if (del && (program[fID].GetSize() - (size_t)del_size) >= prog_func_inst_range.GetLower()) {
         // Delete end:begin
@@ -331,6 +360,7 @@ public:
         program[fID] = new_function;
         ++mut_cnt;
         ++last_mutation_tracker[MUTATION_TYPES::SEQ_SLIP_DEL];
+        touched_funcs.emplace(fID);
         expected_prog_len -= (size_t)del_size;
       }
     }
@@ -355,6 +385,7 @@ public:
         expected_prog_len += program[fID].GetSize();
         ++mut_cnt;
         ++last_mutation_tracker[MUTATION_TYPES::FUNC_DUP];
+        func_set_changed = true;
       }
     }
     return mut_cnt;
@@ -375,6 +406,7 @@ public:
         program.PopFunction();
         ++mut_cnt;
         ++last_mutation_tracker[MUTATION_TYPES::FUNC_DEL];
+        func_set_changed = true;
         fID -= 1;
         continue;
       }
@@ -402,10 +434,12 @@ public:
           ApplyTagSeqRandomization(rnd, tag);
           ++mut_cnt;
           ++last_mutation_tracker[MUTATION_TYPES::FUNC_TAG_BIT_SEQ_RANDOMIZATION];
+          func_set_changed = true;
         }
       }
       mut_cnt += tag_bfs;
       last_mutation_tracker[MUTATION_TYPES::FUNC_TAG_BIT_FLIP] += tag_bfs;
+      func_set_changed |= (bool)tag_bfs;
     }
     return mut_cnt;
   }
@@ -28,7 +28,7 @@ int main(int argc, char* argv[])
   config.Write(std::cout);
   std::cout << "==============================\n" << std::endl;
 
-  BoolCalcWorld world;
+  BoolCalcWorld<> world;
   world.Setup(config);
   world.Run();
 }
\ No newline at end of file
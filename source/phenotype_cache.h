@@ -0,0 +1,139 @@
+#ifndef TAG_LGP_PHENOTYPE_CACHE_H
+#define TAG_LGP_PHENOTYPE_CACHE_H
+
+#include <functional>
+#include <iterator>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+#include "emp/base/assert.hpp"
+
+#include "hardware/SignalGP/utils/LinearFunctionsProgram.h"
+
+/// Combine hash value v into seed (boost-style).
+inline void HashCombine(size_t & seed, size_t v) {
+  seed ^= v + 0x9e3779b97f4a7c15 + (seed << 6) + (seed >> 2);
+}
+
+/// Fast structural hash of a linear functions program.
+/// Covers function tags, instruction ids, instruction tags, and instruction arguments (i.e., everything
+/// that LinearFunctionsProgram::operator== compares).
+template<typename TAG_T, typename ARG_T>
+size_t HashProgram(const sgp::LinearFunctionsProgram<TAG_T, ARG_T> & program) {
+  std::hash<TAG_T> hash_tag;
+  std::hash<ARG_T> hash_arg;
+  size_t seed = program.GetSize();
+  for (size_t func_id = 0; func_id < program.GetSize(); ++func_id) {
+    const auto & func = program[func_id];
+    HashCombine(seed, func.GetSize());
+    for (const auto & tag : func.GetTags()) HashCombine(seed, hash_tag(tag));
+    for (size_t inst_id = 0; inst_id < func.GetSize(); ++inst_id) {
+      const auto & inst = func[inst_id];
+      HashCombine(seed, inst.GetID());
+      for (const auto & tag : inst.GetTags()) HashCombine(seed, hash_tag(tag));
+      for (const auto & arg : inst.GetArgs()) HashCombine(seed, hash_arg(arg));
+    }
+  }
+  return seed;
+}
+
+/// Bounded (least-recently-used) cache that maps programs to evaluation results.
+/// - Keys are full program copies; the structural hash only picks the bucket, so hash collisions can
+///   never hand back another program's result.
+/// - A capacity of 0 disables the cache.
+/// - Not thread-safe; callers that share a cache across threads must serialize access.
+/// - Hit/miss counters are kept here but reported by callers (RecordHits/RecordMisses), in whatever
+///   unit they reuse results (e.g., whole phenotypes, or individual test scores).
+template<typename PROGRAM_T, typename VALUE_T>
+class PhenotypeCache {
+public:
+  using program_t = PROGRAM_T;
+  using value_t = VALUE_T;
+
+protected:
+  struct Entry {
+    size_t hash;
+    program_t program;
+    value_t value;
+  };
+  using entry_list_t = std::list<Entry>;
+
+  size_t capacity;
+  entry_list_t entries;  ///< Most recently used at the front.
+  std::unordered_multimap<size_t, typename entry_list_t::iterator> lookup;
+
+  size_t hits=0;    ///< Results reused from the cache (since the last ResetCounters).
+  size_t misses=0;  ///< Results computed because the cache did not have them (since the last ResetCounters).
+
+  typename entry_list_t::iterator FindEntry(const program_t & program, size_t hash) {
+    auto range = lookup.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (it->second->program == program) return it->second;
+    }
+    return entries.end();
+  }
+
+public:
+  PhenotypeCache(size_t cap=0) : capacity(cap) { ; }
+
+  size_t GetCapacity() const { return capacity; }
+  size_t GetSize() const { return entries.size(); }
+  bool IsEnabled() const { return capacity > 0; }
+
+  size_t GetHits() const { return hits; }
+  size_t GetMisses() const { return misses; }
+  void ResetCounters() { hits = 0; misses = 0; }
+  void RecordHits(size_t n=1) { hits += n; }
+  void RecordMisses(size_t n=1) { misses += n; }
+
+  /// Change cache capacity (evicting least-recently-used entries as necessary).
+  void SetCapacity(size_t cap) {
+    capacity = cap;
+    while (entries.size() > capacity) Evict();
+  }
+
+  void Clear() {
+    entries.clear();
+    lookup.clear();
+  }
+
+  /// Lookup the cached value for the given program. On a hit, copy it into value and return true.
+  bool Get(const program_t & program, size_t hash, value_t & value) {
+    auto entry_it = FindEntry(program, hash);
+    if (entry_it == entries.end()) return false;
+    entries.splice(entries.begin(), entries, entry_it); // Mark as most recently used.
+    value = entry_it->value;
+    return true;
+  }
+
+  /// Cache value for the given program (overwriting any existing value).
+  void Put(const program_t & program, size_t hash, const value_t & value) {
+    if (!capacity) return;
+    auto entry_it = FindEntry(program, hash);
+    if (entry_it != entries.end()) {
+      entry_it->value = value;
+      entries.splice(entries.begin(), entries, entry_it);
+      return;
+    }
+    if (entries.size() >= capacity) Evict();
+    entries.push_front({hash, program, value});
+    lookup.emplace(hash, entries.begin());
+  }
+
+  /// Evict the least-recently-used entry.
+  void Evict() {
+    emp_assert(entries.size());
+    auto last = std::prev(entries.end());
+    auto range = lookup.equal_range(last->hash);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (it->second == last) {
+        lookup.erase(it);
+        break;
+      }
+    }
+    entries.pop_back();
+  }
+};
+
+#endif
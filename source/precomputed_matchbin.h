@@ -0,0 +1,230 @@
+#ifndef TAG_LGP_PRECOMPUTED_MATCHBIN_H
+#define TAG_LGP_PRECOMPUTED_MATCHBIN_H
+
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+#include "emp/base/assert.hpp"
+#include "emp/base/vector.hpp"
+
+#include "block_scoring.h"
+#include "indexed_matchbin.h"
+
+/// Matchbin (e.g., emp::MatchBin) that keeps the raw match score of every query it has seen against
+/// every function tag, so matching only applies regulators.
+/// - Queries are fixed for a whole run (input/environment signal tags) or for a whole program
+///   (instruction tags), yet every match would otherwise rescore the query against every function
+///   tag. Here, a query's raw scores are computed once per program (the first time it is matched,
+///   with a single ScoreBlock call for metrics that support it) and kept until the function tags
+///   change (clearing and re-adding the same tags, as ResetMatchBin does, keeps them).
+/// - Each matchbin (i.e., each piece of hardware) owns its score table, so hardware running
+///   different programs on the same thread never evict one another's scores.
+/// - Regulators are copied into a contiguous array and re-copied only when changed (SetRegulator,
+///   AdjRegulator, DecayRegulator(s), GetRegulator).
+/// - Thresholded selectors (whose exact threshold test is the selector's to make) fall back to the
+///   wrapped matchbin.
+/// Functions are identified by uid (SignalGP uses function ids as uids). Ties go to the lower uid (as
+/// in IndexedMatchBin).
+template<typename MATCHBIN_T, typename METRIC_T, typename SELECTOR_T>
+class PrecomputedMatchBin : public MATCHBIN_T {
+public:
+  using base_t = MATCHBIN_T;
+  using uid_t = size_t;
+  using tag_t = std::decay_t<decltype(std::declval<MATCHBIN_T&>().GetTag(0))>;
+  using query_t = tag_t;
+  using regulator_t = std::decay_t<decltype(std::declval<MATCHBIN_T&>().GetRegulator(0))>;
+  using score_row_t = emp::vector<double>;  ///< Raw score by uid
+
+  static constexpr bool PRECOMPUTE = is_unthresholded_ranked_selector<SELECTOR_T>::value;
+
+protected:
+  FunctionTagScorer<METRIC_T> scorer;
+  std::unordered_map<query_t, size_t> row_ids;  ///< Query => its row in raw_scores
+  emp::vector<score_row_t> raw_scores;          ///< Rows are reused across programs.
+  size_t num_rows=0;
+  emp::vector<tag_t> tags;                      ///< Function tags currently in the matchbin (by uid).
+  emp::vector<bool> has_tag;
+  emp::vector<tag_t> scored_tags;               ///< Function tags raw_scores was computed for.
+  emp::vector<bool> scored_has_tag;
+  size_t num_tags=0;
+  bool tags_changed=true;
+  emp::vector<regulator_t> regulators;          ///< Copy of each function's regulator (by uid).
+  emp::vector<bool> regulator_changed;          ///< Has this regulator changed since it was copied?
+  emp::vector<uid_t> changed_regulators;        ///< uids with regulator_changed set
+  bool all_regulators_changed=true;
+  emp::vector<double> scores;                   ///< Scratch: regulated scores (by uid)
+  emp::vector<uid_t> ranking;                   ///< Scratch
+
+  void RecordTag(uid_t uid, const tag_t & tag) {
+    if (uid >= tags.size()) {
+      tags.resize(uid + 1);
+      has_tag.resize(uid + 1, false);
+    }
+    num_tags += !has_tag[uid];
+    tags[uid] = tag;
+    has_tag[uid] = true;
+    tags_changed = true;
+    all_regulators_changed = true;
+  }
+
+  void ChangeRegulator(uid_t uid) {
+    if (uid >= regulator_changed.size() || regulator_changed[uid]) return;
+    regulator_changed[uid] = true;
+    changed_regulators.emplace_back(uid);
+  }
+
+  /// Forget raw scores if the function tags differ from those they were computed for.
+  void SyncTags() {
+    if (!tags_changed) return;
+    tags_changed = false;
+    if (has_tag == scored_has_tag && tags == scored_tags) return;
+    scorer.Build(tags, has_tag);
+    row_ids.clear();
+    num_rows = 0;
+    scored_tags = tags;
+    scored_has_tag = has_tag;
+  }
+
+  void SyncRegulators() {
+    if (all_regulators_changed) {
+      all_regulators_changed = false;
+      regulators.resize(has_tag.size());
+      regulator_changed.assign(has_tag.size(), false);
+      changed_regulators.clear();
+      for (uid_t uid = 0; uid < has_tag.size(); ++uid) {
+        if (has_tag[uid]) regulators[uid] = base_t::GetRegulator(uid);
+      }
+      return;
+    }
+    for (uid_t uid : changed_regulators) {
+      if (has_tag[uid]) regulators[uid] = base_t::GetRegulator(uid);
+      regulator_changed[uid] = false;
+    }
+    changed_regulators.clear();
+  }
+
+  /// Raw scores of query against every function (computed if query has not been seen with these tags).
+  const score_row_t & GetRow(const query_t & query) {
+    auto it = row_ids.find(query);
+    if (it != row_ids.end()) return raw_scores[it->second];
+    if (num_rows == raw_scores.size()) raw_scores.emplace_back();
+    score_row_t & row = raw_scores[num_rows];
+    row.resize(has_tag.size());
+    scorer.Score(query, row.data());
+    row_ids.emplace(query, num_rows++);
+    return row;
+  }
+
+  /// The (up to) n functions with the lowest scores (ties to the lower uid).
+  emp::vector<uid_t> Select(const emp::vector<double> & by_uid, size_t n) {
+    if (n == 1) {
+      uid_t best_uid = std::numeric_limits<uid_t>::max();
+      for (uid_t uid = 0; uid < has_tag.size(); ++uid) {
+        if (!has_tag[uid]) continue;
+        if (best_uid == std::numeric_limits<uid_t>::max() || by_uid[uid] < by_uid[best_uid]) best_uid = uid;
+      }
+      if (best_uid == std::numeric_limits<uid_t>::max()) return {};
+      return {best_uid};
+    }
+    ranking.clear();
+    for (uid_t uid = 0; uid < has_tag.size(); ++uid) {
+      if (has_tag[uid]) ranking.emplace_back(uid);
+    }
+    const size_t count = std::min(n, ranking.size());
+    std::partial_sort(ranking.begin(), ranking.begin() + count, ranking.end(),
+                      [&by_uid](uid_t a, uid_t b) { return std::make_pair(by_uid[a], a) < std::make_pair(by_uid[b], b); });
+    return emp::vector<uid_t>(ranking.begin(), ranking.begin() + count);
+  }
+
+  /// Can raw scores answer matches? (Only if the matchbin's uids are exactly those recorded.)
+  bool UseRows() const { return PRECOMPUTE && num_tags == base_t::Size(); }
+
+public:
+  template <typename... Ts>
+  PrecomputedMatchBin(Ts &&... args) : base_t(std::forward<Ts>(args)...) { ; }
+
+  /// Find the (up to) n best regulated matches for query.
+  emp::vector<uid_t> Match(const query_t & query, size_t n=1) {
+    if (!UseRows()) return base_t::Match(query, n);
+    SyncTags();
+    SyncRegulators();
+    const score_row_t & row = GetRow(query);
+    scores.resize(has_tag.size());
+    for (uid_t uid = 0; uid < has_tag.size(); ++uid) {
+      if (has_tag[uid]) scores[uid] = regulators[uid](row[uid]);
+    }
+    return Select(scores, n);
+  }
+
+  /// Find the (up to) n best raw (unregulated) matches for query.
+  emp::vector<uid_t> MatchRaw(const query_t & query, size_t n=1) {
+    if (!UseRows()) return base_t::MatchRaw(query, n);
+    SyncTags();
+    return Select(GetRow(query), n);
+  }
+
+  template <typename T>
+  void SetRegulator(const uid_t uid, const T & set) {
+    base_t::SetRegulator(uid, set);
+    ChangeRegulator(uid);
+  }
+
+  template <typename T>
+  void AdjRegulator(const uid_t uid, const T & amt) {
+    base_t::AdjRegulator(uid, amt);
+    ChangeRegulator(uid);
+  }
+
+  void DecayRegulator(const uid_t uid, const int steps) {
+    base_t::DecayRegulator(uid, steps);
+    ChangeRegulator(uid);
+  }
+
+  void DecayRegulators(const int steps=1) {
+    base_t::DecayRegulators(steps);
+    all_regulators_changed = true;
+  }
+
+  /// Access uid's regulator. Callers may change it, so it is re-copied before the next match.
+  decltype(auto) GetRegulator(const uid_t uid) {
+    ChangeRegulator(uid);
+    return base_t::GetRegulator(uid);
+  }
+
+  template <typename V>
+  uid_t Put(const V & v, const tag_t & tag) {
+    const uid_t uid = base_t::Put(v, tag);
+    RecordTag(uid, tag);
+    return uid;
+  }
+
+  template <typename V>
+  void Set(const V & v, const tag_t & tag, const uid_t uid) {
+    base_t::Set(v, tag, uid);
+    RecordTag(uid, tag);
+  }
+
+  void Delete(const uid_t uid) {
+    base_t::Delete(uid);
+    if (uid < has_tag.size() && has_tag[uid]) {
+      has_tag[uid] = false;
+      --num_tags;
+    }
+    tags_changed = true;
+    all_regulators_changed = true;
+  }
+
+  void Clear() {
+    base_t::Clear();
+    tags.clear();
+    has_tag.clear();
+    num_tags = 0;
+    tags_changed = true;
+    all_regulators_changed = true;
+  }
+};
+
+#endif
@@ -0,0 +1,106 @@
+#ifndef TAG_LGP_REACHABILITY_UTILS_H
+#define TAG_LGP_REACHABILITY_UTILS_H
+
+#include <algorithm>
+#include <limits>
+#include <unordered_set>
+
+#include "emp/base/assert.hpp"
+#include "emp/base/vector.hpp"
+
+/// Static analysis of which functions in a SignalGP program could ever run.
+/// - A function runs only if it is selected by an externally-triggered tag (e.g., an input signal)
+///   or by the tag of a control flow instruction (Call, Fork, Routine) in a reachable function.
+/// - Regulation can reorder matches: a regulated function may win any query (or pass any
+///   threshold), so we treat regulated functions as candidates for every query. Unregulated
+///   functions keep their raw rank, so only the best-matching (admissible) ones are candidates.
+/// - Which functions are regulated depends on which regulator instructions are reachable (and vice
+///   versa), so we iterate to a fixed point.
+/// The analysis is conservative: it never reports a function as unreachable if it could run.
+template<typename HARDWARE_T, typename TAG_T, typename METRIC_T>
+class ReachabilityAnalysis {
+public:
+  using hardware_t = HARDWARE_T;
+  using program_t = typename hardware_t::program_t;
+  using tag_t = TAG_T;
+  using metric_t = METRIC_T;
+
+protected:
+  metric_t metric;
+  std::unordered_set<size_t> flow_inst_ids;     ///< Instructions that use their tag to run a function (e.g., Call).
+  std::unordered_set<size_t> reg_inst_ids;      ///< Instructions that use their tag to regulate a function.
+  std::unordered_set<size_t> own_reg_inst_ids;  ///< Instructions that regulate the function they are in.
+
+  /// Which functions could the given tag select (given which functions could be regulated)?
+  /// Marks candidates in selected, returns whether anything new was marked.
+  bool MarkCandidates(hardware_t & hw,
+                      const tag_t & tag,
+                      const emp::vector<bool> & regulated,
+                      emp::vector<bool> & selected)
+  {
+    const program_t & program = hw.GetProgram();
+    bool changed = false;
+    // Regulated functions could be selected by anything.
+    for (size_t func_id = 0; func_id < program.GetSize(); ++func_id) {
+      if (regulated[func_id] && !selected[func_id]) {
+        selected[func_id] = true;
+        changed = true;
+      }
+    }
+    // Otherwise, only the best (raw) admissible unregulated matches could be selected.
+    // MatchRaw applies the matchbin's selector (i.e., match threshold) without regulation.
+    const auto admissible = hw.GetMatchBin().MatchRaw(tag, program.GetSize());
+    double best = std::numeric_limits<double>::max();
+    for (size_t func_id : admissible) {
+      if (regulated[func_id]) continue;
+      best = std::min(best, metric(tag, program[func_id].GetTags()[0]));
+    }
+    for (size_t func_id : admissible) {
+      if (regulated[func_id] || selected[func_id]) continue;
+      if (metric(tag, program[func_id].GetTags()[0]) == best) {
+        selected[func_id] = true;
+        changed = true;
+      }
+    }
+    return changed;
+  }
+
+public:
+  void AddFlowInst(size_t inst_id) { flow_inst_ids.emplace(inst_id); }
+  void AddRegulatorInst(size_t inst_id) { reg_inst_ids.emplace(inst_id); }
+  void AddOwnRegulatorInst(size_t inst_id) { own_reg_inst_ids.emplace(inst_id); }
+
+  /// Find reachable functions for the program currently loaded on hw, given the tags that trigger
+  /// threads from outside of the program (e.g., input signal tags).
+  emp::vector<bool> FindReachable(hardware_t & hw, const emp::vector<tag_t> & entry_tags) {
+    const program_t & program = hw.GetProgram();
+    emp::vector<bool> reachable(program.GetSize(), false);
+    emp::vector<bool> regulated(program.GetSize(), false);
+    bool changed = true;
+    while (changed) {
+      changed = false;
+      for (const tag_t & tag : entry_tags) {
+        changed |= MarkCandidates(hw, tag, regulated, reachable);
+      }
+      for (size_t func_id = 0; func_id < program.GetSize(); ++func_id) {
+        if (!reachable[func_id]) continue;
+        for (size_t inst_pos = 0; inst_pos < program[func_id].GetSize(); ++inst_pos) {
+          const auto & inst = program[func_id][inst_pos];
+          if (own_reg_inst_ids.count(inst.GetID())) {
+            changed |= !regulated[func_id];
+            regulated[func_id] = true;
+          }
+          if (inst.GetTags().empty()) continue;
+          if (flow_inst_ids.count(inst.GetID())) {
+            changed |= MarkCandidates(hw, inst.GetTags()[0], regulated, reachable);
+          } else if (reg_inst_ids.count(inst.GetID())) {
+            changed |= MarkCandidates(hw, inst.GetTags()[0], regulated, regulated);
+          }
+        }
+      }
+    }
+    return reachable;
+  }
+};
+
+#endif
@@ -0,0 +1,98 @@
+#ifndef TAG_LGP_SELECTION_UTILS_H
+#define TAG_LGP_SELECTION_UTILS_H
+
+#include <algorithm>
+#include <map>
+#include <numeric>
+#include <utility>
+
+#include "emp/base/assert.hpp"
+#include "emp/base/vector.hpp"
+#include "emp/math/Random.hpp"
+#include "emp/math/random_utils.hpp"
+
+/// Lexicase selection where test scores are requested as selection needs them.
+/// - get_score(org_id, test_id) returns an organism's score on the given test.
+/// - prepare_scores(org_ids, test_id) is called before get_score is used on the given (still
+///   competing) organisms for test_id. Callers that evaluate lazily compute any missing scores here
+///   (all at once, so evaluation can be batched); callers with precomputed scores pass a no-op.
+/// Selection follows emp::LexicaseSelect step for step: organisms with the same genome compete as a
+/// single genotype (only its first organism is scored), each selection event draws one permutation
+/// of the tests and one survivor. Given the same scores, it therefore draws the same random numbers
+/// and selects exactly the same parents as emp::LexicaseSelect.
+template<typename WORLD_T, typename GET_SCORE_FUN_T, typename PREP_SCORES_FUN_T>
+void LexicaseSelect_Lazy(WORLD_T & world,
+                         size_t num_tests,
+                         size_t repro_count,
+                         GET_SCORE_FUN_T get_score,
+                         PREP_SCORES_FUN_T prepare_scores)
+{
+  using genome_t = typename WORLD_T::genome_t;
+  emp_assert(world.GetSize() > 0);
+  emp_assert(num_tests > 0);
+
+  // Group organisms by genotype.
+  std::map<genome_t, size_t> genotype_ids;
+  emp::vector<emp::vector<size_t>> genotype_orgs;
+  for (size_t org_id = 0; org_id < world.GetSize(); ++org_id) {
+    if (!world.IsOccupied(org_id)) continue;
+    const genome_t & genome = world.GetGenomeAt(org_id);
+    auto genotype_it = genotype_ids.find(genome);
+    if (genotype_it == genotype_ids.end()) {
+      genotype_ids.emplace(genome, genotype_orgs.size());
+      genotype_orgs.emplace_back(emp::vector<size_t>{org_id});
+    } else {
+      genotype_orgs[genotype_it->second].emplace_back(org_id);
+    }
+  }
+  emp::vector<size_t> all_gens(genotype_orgs.size());
+  std::iota(all_gens.begin(), all_gens.end(), 0);
+  emp::vector<size_t> cur_gens;
+  emp::vector<size_t> next_gens;
+  emp::vector<size_t> cur_orgs;  ///< First organism of each genotype in cur_gens.
+
+  for (size_t repro = 0; repro < repro_count; ++repro) {
+    // Determine the test ordering for this selection event.
+    const emp::vector<size_t> order = emp::GetPermutation(world.GetRandom(), num_tests);
+    // Step through the tests, keeping only the elite at each step.
+    cur_gens = all_gens;
+    for (size_t test_id : order) {
+      cur_orgs.clear();
+      for (size_t gen_id : cur_gens) cur_orgs.emplace_back(genotype_orgs[gen_id][0]);
+      prepare_scores(cur_orgs, test_id);
+      double max_score = get_score(cur_orgs[0], test_id);
+      next_gens.emplace_back(cur_gens[0]);
+      // As in emp::LexicaseSelect, the first genotype is also compared against itself (it stays in
+      // next_gens twice if it ties the best score).
+      for (size_t i = 0; i < cur_gens.size(); ++i) {
+        const double score = get_score(cur_orgs[i], test_id);
+        if (score > max_score) {
+          max_score = score;
+          next_gens.clear();
+          next_gens.emplace_back(cur_gens[i]);
+        } else if (score == max_score) {
+          next_gens.emplace_back(cur_gens[i]);
+        }
+      }
+      std::swap(cur_gens, next_gens);
+      next_gens.clear();
+      if (cur_gens.size() == 1) break;
+    }
+    // Place a random survivor (all equal) into the next generation.
+    emp_assert(cur_gens.size() > 0);
+    size_t options = 0;
+    for (size_t gen_id : cur_gens) options += genotype_orgs[gen_id].size();
+    size_t winner = world.GetRandom().GetUInt(options);
+    size_t repro_id = 0;
+    for (size_t gen_id : cur_gens) {
+      if (winner < genotype_orgs[gen_id].size()) {
+        repro_id = genotype_orgs[gen_id][winner];
+        break;
+      }
+      winner -= genotype_orgs[gen_id].size();
+    }
+    world.DoBirth(world.GetGenomeAt(repro_id), repro_id, 1);
+  }
+}
+
+#endif
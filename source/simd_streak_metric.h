@@ -0,0 +1,233 @@
+#ifndef TAG_LGP_SIMD_STREAK_METRIC_H
+#define TAG_LGP_SIMD_STREAK_METRIC_H
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+// x86 builds without -mavx2 still compile the AVX2 kernel (for that function only) and use it when
+// the CPU running the program supports AVX2.
+#if !defined(__AVX2__) && (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define TAG_LGP_STREAK_RUNTIME_AVX2
+#define TAG_LGP_STREAK_AVX2_TARGET __attribute__((target("avx2")))
+#else
+#define TAG_LGP_STREAK_AVX2_TARGET
+#endif
+
+#if defined(__AVX2__) || defined(__SSE2__) || defined(TAG_LGP_STREAK_RUNTIME_AVX2)
+#include <immintrin.h>
+#endif
+
+#include "emp/base/assert.hpp"
+#include "emp/bits/BitSet.hpp"
+#include "emp/matchbin/matchbin_metrics.hpp"
+
+#include "tag_store.h"
+
+/// Longest-streak kernels used by SimdStreakMetric (over tags packed with PackTag).
+/// The longest run of ones is found by repeatedly AND-ing a bit string with itself shifted by one
+/// (as emp::BitSet::LongestSegmentOnes does); the number of steps until it is empty is the longest run.
+/// 256-bit tags use AVX2 (one register per tag) when the build enables it (e.g., -mavx2 or
+/// -march=native) or, on other x86 builds, when the CPU supports it (checked once at runtime);
+/// otherwise they use SSE2 (two registers per tag). Every other configuration uses the scalar kernel.
+template<size_t WIDTH>
+struct StreakKernel {
+  static constexpr size_t NUM_WORDS = TagWordCount<WIDTH>();
+  static constexpr uint64_t LAST_WORD_MASK = TagLastWordMask<WIDTH>();
+  using packed_t = packed_tag_t<WIDTH>;
+
+  /// Longest streaks of matching (same) and mismatching (different) bits between a and b.
+  static void LongestStreaks(const packed_t & a, const packed_t & b, size_t & same, size_t & different) {
+    if constexpr (WIDTH == 256) {
+      #if defined(__AVX2__)
+      LongestStreaks_AVX2(a, b, same, different);
+      return;
+      #else
+      #if defined(TAG_LGP_STREAK_RUNTIME_AVX2)
+      if (HasAVX2()) { LongestStreaks_AVX2(a, b, same, different); return; }
+      #endif
+      #if defined(__SSE2__)
+      LongestStreaks_SSE2(a, b, same, different);
+      return;
+      #endif
+      #endif
+    }
+    LongestStreaks_Scalar(a, b, same, different);
+  }
+
+  /// Can this program run the AVX2 kernel?
+  static bool HasAVX2() {
+    #if defined(__AVX2__)
+    return true;
+    #elif defined(TAG_LGP_STREAK_RUNTIME_AVX2)
+    static const bool has_avx2 = __builtin_cpu_supports("avx2");
+    return has_avx2;
+    #else
+    return false;
+    #endif
+  }
+
+  static void LongestStreaks_Scalar(const packed_t & a, const packed_t & b, size_t & same, size_t & different) {
+    packed_t s;
+    packed_t d;
+    for (size_t i = 0; i < NUM_WORDS; ++i) {
+      d[i] = a[i] ^ b[i];
+      s[i] = ~d[i];
+    }
+    s[NUM_WORDS - 1] &= LAST_WORD_MASK;
+    d[NUM_WORDS - 1] &= LAST_WORD_MASK;
+    same = 0;
+    different = 0;
+    while (true) {
+      const bool s_any = Any(s);
+      const bool d_any = Any(d);
+      if (!(s_any || d_any)) break;
+      same += s_any;
+      different += d_any;
+      AndShifted(s);
+      AndShifted(d);
+    }
+  }
+
+  #if defined(__AVX2__) || defined(TAG_LGP_STREAK_RUNTIME_AVX2)
+  /// Shift a 256-bit value left by one bit (across 64-bit lanes).
+  TAG_LGP_STREAK_AVX2_TARGET static __m256i ShiftLeft1(__m256i x) {
+    // Lane i receives the top bit of lane i-1; lane 0 receives nothing.
+    const __m256i carry = _mm256_srli_epi64(_mm256_permute4x64_epi64(x, _MM_SHUFFLE(2, 1, 0, 3)), 63);
+    return _mm256_or_si256(_mm256_slli_epi64(x, 1),
+                           _mm256_blend_epi32(carry, _mm256_setzero_si256(), 0x03));
+  }
+
+  TAG_LGP_STREAK_AVX2_TARGET static void LongestStreaks_AVX2(const packed_t & a, const packed_t & b, size_t & same, size_t & different) {
+    static_assert(WIDTH == 256, "AVX2 streak kernel requires 256-bit tags.");
+    __m256i d = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a.data())),
+                                 _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b.data())));
+    __m256i s = _mm256_xor_si256(d, _mm256_set1_epi64x(-1));
+    same = 0;
+    different = 0;
+    while (true) {
+      const bool s_any = !_mm256_testz_si256(s, s);
+      const bool d_any = !_mm256_testz_si256(d, d);
+      if (!(s_any || d_any)) break;
+      same += s_any;
+      different += d_any;
+      s = _mm256_and_si256(s, ShiftLeft1(s));
+      d = _mm256_and_si256(d, ShiftLeft1(d));
+    }
+  }
+  #endif
+
+  #if defined(__SSE2__)
+  /// Shift a 256-bit value (held as low and high 128-bit halves) left by one bit.
+  static void ShiftLeft1(__m128i & lo, __m128i & hi) {
+    const __m128i lo_carry = _mm_srli_epi64(_mm_srli_si128(lo, 8), 63);   // top bit of lo -> bit 0 of hi
+    lo = _mm_or_si128(_mm_slli_epi64(lo, 1), _mm_srli_epi64(_mm_slli_si128(lo, 8), 63));
+    hi = _mm_or_si128(_mm_or_si128(_mm_slli_epi64(hi, 1), _mm_srli_epi64(_mm_slli_si128(hi, 8), 63)), lo_carry);
+  }
+
+  static bool Any(__m128i lo, __m128i hi) {
+    const __m128i both = _mm_or_si128(lo, hi);
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(both, _mm_setzero_si128())) != 0xFFFF;
+  }
+
+  static void LongestStreaks_SSE2(const packed_t & a, const packed_t & b, size_t & same, size_t & different) {
+    static_assert(WIDTH == 256, "SSE2 streak kernel requires 256-bit tags.");
+    const __m128i ones = _mm_set1_epi64x(-1);
+    __m128i d_lo = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a.data())),
+                                 _mm_loadu_si128(reinterpret_cast<const __m128i*>(b.data())));
+    __m128i d_hi = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a.data() + 2)),
+                                 _mm_loadu_si128(reinterpret_cast<const __m128i*>(b.data() + 2)));
+    __m128i s_lo = _mm_xor_si128(d_lo, ones);
+    __m128i s_hi = _mm_xor_si128(d_hi, ones);
+    same = 0;
+    different = 0;
+    while (true) {
+      const bool s_any = Any(s_lo, s_hi);
+      const bool d_any = Any(d_lo, d_hi);
+      if (!(s_any || d_any)) break;
+      same += s_any;
+      different += d_any;
+      __m128i s_lo_shift = s_lo, s_hi_shift = s_hi;
+      __m128i d_lo_shift = d_lo, d_hi_shift = d_hi;
+      ShiftLeft1(s_lo_shift, s_hi_shift);
+      ShiftLeft1(d_lo_shift, d_hi_shift);
+      s_lo = _mm_and_si128(s_lo, s_lo_shift);
+      s_hi = _mm_and_si128(s_hi, s_hi_shift);
+      d_lo = _mm_and_si128(d_lo, d_lo_shift);
+      d_hi = _mm_and_si128(d_hi, d_hi_shift);
+    }
+  }
+  #endif
+
+protected:
+  static bool Any(const packed_t & words) {
+    uint64_t any = 0;
+    for (uint64_t w : words) any |= w;
+    return any;
+  }
+
+  /// words &= (words << 1), dropping bits shifted past WIDTH.
+  static void AndShifted(packed_t & words) {
+    uint64_t carry = 0;
+    for (size_t i = 0; i < NUM_WORDS; ++i) {
+      const uint64_t next_carry = words[i] >> 63;
+      words[i] &= (words[i] << 1) | carry;
+      carry = next_carry;
+    }
+    words[NUM_WORDS - 1] &= LAST_WORD_MASK;
+  }
+};
+
+/// Drop-in replacement for emp::StreakMetric that computes streaks with StreakKernel.
+/// Scores are exactly those of emp::StreakMetric. ScoreBlock scores one query against a contiguous
+/// block of packed tags in a single call.
+template<size_t WIDTH>
+struct SimdStreakMetric : public emp::StreakMetric<WIDTH> {
+  using base_t = emp::StreakMetric<WIDTH>;
+  using query_t = typename base_t::query_t;
+  using tag_t = typename base_t::tag_t;
+  using kernel_t = StreakKernel<WIDTH>;
+  using packed_t = packed_tag_t<WIDTH>;
+  using tag_store_t = PackedTagStore<WIDTH>;
+
+protected:
+  /// Probability of a k-bit streak (up to the numerator, which cancels), indexed by k.
+  /// Same expression as emp::StreakMetric, so scores are bit-for-bit identical.
+  struct ProbabilityTable {
+    std::array<double, WIDTH + 1> probs;
+    ProbabilityTable() {
+      for (size_t k = 0; k <= WIDTH; ++k) probs[k] = (WIDTH - k + 1) / std::pow(2, k);
+    }
+  };
+
+  static const ProbabilityTable & GetProbabilities() {
+    static const ProbabilityTable table;
+    return table;
+  }
+
+  static double Score(const packed_t & a, const packed_t & b) {
+    size_t same = 0;
+    size_t different = 0;
+    kernel_t::LongestStreaks(a, b, same, different);
+    const auto & probs = GetProbabilities().probs;
+    const double ps = probs[same];
+    const double pd = probs[different];
+    const double match = pd / (ps + pd);
+    return 1.0 - match;
+  }
+
+public:
+  std::string base() const override { return "SIMD Streak Metric"; }
+
+  double operator()(const query_t & a, const tag_t & b) const override {
+    return Score(PackTag<WIDTH>(a), PackTag<WIDTH>(b));
+  }
+
+  /// Score query against every tag in tags, writing results into scores.
+  void ScoreBlock(const query_t & query, const tag_store_t & tags, double * scores) const {
+    const packed_t packed_query = PackTag<WIDTH>(query);
+    for (size_t i = 0; i < tags.GetSize(); ++i) scores[i] = Score(packed_query, tags[i]);
+  }
+};
+
+#endif
@@ -0,0 +1,278 @@
+#ifndef TAG_LGP_TAG_INDEX_H
+#define TAG_LGP_TAG_INDEX_H
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include "emp/base/assert.hpp"
+#include "emp/base/vector.hpp"
+#include "emp/bits/BitSet.hpp"
+#include "emp/matchbin/matchbin_metrics.hpp"
+
+#include "tag_store.h"
+#include "indexed_matchbin.h"
+
+/// Nearest-tag indexes: find a query's best (lowest score) raw match without going through the
+/// matchbin's full scoring and ranking. Each index answers exactly what a scan would (best score;
+/// ties go to the lower uid).
+/// - WrapTagIndex (integer metrics): tags sorted as integers; the best match is next to the query's
+///   position in sorted (circular) order, so lookups are O(log num functions).
+/// - HammingTagIndex (Hamming metric): packed popcount scan (see below).
+/// Metrics without a usable structure (e.g., streak metrics) have no index (see tag_index_for).
+
+/// Is packed tag a < packed tag b (as unsigned integers)?
+template<size_t WIDTH>
+bool PackedTagLess(const packed_tag_t<WIDTH> & a, const packed_tag_t<WIDTH> & b) {
+  return std::lexicographical_compare(a.rbegin(), a.rend(), b.rbegin(), b.rend());
+}
+
+/// Index for emp's (a)symmetric wrap metrics.
+template<typename METRIC_T, size_t WIDTH, bool SYMMETRIC>
+class WrapTagIndex {
+public:
+  using tag_t = emp::BitSet<WIDTH>;
+  using uid_t = size_t;
+
+protected:
+  METRIC_T metric;
+  emp::vector<packed_tag_t<WIDTH>> sorted_tags;
+  emp::vector<uid_t> sorted_uids;
+  emp::vector<tag_t> sorted_bitsets;
+
+  double Score(const tag_t & query, size_t pos) const { return metric(query, sorted_bitsets[pos]); }
+
+public:
+  void Build(const emp::vector<tag_t> & tags, const emp::vector<bool> & has_tag) {
+    emp::vector<size_t> order;
+    emp::vector<packed_tag_t<WIDTH>> packed(tags.size());
+    for (uid_t uid = 0; uid < tags.size(); ++uid) {
+      if (!has_tag[uid]) continue;
+      packed[uid] = PackTag<WIDTH>(tags[uid]);
+      order.emplace_back(uid);
+    }
+    std::stable_sort(order.begin(), order.end(),
+                     [&packed](uid_t a, uid_t b) { return PackedTagLess<WIDTH>(packed[a], packed[b]); });
+    sorted_tags.clear();
+    sorted_uids.clear();
+    sorted_bitsets.clear();
+    for (uid_t uid : order) {
+      sorted_tags.emplace_back(packed[uid]);
+      sorted_uids.emplace_back(uid);
+      sorted_bitsets.emplace_back(tags[uid]);
+    }
+  }
+
+  /// Best raw match for query (uid), or false if the index is empty.
+  bool FindBest(const tag_t & query, uid_t & best_uid) const {
+    const size_t count = sorted_uids.size();
+    if (!count) return false;
+    // First tag >= query (wrapping to the smallest tag).
+    const auto packed_query = PackTag<WIDTH>(query);
+    size_t next = std::lower_bound(sorted_tags.begin(), sorted_tags.end(), packed_query, PackedTagLess<WIDTH>)
+                  - sorted_tags.begin();
+    if (next == count) next = 0;
+    // Scores never decrease walking away from the query's position (upward for the asymmetric
+    // metric; both ways for the symmetric one), so the best score is at one of the two neighbors.
+    // Walk outward while scores tie to apply the lowest-uid tie break.
+    const size_t prev = (next + count - 1) % count;
+    double best = Score(query, next);
+    if constexpr (SYMMETRIC) best = std::min(best, Score(query, prev));
+    best_uid = std::numeric_limits<uid_t>::max();
+    for (size_t i = 0, pos = next; i < count && Score(query, pos) == best; ++i, pos = (pos + 1) % count) {
+      best_uid = std::min(best_uid, sorted_uids[pos]);
+    }
+    if constexpr (SYMMETRIC) {
+      for (size_t i = 0, pos = prev; i < count && Score(query, pos) == best; ++i, pos = (pos + count - 1) % count) {
+        best_uid = std::min(best_uid, sorted_uids[pos]);
+      }
+    }
+    emp_assert(best_uid != std::numeric_limits<uid_t>::max());
+    return true;
+  }
+};
+
+/// Index for emp's Hamming metric.
+/// Hamming nearest-neighbor structures (BK-trees, bit-sampling LSH) do not prune for tags like ours
+/// (wide and spread out: a BK-tree over 256 random 256-bit tags visits nearly every node), so this
+/// "index" is an exact packed popcount scan over a structure-of-arrays tag store. It still avoids
+/// scoring through the matchbin (metric calls, ranking every function) for top-1 lookups.
+template<size_t WIDTH>
+class HammingTagIndex {
+public:
+  using tag_t = emp::BitSet<WIDTH>;
+  using uid_t = size_t;
+
+protected:
+  SoATagStore<WIDTH> tag_store;
+  emp::vector<uid_t> uids;  ///< uid of each tag in tag_store (increasing)
+  mutable emp::vector<uint32_t> distances;
+
+public:
+  void Build(const emp::vector<tag_t> & tags, const emp::vector<bool> & has_tag) {
+    tag_store.Clear();
+    uids.clear();
+    for (uid_t uid = 0; uid < tags.size(); ++uid) {
+      if (!has_tag[uid]) continue;
+      tag_store.Add(tags[uid]);
+      uids.emplace_back(uid);
+    }
+  }
+
+  /// Best raw match for query (uid), or false if the index is empty.
+  bool FindBest(const tag_t & query, uid_t & best_uid) const {
+    constexpr size_t NUM_WORDS = TagWordCount<WIDTH>();
+    const size_t count = uids.size();
+    if (!count) return false;
+    const auto packed_query = PackTag<WIDTH>(query);
+    distances.assign(count, 0);
+    for (size_t k = 0; k < NUM_WORDS; ++k) {
+      const uint64_t * tag_words = tag_store.GetWords(k);
+      const uint64_t q = packed_query[k];
+      for (size_t i = 0; i < count; ++i) {
+        distances[i] += static_cast<uint32_t>(__builtin_popcountll(tag_words[i] ^ q));
+      }
+    }
+    // uids are increasing, so the first minimum has the lowest uid.
+    best_uid = uids[std::min_element(distances.begin(), distances.end()) - distances.begin()];
+    return true;
+  }
+};
+
+/// Number of bits in a tag type.
+template<typename TAG_T>
+struct tag_width;
+
+template<size_t WIDTH>
+struct tag_width<emp::BitSet<WIDTH>> { static constexpr size_t value = WIDTH; };
+
+/// Tag index type for a metric (void if the metric has none). Looks through metric wrappers that
+/// derive from emp's metrics (e.g., BatchHammingMetric).
+template<typename METRIC_T, size_t WIDTH=tag_width<typename METRIC_T::tag_t>::value>
+struct tag_index_for {
+  using type =
+    std::conditional_t<std::is_base_of<emp::HammingMetric<WIDTH>, METRIC_T>::value,
+      HammingTagIndex<WIDTH>,
+    std::conditional_t<std::is_base_of<emp::AsymmetricWrapMetric<WIDTH>, METRIC_T>::value,
+      WrapTagIndex<emp::AsymmetricWrapMetric<WIDTH>, WIDTH, false>,
+    std::conditional_t<std::is_base_of<emp::SymmetricWrapMetric<WIDTH>, METRIC_T>::value,
+      WrapTagIndex<emp::SymmetricWrapMetric<WIDTH>, WIDTH, true>,
+      void
+    >>>;
+};
+
+/// Matchbin (e.g., emp::MatchBin or IndexedMatchBin) that answers top-1 matches with a tag index.
+/// - The index is rebuilt when the function tags change (i.e., once per program: clearing and
+///   re-adding the same tags, as ResetMatchBin does, keeps it).
+/// - MatchRaw(query, 1) is answered by the index. Match(query, 1) is answered by the index while
+///   every regulator is neutral (regulated scores then rank exactly as raw scores).
+/// - Everything else falls back to the wrapped matchbin's exact scan: n > 1, active regulators, and
+///   thresholded selectors (whose exact threshold test is the selector's to make).
+/// Ties go to the lower uid (as in IndexedMatchBin).
+template<typename MATCHBIN_T, typename TAG_INDEX_T, typename SELECTOR_T>
+class TagIndexMatchBin : public MATCHBIN_T {
+public:
+  using base_t = MATCHBIN_T;
+  using uid_t = size_t;
+  using tag_t = std::decay_t<decltype(std::declval<MATCHBIN_T&>().GetTag(0))>;
+  using query_t = tag_t;
+  using regulator_t = std::decay_t<decltype(std::declval<MATCHBIN_T&>().GetRegulator(0))>;
+
+  static_assert(!std::is_void<TAG_INDEX_T>::value, "No tag index for this matchbin metric (see tag_index_for).");
+
+  static constexpr bool EXACT_TOP1 = is_unthresholded_ranked_selector<SELECTOR_T>::value;
+
+protected:
+  TAG_INDEX_T tag_index;
+  emp::vector<tag_t> tags;          ///< Function tags currently in the matchbin (by uid).
+  emp::vector<bool> has_tag;
+  emp::vector<tag_t> index_tags;    ///< Function tags the index was built with.
+  emp::vector<bool> index_has_tag;
+  size_t num_tags=0;
+  bool tags_changed=true;
+
+  void RecordTag(uid_t uid, const tag_t & tag) {
+    if (uid >= tags.size()) {
+      tags.resize(uid + 1);
+      has_tag.resize(uid + 1, false);
+    }
+    num_tags += !has_tag[uid];
+    tags[uid] = tag;
+    has_tag[uid] = true;
+    tags_changed = true;
+  }
+
+  void SyncIndex() {
+    if (!tags_changed) return;
+    tags_changed = false;
+    if (has_tag == index_has_tag && tags == index_tags) return;
+    tag_index.Build(tags, has_tag);
+    index_tags = tags;
+    index_has_tag = has_tag;
+  }
+
+  bool RegulatorsNeutral() {
+    const double neutral = regulator_t().View();
+    for (uid_t uid = 0; uid < has_tag.size(); ++uid) {
+      if (has_tag[uid] && base_t::ViewRegulator(uid) != neutral) return false;
+    }
+    return true;
+  }
+
+  /// Can the index answer this match? (Only if the matchbin's uids are exactly those recorded.)
+  bool UseIndex(size_t n) const { return EXACT_TOP1 && n == 1 && num_tags == base_t::Size(); }
+
+public:
+  template <typename... Ts>
+  TagIndexMatchBin(Ts &&... args) : base_t(std::forward<Ts>(args)...) { ; }
+
+  emp::vector<uid_t> MatchRaw(const query_t & query, size_t n=1) {
+    if (!UseIndex(n)) return base_t::MatchRaw(query, n);
+    SyncIndex();
+    uid_t best_uid = 0;
+    if (!tag_index.FindBest(query, best_uid)) return {};
+    return {best_uid};
+  }
+
+  emp::vector<uid_t> Match(const query_t & query, size_t n=1) {
+    if (!UseIndex(n) || !RegulatorsNeutral()) return base_t::Match(query, n);
+    SyncIndex();
+    uid_t best_uid = 0;
+    if (!tag_index.FindBest(query, best_uid)) return {};
+    return {best_uid};
+  }
+
+  template <typename V>
+  uid_t Put(const V & v, const tag_t & tag) {
+    const uid_t uid = base_t::Put(v, tag);
+    RecordTag(uid, tag);
+    return uid;
+  }
+
+  template <typename V>
+  void Set(const V & v, const tag_t & tag, const uid_t uid) {
+    base_t::Set(v, tag, uid);
+    RecordTag(uid, tag);
+  }
+
+  void Delete(const uid_t uid) {
+    base_t::Delete(uid);
+    if (uid < has_tag.size() && has_tag[uid]) {
+      has_tag[uid] = false;
+      --num_tags;
+    }
+    tags_changed = true;
+  }
+
+  void Clear() {
+    base_t::Clear();
+    tags.clear();
+    has_tag.clear();
+    num_tags = 0;
+    tags_changed = true;
+  }
+};
+
+#endif
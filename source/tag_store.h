@@ -0,0 +1,90 @@
+#ifndef TAG_LGP_TAG_STORE_H
+#define TAG_LGP_TAG_STORE_H
+
+#include <array>
+#include <cstdint>
+
+#include "emp/base/assert.hpp"
+#include "emp/base/vector.hpp"
+#include "emp/bits/BitSet.hpp"
+
+/// Number of 64-bit words needed to hold a WIDTH-bit tag.
+template<size_t WIDTH>
+constexpr size_t TagWordCount() { return (WIDTH + 63) / 64; }
+
+/// Mask of the bits in a WIDTH-bit tag's last word that belong to the tag.
+template<size_t WIDTH>
+constexpr uint64_t TagLastWordMask() {
+  return (WIDTH % 64) ? ((uint64_t(1) << (WIDTH % 64)) - 1) : ~uint64_t(0);
+}
+
+template<size_t WIDTH>
+using packed_tag_t = std::array<uint64_t, TagWordCount<WIDTH>()>;
+
+/// Pack an emp::BitSet into 64-bit words (bit i of the tag is bit i%64 of word i/64, as in emp::BitSet).
+template<size_t WIDTH>
+packed_tag_t<WIDTH> PackTag(const emp::BitSet<WIDTH> & tag) {
+  constexpr size_t NUM_UNITS = (WIDTH + 31) / 32;
+  packed_tag_t<WIDTH> words{};
+  for (size_t i = 0; i < NUM_UNITS; ++i) {
+    words[i / 2] |= static_cast<uint64_t>(tag.GetUInt(i)) << (32 * (i % 2));
+  }
+  return words;
+}
+
+/// Unpack 64-bit words into an emp::BitSet.
+template<size_t WIDTH>
+emp::BitSet<WIDTH> UnpackTag(const packed_tag_t<WIDTH> & words) {
+  constexpr size_t NUM_UNITS = (WIDTH + 31) / 32;
+  emp::BitSet<WIDTH> tag;
+  for (size_t i = 0; i < NUM_UNITS; ++i) {
+    tag.SetUInt(i, static_cast<uint32_t>(words[i / 2] >> (32 * (i % 2))));
+  }
+  return tag;
+}
+
+/// Packed tags stored contiguously, one tag after another (array of structures).
+/// Suited to kernels that hold a whole tag in registers (e.g., streak kernels).
+template<size_t WIDTH>
+class PackedTagStore {
+public:
+  using tag_t = emp::BitSet<WIDTH>;
+  using packed_t = packed_tag_t<WIDTH>;
+
+protected:
+  emp::vector<packed_t> tags;
+
+public:
+  size_t GetSize() const { return tags.size(); }
+  void Clear() { tags.clear(); }
+  void Add(const tag_t & tag) { tags.emplace_back(PackTag<WIDTH>(tag)); }
+  const packed_t & operator[](size_t i) const { return tags[i]; }
+};
+
+/// Packed tags stored word-major (structure of arrays): word k of every tag is contiguous.
+/// Suited to kernels that process the same word of many tags at once (e.g., Hamming and
+/// integer kernels), which the compiler can vectorize across tags.
+template<size_t WIDTH>
+class SoATagStore {
+public:
+  static constexpr size_t NUM_WORDS = TagWordCount<WIDTH>();
+  using tag_t = emp::BitSet<WIDTH>;
+
+protected:
+  std::array<emp::vector<uint64_t>, NUM_WORDS> words;  ///< words[k][i] = word k of tag i
+
+public:
+  size_t GetSize() const { return words[0].size(); }
+  void Clear() { for (auto & field : words) field.clear(); }
+  void Add(const tag_t & tag) {
+    const auto packed = PackTag<WIDTH>(tag);
+    for (size_t k = 0; k < NUM_WORDS; ++k) words[k].emplace_back(packed[k]);
+  }
+  /// Word k of every tag.
+  const uint64_t * GetWords(size_t k) const {
+    emp_assert(k < NUM_WORDS);
+    return words[k].data();
+  }
+};
+
+#endif
@@ -0,0 +1,159 @@
+#ifndef TAG_LGP_TEST_PREFIX_TRIE_H
+#define TAG_LGP_TEST_PREFIX_TRIE_H
+
+#include <cstddef>
+#include <utility>
+
+#include "emp/base/assert.hpp"
+#include "emp/base/vector.hpp"
+
+/// Sharing work across test cases that begin with the same input signals.
+/// - Hardware state that carries over from one input signal to the next (e.g., regulation and
+///   global memory) is reset only between test cases, so, for a given program, the responses and
+///   hardware state after a sequence of input signals depend only on that sequence.
+/// - SequenceTrie organizes a test bank's signal sequences into a trie. While evaluating one
+///   program, PrefixMemo remembers the response to each trie node's last signal and, at nodes where
+///   evaluation can continue in more than one way (branches), a HardwareCheckpoint of the hardware
+///   state after that node. A test whose leading signals were already run reuses those responses and
+///   resumes from the deepest checkpoint along its shared prefix, re-running only the signals after
+///   that checkpoint (all of them if the prefix has no checkpoint).
+
+/// Trie of key sequences. Node 0 is the root (the empty sequence).
+template<typename KEY_T>
+class SequenceTrie {
+public:
+  static constexpr size_t NO_NODE = (size_t)-1;
+
+protected:
+  struct Node {
+    KEY_T key;                    ///< Last key in this node's sequence.
+    size_t parent=NO_NODE;        ///< Parent node id (NO_NODE for the root).
+    size_t depth=0;               ///< Length of this node's sequence.
+    emp::vector<size_t> children; ///< Child node ids (in insertion order).
+    size_t num_ends=0;            ///< How many inserted sequences end at this node?
+  };
+
+  emp::vector<Node> nodes=emp::vector<Node>(1);
+
+public:
+  size_t GetRoot() const { return 0; }
+  size_t GetSize() const { return nodes.size(); }
+  const KEY_T & GetKey(size_t node) const { return nodes[node].key; }
+  size_t GetParent(size_t node) const { return nodes[node].parent; }
+  size_t GetDepth(size_t node) const { return nodes[node].depth; }
+
+  void Clear() { nodes.resize(1); nodes[0] = Node(); }
+
+  /// Child of node with the given key (NO_NODE if there is none).
+  size_t GetChild(size_t node, const KEY_T & key) const {
+    emp_assert(node < nodes.size());
+    for (size_t child : nodes[node].children) {
+      if (nodes[child].key == key) return child;
+    }
+    return NO_NODE;
+  }
+
+  /// Add the sequence [begin, end) to the trie; returns the node where it ends.
+  template<typename IT, typename TO_KEY_T>
+  size_t Insert(IT begin, IT end, const TO_KEY_T & to_key) {
+    size_t node = GetRoot();
+    for (IT it = begin; it != end; ++it) {
+      const KEY_T key = to_key(*it);
+      size_t child = GetChild(node, key);
+      if (child == NO_NODE) {
+        child = nodes.size();
+        nodes[node].children.emplace_back(child);
+        nodes.emplace_back();
+        nodes.back().key = key;
+        nodes.back().parent = node;
+        nodes.back().depth = nodes[node].depth + 1;
+      }
+      node = child;
+    }
+    ++nodes[node].num_ends;
+    return node;
+  }
+
+  /// Can evaluation continue past node in more than one way (several children, or a child and a
+  /// sequence that ends here)?
+  bool IsBranch(size_t node) const {
+    emp_assert(node < nodes.size());
+    return nodes[node].children.size() + (size_t)(nodes[node].num_ends > 0) > 1;
+  }
+};
+
+/// Hardware state that carries over between input signals: global memory and matchbin regulators
+/// (the matchbin must support SaveRegulators/RestoreRegulators, e.g., DirtyResetMatchBin).
+template<typename MEM_BUFFER_T, typename REGULATOR_T>
+struct HardwareCheckpoint {
+  MEM_BUFFER_T global_mem;
+  emp::vector<std::pair<size_t, REGULATOR_T>> regulators;
+
+  template<typename HARDWARE_T>
+  void Save(HARDWARE_T & hw) {
+    global_mem = hw.GetMemoryModel().GetGlobalBuffer();
+    hw.GetMatchBin().SaveRegulators(regulators);
+  }
+
+  /// Restore onto hardware running the same program (reset since the checkpoint was saved).
+  template<typename HARDWARE_T>
+  void Restore(HARDWARE_T & hw) const {
+    hw.GetMemoryModel().GetGlobalBuffer() = global_mem;
+    hw.GetMatchBin().RestoreRegulators(regulators);
+  }
+};
+
+/// Responses and checkpoints by trie node, for the program currently loaded on one piece of
+/// hardware. Clear() (O(1)) forgets everything when a new program is loaded; storage is reused.
+template<typename RESPONSE_T, typename CHECKPOINT_T>
+class PrefixMemo {
+protected:
+  emp::vector<RESPONSE_T> responses;
+  emp::vector<CHECKPOINT_T> checkpoints;
+  emp::vector<size_t> response_stamps;    ///< responses[node] is valid if response_stamps[node] == stamp.
+  emp::vector<size_t> checkpoint_stamps;  ///< checkpoints[node] is valid if checkpoint_stamps[node] == stamp.
+  size_t stamp=1;
+
+public:
+  void Clear() { ++stamp; }
+
+  bool HasResponse(size_t node) const {
+    return node < response_stamps.size() && response_stamps[node] == stamp;
+  }
+
+  const RESPONSE_T & GetResponse(size_t node) const {
+    emp_assert(HasResponse(node));
+    return responses[node];
+  }
+
+  void SetResponse(size_t node, const RESPONSE_T & response) {
+    if (node >= responses.size()) {
+      responses.resize(node + 1);
+      response_stamps.resize(node + 1, 0);
+    }
+    responses[node] = response;
+    response_stamps[node] = stamp;
+  }
+
+  bool HasCheckpoint(size_t node) const {
+    return node < checkpoint_stamps.size() && checkpoint_stamps[node] == stamp;
+  }
+
+  template<typename HARDWARE_T>
+  void SaveCheckpoint(size_t node, HARDWARE_T & hw) {
+    if (node >= checkpoints.size()) {
+      checkpoints.resize(node + 1);
+      checkpoint_stamps.resize(node + 1, 0);
+    }
+    checkpoints[node].Save(hw);
+    checkpoint_stamps[node] = stamp;
+  }
+
+  template<typename HARDWARE_T>
+  void RestoreCheckpoint(size_t node, HARDWARE_T & hw) const {
+    emp_assert(HasCheckpoint(node));
+    checkpoints[node].Restore(hw);
+  }
+};
+
+#endif
@@ -0,0 +1,173 @@
+#ifndef TAG_LGP_TIMER_WHEEL_MATCHBIN_H
+#define TAG_LGP_TIMER_WHEEL_MATCHBIN_H
+
+#include <algorithm>
+#include <utility>
+
+#include "emp/base/assert.hpp"
+#include "emp/base/vector.hpp"
+
+/// Matchbin (e.g., emp::MatchBin or IndexedMatchBin) whose regulator decay is driven by a timer wheel.
+/// - Countdown regulators (emp's Additive/Multiplicative countdown regulators and our
+///   ExponentialCountdownRegulator) only change state when their countdown timer expires. Rather than
+///   decaying every function's regulator on every DecayRegulators call (O(num functions) per step),
+///   we schedule each active countdown's expiry on a timer wheel and only touch regulators whose
+///   countdown actually expires.
+/// - Per-function decay bookkeeping lives in contiguous arrays (expiry step and last-decayed step by
+///   uid). The regulator objects themselves stay inside the wrapped matchbin, which owns them; a
+///   regulator's pending decay steps are applied whenever it is accessed or changed, so regulator
+///   state and timers are exactly what they would be with eager decay.
+/// Functions are identified by uid (SignalGP uses function ids as uids).
+template<typename MATCHBIN_T>
+class TimerWheelMatchBin : public MATCHBIN_T {
+public:
+  using base_t = MATCHBIN_T;
+  using uid_t = size_t;
+
+protected:
+  static constexpr size_t WHEEL_SIZE = 64;  ///< Number of wheel slots (expiry steps are hashed into slots).
+
+  size_t now=0;                        ///< Decay steps applied so far.
+  emp::vector<size_t> synced;          ///< Step each regulator has been decayed to (by uid).
+  emp::vector<size_t> expiry;          ///< Step at which each regulator's countdown expires (0 = none scheduled).
+  emp::vector<emp::vector<uid_t>> wheel=emp::vector<emp::vector<uid_t>>(WHEEL_SIZE);
+  emp::vector<uid_t> due;              ///< Scratch: regulators expiring during the current decay.
+  emp::vector<uid_t> recheck;          ///< Regulators handed out by GetRegulator (may have been changed).
+  bool wheel_valid=false;              ///< False once the set of tags changes.
+
+  void ResetWheel() {
+    const size_t size = base_t::Size();
+    now = 0;
+    synced.assign(size, 0);
+    expiry.assign(size, 0);
+    for (auto & slot : wheel) slot.clear();
+    recheck.clear();
+    wheel_valid = true;
+    for (uid_t uid = 0; uid < size; ++uid) Schedule(uid);
+  }
+
+  /// Apply uid's pending decay steps.
+  void Flush(uid_t uid) {
+    if (now == synced[uid]) return;
+    base_t::DecayRegulator(uid, static_cast<int>(now - synced[uid]));
+    synced[uid] = now;
+  }
+
+  /// (Re)schedule uid's countdown expiry from its regulator. Regulators in their neutral state have
+  /// nothing to expire, so they are not scheduled (their timers are brought up to date by Flush).
+  void Schedule(uid_t uid) {
+    emp_assert(synced[uid] == now);
+    expiry[uid] = 0;
+    if (base_t::ViewRegulator(uid) == 0) return;
+    const size_t timer = std::max<size_t>(base_t::GetRegulator(uid).timer, 1);
+    expiry[uid] = now + timer;
+    wheel[expiry[uid] % WHEEL_SIZE].emplace_back(uid);
+  }
+
+  void Prepare() {
+    if (!wheel_valid) ResetWheel();
+    for (uid_t uid : recheck) Schedule(uid);
+    recheck.clear();
+  }
+
+public:
+  template <typename... Ts>
+  TimerWheelMatchBin(Ts &&... args) : base_t(std::forward<Ts>(args)...) { ; }
+
+  /// Advance all regulator countdowns by steps, touching only regulators that expire.
+  void DecayRegulators(const int steps=1) {
+    Prepare();
+    if (steps <= 0) {
+      // Reverse decay adds to every timer; do it eagerly.
+      for (uid_t uid = 0; uid < synced.size(); ++uid) Flush(uid);
+      base_t::DecayRegulators(steps);
+      for (auto & slot : wheel) slot.clear();
+      for (uid_t uid = 0; uid < synced.size(); ++uid) Schedule(uid);
+      return;
+    }
+    const size_t target = now + static_cast<size_t>(steps);
+    const size_t num_slots = std::min<size_t>(static_cast<size_t>(steps), WHEEL_SIZE);
+    for (size_t step = now + 1; step <= now + num_slots; ++step) {
+      auto & slot = wheel[step % WHEEL_SIZE];
+      for (size_t i = 0; i < slot.size(); ) {
+        const uid_t uid = slot[i];
+        const bool stale = !expiry[uid] || (expiry[uid] % WHEEL_SIZE) != (step % WHEEL_SIZE);
+        const bool expired = !stale && expiry[uid] <= target;
+        if (stale || expired) {
+          if (expired) {
+            expiry[uid] = 0; // Any duplicate entries for uid are now stale.
+            due.emplace_back(uid);
+          }
+          slot[i] = slot.back();
+          slot.pop_back();
+        } else {
+          ++i;
+        }
+      }
+    }
+    now = target;
+    for (uid_t uid : due) {
+      Flush(uid);
+      Schedule(uid);
+    }
+    due.clear();
+  }
+
+  void DecayRegulator(const uid_t uid, const int steps) {
+    Prepare();
+    Flush(uid);
+    base_t::DecayRegulator(uid, steps);
+    Schedule(uid);
+  }
+
+  template <typename T>
+  void AdjRegulator(const uid_t uid, const T & amt) {
+    Prepare();
+    Flush(uid);
+    base_t::AdjRegulator(uid, amt);
+    Schedule(uid);
+  }
+
+  template <typename T>
+  void SetRegulator(const uid_t uid, const T & set) {
+    Prepare();
+    Flush(uid);
+    base_t::SetRegulator(uid, set);
+    Schedule(uid);
+  }
+
+  /// Access uid's regulator (with all decay applied). Callers may change it, so it is rescheduled
+  /// before the next decay.
+  decltype(auto) GetRegulator(const uid_t uid) {
+    Prepare();
+    Flush(uid);
+    recheck.emplace_back(uid);
+    return base_t::GetRegulator(uid);
+  }
+
+  // Changes to the set of tags reset the wheel (rebuilt on next use).
+  template <typename... Ts>
+  auto Put(Ts &&... args) {
+    wheel_valid = false;
+    return base_t::Put(std::forward<Ts>(args)...);
+  }
+
+  template <typename... Ts>
+  void Set(Ts &&... args) {
+    wheel_valid = false;
+    base_t::Set(std::forward<Ts>(args)...);
+  }
+
+  template <typename... Ts>
+  void Delete(Ts &&... args) {
+    wheel_valid = false;
+    base_t::Delete(std::forward<Ts>(args)...);
+  }
+
+  void Clear() {
+    wheel_valid = false;
+    base_t::Clear();
+  }
+};
+
+#endif
@@ -2,6 +2,7 @@
 
 #include "catch.hpp"
 
+#include <algorithm>
 #include <limits>
 
 #include "emp/bits/BitSet.hpp"
@@ -12,6 +13,19 @@
 #include "emp/math/Range.hpp"
 
 #include "mutation_utils.h"
+#include "simd_streak_metric.h"
+#include "batch_metrics.h"
+#include "indexed_matchbin.h"
+#include "timer_wheel_matchbin.h"
+#include "tag_index.h"
+#include "cached_raw_matchbin.h"
+#include "dirty_reset_matchbin.h"
+#include "precomputed_matchbin.h"
+#include "inst_observers.h"
+#include "Event.h"
+#include "hardware_run.h"
+#include "test_prefix_trie.h"
+#include "reachability_utils.h"
 
 #include "AltSignalWorld.h"
 #include "AltSignalConfig.h"
@@ -21,6 +35,7 @@
 
 #include "BoolCalcConfig.h"
 #include "BoolCalcWorld.h"
+#include "BoolCalcVariants.h"
 
 // #include "DirSignalWorld.h"
 // #include "DirSignalConfig.h"
@@ -45,6 +60,986 @@ TEST_CASE( "ExponentialCountdownRegulator", "[matchbin]") {
   REQUIRE(regulator.View() == 10.0);
 }
 
+TEST_CASE( "QuantizedExponentialCountdownRegulator", "[matchbin]") {
+  using exact_regulator_t = ExponentialCountdownRegulator<std::ratio<11, 10>, 10>;
+  using quantized_regulator_t = QuantizedExponentialCountdownRegulator<std::ratio<11, 10>, 10, 4>;
+  exact_regulator_t exact;
+  quantized_regulator_t quantized;
+  const double bound = quantized_regulator_t::MaxRelativeError() + 1e-12;
+  // Regulated scores stay within the documented bound (including clamped states).
+  for (double state = -12.0; state <= 12.0; state += 0.001) {
+    REQUIRE(exact.Set(state) == quantized.Set(state));
+    REQUIRE(quantized.View() == exact.View());
+    REQUIRE(std::abs(quantized(0.5) - exact(0.5)) <= exact(0.5) * bound);
+  }
+  // States on the quantization grid are (almost) exact.
+  quantized.Set(2.25);
+  REQUIRE(quantized(1.0) == Approx(std::pow(1.1, 2.25)).epsilon(1e-12));
+  // Decay behaves as the exact regulator.
+  REQUIRE(quantized.Decay(1));
+  REQUIRE(quantized(1.0) == 1.0);
+}
+
+template<size_t W>
+void CheckSimdStreakMetric(emp::Random & random) {
+  using tag_t = emp::BitSet<W>;
+  emp::StreakMetric<W> streak;
+  SimdStreakMetric<W> simd_streak;
+  emp::vector<tag_t> tags;
+  for (size_t i = 0; i < 500; ++i) tags.emplace_back(random, random.GetDouble());
+  tags.emplace_back(tags[0]);   // identical tags
+  tags.emplace_back(~tags[0]);  // complementary tags
+  typename SimdStreakMetric<W>::tag_store_t tag_store;
+  for (const auto & tag : tags) tag_store.Add(tag);
+  emp::vector<double> block_scores(tags.size());
+  for (size_t i = 0; i < 50; ++i) {
+    const tag_t & query = tags[i];
+    simd_streak.ScoreBlock(query, tag_store, block_scores.data());
+    for (size_t j = 0; j < tags.size(); ++j) {
+      REQUIRE(simd_streak(query, tags[j]) == streak(query, tags[j]));
+      REQUIRE(block_scores[j] == streak(query, tags[j]));
+    }
+  }
+  // Every vector kernel this machine can run agrees with the scalar kernel.
+  if constexpr (W == 256) {
+    using kernel_t = StreakKernel<W>;
+    for (size_t i = 0; i < 50; ++i) {
+      const auto a = PackTag<W>(tags[i]);
+      for (size_t j = 0; j < tags.size(); ++j) {
+        const auto b = PackTag<W>(tags[j]);
+        size_t same = 0, different = 0;
+        kernel_t::LongestStreaks_Scalar(a, b, same, different);
+        #if defined(__SSE2__)
+        size_t sse2_same = 0, sse2_different = 0;
+        kernel_t::LongestStreaks_SSE2(a, b, sse2_same, sse2_different);
+        REQUIRE(sse2_same == same);
+        REQUIRE(sse2_different == different);
+        #endif
+        #if defined(__AVX2__) || defined(TAG_LGP_STREAK_RUNTIME_AVX2)
+        if (kernel_t::HasAVX2()) {
+          size_t avx2_same = 0, avx2_different = 0;
+          kernel_t::LongestStreaks_AVX2(a, b, avx2_same, avx2_different);
+          REQUIRE(avx2_same == same);
+          REQUIRE(avx2_different == different);
+        }
+        #endif
+      }
+    }
+  }
+}
+
+TEST_CASE( "SimdStreakMetric", "[matchbin]") {
+  emp::Random random(2);
+  CheckSimdStreakMetric<256>(random);
+  CheckSimdStreakMetric<128>(random);
+  CheckSimdStreakMetric<100>(random);
+  CheckSimdStreakMetric<64>(random);
+  CheckSimdStreakMetric<16>(random);
+}
+
+template<typename BATCH_METRIC_T, typename METRIC_T, size_t W>
+void CheckBatchMetric(emp::Random & random) {
+  using tag_t = emp::BitSet<W>;
+  METRIC_T metric;
+  BATCH_METRIC_T batch_metric;
+  emp::vector<tag_t> tags;
+  for (size_t i = 0; i < 500; ++i) tags.emplace_back(random, random.GetDouble());
+  tags.emplace_back(tags[0]);   // identical tags
+  tags.emplace_back(~tags[0]);  // complementary tags
+  tags.emplace_back();          // all zeros
+  tags.emplace_back(~tag_t());  // all ones
+  typename BATCH_METRIC_T::tag_store_t tag_store;
+  for (const auto & tag : tags) tag_store.Add(tag);
+  emp::vector<double> block_scores(tags.size());
+  for (size_t i = 0; i < tags.size(); i += 10) {
+    const tag_t & query = tags[i];
+    batch_metric.ScoreBlock(query, tag_store, block_scores.data());
+    for (size_t j = 0; j < tags.size(); ++j) {
+      REQUIRE(block_scores[j] == metric(query, tags[j]));
+    }
+  }
+}
+
+TEST_CASE( "Batch metrics", "[matchbin]") {
+  emp::Random random(2);
+  CheckBatchMetric<BatchHammingMetric<256>, emp::HammingMetric<256>, 256>(random);
+  CheckBatchMetric<BatchHammingMetric<100>, emp::HammingMetric<100>, 100>(random);
+  CheckBatchMetric<BatchAsymmetricWrapMetric<256>, emp::AsymmetricWrapMetric<256>, 256>(random);
+  CheckBatchMetric<BatchAsymmetricWrapMetric<100>, emp::AsymmetricWrapMetric<100>, 100>(random);
+  CheckBatchMetric<BatchAsymmetricWrapMetric<32>, emp::AsymmetricWrapMetric<32>, 32>(random);
+  CheckBatchMetric<BatchSymmetricWrapMetric<256>, emp::SymmetricWrapMetric<256>, 256>(random);
+  CheckBatchMetric<BatchSymmetricWrapMetric<100>, emp::SymmetricWrapMetric<100>, 100>(random);
+  CheckBatchMetric<BatchSymmetricWrapMetric<32>, emp::SymmetricWrapMetric<32>, 32>(random);
+}
+
+template<typename METRIC_T, size_t WIDTH>
+void CheckTagIndex(emp::Random & random) {
+  using tag_t = emp::BitSet<WIDTH>;
+  using regulator_t = ExponentialCountdownRegulator<>;
+  using scan_matchbin_t = emp::MatchBin<size_t, METRIC_T, emp::RankedSelector<>, regulator_t>;
+  using index_matchbin_t = TagIndexMatchBin<scan_matchbin_t, typename tag_index_for<METRIC_T>::type, emp::RankedSelector<>>;
+  METRIC_T metric;
+  index_matchbin_t matchbin(random);
+  scan_matchbin_t scan_matchbin(random);
+  emp::vector<tag_t> tags;
+  for (size_t uid = 0; uid < 64; ++uid) {
+    // Include duplicate tags to exercise tie breaking.
+    tags.emplace_back(uid && random.P(0.1) ? tags[random.GetUInt(uid)] : tag_t(random, 0.5));
+    matchbin.Set(uid, tags.back(), uid);
+    scan_matchbin.Set(uid, tags.back(), uid);
+  }
+  for (size_t q = 0; q < 200; ++q) {
+    const tag_t query(random, 0.5);
+    // Index answer: best raw score, lowest uid among ties.
+    size_t best_uid = 0;
+    for (size_t uid = 1; uid < tags.size(); ++uid) {
+      if (metric(query, tags[uid]) < metric(query, tags[best_uid])) best_uid = uid;
+    }
+    REQUIRE(matchbin.MatchRaw(query, 1) == emp::vector<size_t>{best_uid});
+    REQUIRE(matchbin.Match(query, 1) == emp::vector<size_t>{best_uid});
+  }
+  // With active regulators, matches fall back to the scan.
+  for (size_t uid = 0; uid < tags.size(); uid += 3) {
+    matchbin.SetRegulator(uid, 2.0);
+    scan_matchbin.SetRegulator(uid, 2.0);
+  }
+  for (size_t q = 0; q < 50; ++q) {
+    const tag_t query(random, 0.5);
+    REQUIRE(matchbin.Match(query, 1) == scan_matchbin.Match(query, 1));
+  }
+}
+
+TEST_CASE( "TagIndexMatchBin", "[matchbin]") {
+  emp::Random random(2);
+  CheckTagIndex<emp::HammingMetric<16>, 16>(random);
+  CheckTagIndex<emp::HammingMetric<256>, 256>(random);
+  CheckTagIndex<emp::AsymmetricWrapMetric<16>, 16>(random);
+  CheckTagIndex<emp::AsymmetricWrapMetric<256>, 256>(random);
+  CheckTagIndex<emp::SymmetricWrapMetric<16>, 16>(random);
+  CheckTagIndex<emp::SymmetricWrapMetric<256>, 256>(random);
+}
+
+template<typename METRIC_T, size_t WIDTH>
+void CheckIndexedMatchBin(emp::Random & random) {
+  using tag_t = emp::BitSet<WIDTH>;
+  using regulator_t = ExponentialCountdownRegulator<std::ratio<11, 10>, 10>;
+  using plain_matchbin_t = emp::MatchBin<size_t, METRIC_T, emp::RankedSelector<>, regulator_t>;
+  using incremental_matchbin_t = IndexedMatchBin<size_t, METRIC_T, emp::RankedSelector<>, regulator_t, true>;
+  using counting_matchbin_t = IndexedMatchBin<size_t, METRIC_T, emp::RankedSelector<>, regulator_t, false>;
+  plain_matchbin_t plain_matchbin(random);
+  incremental_matchbin_t incremental_matchbin(random);
+  counting_matchbin_t counting_matchbin(random);
+  emp::vector<tag_t> queries;
+  for (size_t i = 0; i < 8; ++i) queries.emplace_back(random, 0.5);
+  for (size_t program = 0; program < 10; ++program) {
+    // Every function tag appears twice (uids i and i + half), so raw scores always tie.
+    const size_t half = random.GetUInt(1, 17);
+    emp::vector<tag_t> func_tags;
+    for (size_t uid = 0; uid < half; ++uid) func_tags.emplace_back(random, 0.5);
+    for (size_t uid = 0; uid < half; ++uid) func_tags.emplace_back(func_tags[uid]);
+    plain_matchbin.Clear();
+    incremental_matchbin.Clear();
+    counting_matchbin.Clear();
+    for (size_t uid = 0; uid < func_tags.size(); ++uid) {
+      plain_matchbin.Set(uid, func_tags[uid], uid);
+      incremental_matchbin.Set(uid, func_tags[uid], uid);
+      counting_matchbin.Set(uid, func_tags[uid], uid);
+    }
+    // Unregulated ties go to the lower uid.
+    for (const tag_t & query : queries) {
+      const auto best = incremental_matchbin.Match(query, 1);
+      REQUIRE(best.size() == 1);
+      REQUIRE(best[0] < half);
+      REQUIRE(best == plain_matchbin.Match(query, 1));
+      REQUIRE(best == counting_matchbin.Match(query, 1));
+    }
+    for (size_t step = 0; step < 200; ++step) {
+      const size_t uid = random.GetUInt(func_tags.size());
+      const double amt = random.GetDouble(-5, 5);
+      switch (random.GetUInt(6)) {
+        case 0:
+          plain_matchbin.AdjRegulator(uid, amt);
+          incremental_matchbin.AdjRegulator(uid, amt);
+          counting_matchbin.AdjRegulator(uid, amt);
+          break;
+        case 1:
+          plain_matchbin.SetRegulator(uid, amt);
+          incremental_matchbin.SetRegulator(uid, amt);
+          counting_matchbin.SetRegulator(uid, amt);
+          break;
+        case 2:
+          plain_matchbin.DecayRegulators();
+          incremental_matchbin.DecayRegulators();
+          counting_matchbin.DecayRegulators();
+          break;
+        case 3:
+          plain_matchbin.GetRegulator(uid).Adj(amt);
+          incremental_matchbin.GetRegulator(uid).Adj(amt);
+          counting_matchbin.GetRegulator(uid).Adj(amt);
+          break;
+        case 4: {
+          // Clear a regulator back to neutral, re-creating raw score ties.
+          plain_matchbin.SetRegulator(uid, regulator_t());
+          incremental_matchbin.SetRegulator(uid, regulator_t());
+          counting_matchbin.SetRegulator(uid, regulator_t());
+          break;
+        }
+        default: break;
+      }
+      const tag_t & query = queries[random.GetUInt(queries.size())];
+      const auto expected = plain_matchbin.Match(query, 1);
+      REQUIRE(incremental_matchbin.Match(query, 1) == expected);
+      REQUIRE(counting_matchbin.Match(query, 1) == expected);
+    }
+    // Both indexes see the same regulator changes.
+    REQUIRE(incremental_matchbin.GetStats().regulation_purges == counting_matchbin.GetStats().regulation_purges);
+  }
+}
+
+TEST_CASE( "IndexedMatchBin", "[matchbin]") {
+  emp::Random random(2);
+  CheckIndexedMatchBin<emp::StreakMetric<64>, 64>(random);
+  CheckIndexedMatchBin<BatchHammingMetric<16>, 16>(random);
+  CheckIndexedMatchBin<BatchAsymmetricWrapMetric<32>, 32>(random);
+}
+
+TEST_CASE( "TimerWheelMatchBin", "[matchbin]") {
+  using tag_t = emp::BitSet<16>;
+  using regulator_t = ExponentialCountdownRegulator<std::ratio<11, 10>, 10>;
+  using eager_matchbin_t = emp::MatchBin<size_t, emp::StreakMetric<16>, emp::RankedSelector<>, regulator_t>;
+  using wheel_matchbin_t = TimerWheelMatchBin<eager_matchbin_t>;
+  emp::Random random(2);
+  eager_matchbin_t eager_matchbin(random);
+  wheel_matchbin_t wheel_matchbin(random);
+  const size_t num_functions = 32;
+  for (size_t uid = 0; uid < num_functions; ++uid) {
+    const tag_t tag(random, 0.5);
+    eager_matchbin.Set(uid, tag, uid);
+    wheel_matchbin.Set(uid, tag, uid);
+  }
+  // Regulator states and timers should be identical to eager decay after any sequence of changes and decays.
+  for (size_t step = 0; step < 2000; ++step) {
+    const size_t uid = random.GetUInt(num_functions);
+    const double amt = random.GetDouble(-5, 5);
+    switch (random.GetUInt(4)) {
+      case 0: eager_matchbin.AdjRegulator(uid, amt); wheel_matchbin.AdjRegulator(uid, amt); break;
+      case 1: eager_matchbin.SetRegulator(uid, amt); wheel_matchbin.SetRegulator(uid, amt); break;
+      case 2: {
+        const int steps = (random.P(0.05)) ? 100 : (int)random.GetUInt(1, 4);
+        eager_matchbin.DecayRegulators(steps);
+        wheel_matchbin.DecayRegulators(steps);
+        break;
+      }
+      default: eager_matchbin.DecayRegulators(); wheel_matchbin.DecayRegulators(); break;
+    }
+    for (size_t i = 0; i < num_functions; ++i) {
+      REQUIRE(wheel_matchbin.ViewRegulator(i) == eager_matchbin.ViewRegulator(i));
+    }
+    REQUIRE(wheel_matchbin.GetRegulator(uid).timer == eager_matchbin.GetRegulator(uid).timer);
+  }
+}
+
+TEST_CASE( "CachedRawMatchBin", "[matchbin]") {
+  using tag_t = emp::BitSet<16>;
+  using regulator_t = ExponentialCountdownRegulator<>;
+  using plain_matchbin_t = emp::MatchBin<size_t, emp::HammingMetric<16>, emp::RankedSelector<>, regulator_t>;
+  using cached_matchbin_t = CachedRawMatchBin<plain_matchbin_t>;
+  // Minimal stand-in for a SignalGP program: functions of instructions with at most one tag each.
+  struct inst_t {
+    emp::vector<tag_t> tags;
+    const emp::vector<tag_t> & GetTags() const { return tags; }
+    const tag_t & GetTag(size_t i) const { return tags[i]; }
+  };
+  struct function_t {
+    emp::vector<inst_t> insts;
+    size_t GetSize() const { return insts.size(); }
+    const inst_t & operator[](size_t i) const { return insts[i]; }
+  };
+  struct program_t {
+    emp::vector<function_t> functions;
+    size_t GetSize() const { return functions.size(); }
+    const function_t & operator[](size_t i) const { return functions[i]; }
+  };
+  emp::Random random(2);
+  plain_matchbin_t plain_matchbin(random);
+  cached_matchbin_t cached_matchbin(random);
+  emp::vector<tag_t> queries;
+  for (size_t i = 0; i < 8; ++i) queries.emplace_back(random, 0.5);
+  emp::vector<tag_t> program_tags;
+  program_t program;
+  for (size_t test = 0; test < 200; ++test) {
+    // Sometimes a new program (with duplicate tags, for ties), otherwise the same one re-added.
+    const bool new_program = program_tags.empty() || random.P(0.2);
+    if (new_program) {
+      program_tags.resize(random.GetUInt(1, 17));
+      for (size_t uid = 0; uid < program_tags.size(); ++uid) {
+        program_tags[uid] = (uid && random.P(0.2)) ? program_tags[random.GetUInt(uid)] : tag_t(random, 0.5);
+      }
+      program.functions.resize(program_tags.size());
+      for (function_t & func : program.functions) {
+        func.insts.resize(random.GetUInt(1, 8));
+        for (inst_t & inst : func.insts) {
+          inst.tags.clear();
+          if (random.P(0.75)) inst.tags.emplace_back(queries[random.GetUInt(queries.size())]);
+        }
+      }
+    }
+    plain_matchbin.Clear();
+    cached_matchbin.Clear();
+    for (size_t uid = 0; uid < program_tags.size(); ++uid) {
+      plain_matchbin.Set(uid, program_tags[uid], uid);
+      cached_matchbin.Set(uid, program_tags[uid], uid);
+    }
+    if (new_program) cached_matchbin.LoadProgram(program);
+    for (size_t step = 0; step < 10; ++step) {
+      // Raw matches ignore regulation.
+      const size_t uid = random.GetUInt(program_tags.size());
+      plain_matchbin.SetRegulator(uid, 3.0);
+      cached_matchbin.SetRegulator(uid, 3.0);
+      const size_t func_id = random.GetUInt(program.GetSize());
+      const size_t inst_id = random.GetUInt(program[func_id].GetSize());
+      const inst_t & inst = program[func_id][inst_id];
+      if (inst.GetTags().size()) {
+        const emp::vector<size_t> best = plain_matchbin.MatchRaw(inst.GetTag(0), 1);
+        REQUIRE(cached_matchbin.MatchRaw(inst.GetTag(0), 1) == best);
+        REQUIRE(cached_matchbin.GetProgramMatch(func_id, inst_id) == (best.size() ? best[0] : cached_matchbin_t::NO_MATCH));
+        const size_t n = random.GetUInt(2, 4);
+        REQUIRE(cached_matchbin.MatchRaw(inst.GetTag(0), n) == plain_matchbin.MatchRaw(inst.GetTag(0), n));
+      } else {
+        REQUIRE(cached_matchbin.GetProgramMatch(func_id, inst_id) == cached_matchbin_t::NO_MATCH);
+      }
+      // Queries that are not instruction tags of the loaded program.
+      const tag_t & query = queries[random.GetUInt(queries.size())];
+      REQUIRE(cached_matchbin.MatchRaw(query, 1) == plain_matchbin.MatchRaw(query, 1));
+    }
+  }
+  REQUIRE(cached_matchbin.GetRawCacheHits() > 0);
+  // An instruction tag changed in place (a program loaded without LoadProgram) is not matched from
+  // the table.
+  for (function_t & func : program.functions) {
+    for (inst_t & inst : func.insts) {
+      if (!inst.tags.size()) continue;
+      inst.tags[0] = tag_t(random, 0.5);
+      REQUIRE(cached_matchbin.MatchRaw(inst.GetTag(0), 1) == plain_matchbin.MatchRaw(inst.GetTag(0), 1));
+    }
+  }
+}
+
+TEST_CASE( "DirtyResetMatchBin", "[matchbin]") {
+  using tag_t = emp::BitSet<64>;
+  using regulator_t = ExponentialCountdownRegulator<>;
+  using full_matchbin_t = emp::MatchBin<size_t, emp::AsymmetricWrapMetric<64>, emp::RankedSelector<>, regulator_t>;
+  using dirty_matchbin_t = DirtyResetMatchBin<full_matchbin_t>;
+  emp::Random random(2);
+  full_matchbin_t full_matchbin(random);
+  dirty_matchbin_t dirty_matchbin(random);
+  emp::vector<tag_t> program_tags;
+  // Reset (Clear + Set every function, as ResetMatchBin does) between bouts of regulation, sometimes
+  // with a changed or resized program.
+  for (size_t test = 0; test < 500; ++test) {
+    if (program_tags.empty() || random.P(0.2)) {
+      emp::vector<tag_t> new_tags(random.GetUInt(1, 9));
+      for (size_t i = 0; i < new_tags.size(); ++i) {
+        new_tags[i] = (i < program_tags.size() && random.P(0.75)) ? program_tags[i] : tag_t(random, 0.5);
+      }
+      program_tags = new_tags;
+    }
+    full_matchbin.Clear();
+    dirty_matchbin.Clear();
+    for (size_t uid = 0; uid < program_tags.size(); ++uid) {
+      full_matchbin.Set(uid, program_tags[uid], uid);
+      dirty_matchbin.Set(uid, program_tags[uid], uid);
+    }
+    REQUIRE(dirty_matchbin.Size() == full_matchbin.Size());
+    for (size_t step = 0; step < 10; ++step) {
+      const size_t uid = random.GetUInt(program_tags.size());
+      const double amt = random.GetDouble(-5, 5);
+      switch (random.GetUInt(4)) {
+        case 0: full_matchbin.AdjRegulator(uid, amt); dirty_matchbin.AdjRegulator(uid, amt); break;
+        case 1: full_matchbin.SetRegulator(uid, amt); dirty_matchbin.SetRegulator(uid, amt); break;
+        case 2: full_matchbin.DecayRegulators(); dirty_matchbin.DecayRegulators(); break;
+        default: {
+          const tag_t query(random, 0.5);
+          REQUIRE(dirty_matchbin.Match(query, 1) == full_matchbin.Match(query, 1));
+        }
+      }
+    }
+    for (size_t uid = 0; uid < program_tags.size(); ++uid) {
+      REQUIRE(dirty_matchbin.ViewRegulator(uid) == full_matchbin.ViewRegulator(uid));
+    }
+  }
+}
+
+template<typename METRIC_T, typename SELECTOR_T, size_t WIDTH>
+void CheckPrecomputedMatchBin(emp::Random & random) {
+  using tag_t = emp::BitSet<WIDTH>;
+  using regulator_t = ExponentialCountdownRegulator<std::ratio<11, 10>, 10>;
+  using plain_matchbin_t = emp::MatchBin<size_t, METRIC_T, SELECTOR_T, regulator_t>;
+  using precomputed_matchbin_t = PrecomputedMatchBin<plain_matchbin_t, METRIC_T, SELECTOR_T>;
+  plain_matchbin_t plain_matchbin(random);
+  precomputed_matchbin_t precomputed_matchbin(random);
+  emp::vector<tag_t> queries;   // Fixed pool of queries (as input signals are).
+  for (size_t i = 0; i < 8; ++i) queries.emplace_back(random, 0.5);
+  for (size_t program = 0; program < 10; ++program) {
+    // New program; include duplicate tags to exercise tie breaking.
+    emp::vector<tag_t> func_tags;
+    const size_t num_functions = random.GetUInt(1, 33);
+    for (size_t uid = 0; uid < num_functions; ++uid) {
+      func_tags.emplace_back(uid && random.P(0.1) ? func_tags[random.GetUInt(uid)] : tag_t(random, 0.5));
+    }
+    // Reset between tests, as ResetMatchBin does.
+    for (size_t test = 0; test < 5; ++test) {
+      plain_matchbin.Clear();
+      precomputed_matchbin.Clear();
+      for (size_t uid = 0; uid < num_functions; ++uid) {
+        plain_matchbin.Set(uid, func_tags[uid], uid);
+        precomputed_matchbin.Set(uid, func_tags[uid], uid);
+      }
+      for (size_t step = 0; step < 50; ++step) {
+        const size_t uid = random.GetUInt(num_functions);
+        const double amt = random.GetDouble(-5, 5);
+        switch (random.GetUInt(5)) {
+          case 0: plain_matchbin.AdjRegulator(uid, amt); precomputed_matchbin.AdjRegulator(uid, amt); break;
+          case 1: plain_matchbin.SetRegulator(uid, amt); precomputed_matchbin.SetRegulator(uid, amt); break;
+          case 2: plain_matchbin.DecayRegulators(); precomputed_matchbin.DecayRegulators(); break;
+          case 3: plain_matchbin.GetRegulator(uid).Adj(amt); precomputed_matchbin.GetRegulator(uid).Adj(amt); break;
+          default: break;
+        }
+        const tag_t & query = queries[random.GetUInt(queries.size())];
+        REQUIRE(precomputed_matchbin.Match(query, 1) == plain_matchbin.Match(query, 1));
+        REQUIRE(precomputed_matchbin.MatchRaw(query, 1) == plain_matchbin.MatchRaw(query, 1));
+      }
+    }
+  }
+}
+
+TEST_CASE( "PrecomputedMatchBin", "[matchbin]") {
+  emp::Random random(2);
+  CheckPrecomputedMatchBin<emp::StreakMetric<64>, emp::RankedSelector<>, 64>(random);
+  CheckPrecomputedMatchBin<SimdStreakMetric<256>, emp::RankedSelector<>, 256>(random);
+  CheckPrecomputedMatchBin<BatchHammingMetric<16>, emp::RankedSelector<>, 16>(random);
+  // Thresholded selectors fall back to the wrapped matchbin.
+  CheckPrecomputedMatchBin<emp::HammingMetric<16>, emp::RankedSelector<std::ratio<16+(16/4), 16>>, 16>(random);
+}
+
+TEST_CASE( "ObservedInstLib", "[instructions]") {
+  // Minimal stand-ins for SignalGP's hardware, instructions, and instruction library.
+  struct hardware_t { int value=0; };
+  struct inst_t { int arg=0; };
+  enum class inst_prop_t { BLOCK_DEF, BLOCK_CLOSE };
+  struct inst_lib_t {
+    using inst_fun_t = std::function<void(hardware_t &, const inst_t &)>;
+    emp::vector<inst_fun_t> funs;
+    emp::vector<std::unordered_set<inst_prop_t>> properties;
+    void Clear() { funs.clear(); properties.clear(); }
+    void AddInst(const std::string & name, const inst_fun_t & fun, const std::string & desc="",
+                 const std::unordered_set<inst_prop_t> & props=std::unordered_set<inst_prop_t>()) {
+      funs.emplace_back(fun);
+      properties.emplace_back(props);
+    }
+  };
+  auto add = [](hardware_t & hw, const inst_t & inst) { hw.value += inst.arg; };
+  auto dbl = [](hardware_t & hw, const inst_t & inst) { hw.value *= 2; };
+  const emp::vector<inst_t> program = {{3}, {0}, {1}, {0}};
+  // Add the same instructions to an unobserved and a recording library.
+  inst_lib_t plain_lib;
+  inst_lib_t traced_lib;
+  emp::vector<inst_t> executed;
+  ObservedInstLib<inst_lib_t, inst_prop_t> plain(plain_lib);
+  ObservedInstLib<inst_lib_t, inst_prop_t, InstRecorder<inst_t>> traced(traced_lib, InstRecorder<inst_t>(executed));
+  plain.AddInst("Add", add, "", {inst_prop_t::BLOCK_DEF});
+  plain.AddInst("Double", dbl);
+  traced.AddInst("Add", add, "", {inst_prop_t::BLOCK_DEF});
+  traced.AddInst("Double", dbl);
+  REQUIRE(traced_lib.properties == plain_lib.properties);
+  // Observed instructions behave exactly like unobserved ones; only the recording library records.
+  hardware_t plain_hw;
+  hardware_t traced_hw;
+  for (size_t i = 0; i < program.size(); ++i) {
+    plain_lib.funs[i % 2](plain_hw, program[i]);
+    traced_lib.funs[i % 2](traced_hw, program[i]);
+  }
+  REQUIRE(traced_hw.value == plain_hw.value);
+  REQUIRE(executed.size() == program.size());
+  for (size_t i = 0; i < program.size(); ++i) REQUIRE(executed[i].arg == program[i].arg);
+}
+
+TEST_CASE( "InlinePayload", "[events]") {
+  using payload_t = InlinePayload<int, double, 3>;
+  payload_t payload({{0, 1.5}});
+  REQUIRE(payload.size() == 1);
+  REQUIRE(payload.Has(0));
+  REQUIRE(payload.Set(4, -2.0));
+  REQUIRE(payload.Set(0, 3.0)); // Overwrites; does not add an entry.
+  REQUIRE(payload.size() == 2);
+  // Iterates in insertion order, like the message event data it replaces.
+  emp::vector<std::pair<int, double>> entries(payload.begin(), payload.end());
+  REQUIRE(entries == emp::vector<std::pair<int, double>>{{0, 3.0}, {4, -2.0}});
+  // A full payload still overwrites existing keys, but drops new ones (and never writes past its storage).
+  REQUIRE(payload.Set(2, 1.0));
+  REQUIRE(!payload.Set(5, 4.0));
+  REQUIRE(payload.Set(4, 0.5));
+  REQUIRE(payload.size() == payload.capacity());
+  REQUIRE(!payload.Has(5));
+  entries.assign(payload.begin(), payload.end());
+  REQUIRE(entries == emp::vector<std::pair<int, double>>{{0, 3.0}, {4, 0.5}, {2, 1.0}});
+  payload.Clear();
+  REQUIRE(payload.empty());
+  REQUIRE(!payload.Has(0));
+  // Message events copy their payload without touching the heap.
+  MessageEvent<16> event(0, emp::BitSet<16>(), {{0, 7.0}});
+  MessageEvent<16> copy(event);
+  REQUIRE(copy.GetData().size() == 1);
+  REQUIRE(copy.GetData().begin()->second == 7.0);
+}
+
+TEST_CASE( "RunUntilQuiescent", "[hardware]") {
+  // Minimal stand-in for SignalGP hardware: a countdown of remaining busy cycles.
+  struct hardware_t {
+    size_t busy_cycles=0;
+    size_t cycles=0;
+    void SingleProcess() {
+      ++cycles;
+      if (busy_cycles) --busy_cycles;
+    }
+    size_t GetNumActiveThreads() const { return busy_cycles ? 1 : 0; }
+    size_t GetNumPendingThreads() const { return 0; }
+  };
+  // Runs out the cycle budget.
+  hardware_t busy_hw{100};
+  REQUIRE(RunUntilQuiescent(busy_hw, 10) == 10);
+  REQUIRE(busy_hw.cycles == 10);
+  // Stops early once quiescent.
+  hardware_t quiet_hw{3};
+  REQUIRE(RunUntilQuiescent(quiet_hw, 10) == 3);
+  // Always runs at least one cycle (to process queued events), unless given no budget.
+  hardware_t idle_hw;
+  REQUIRE(RunUntilQuiescent(idle_hw, 10) == 1);
+  REQUIRE(RunUntilQuiescent(idle_hw, 0) == 0);
+}
+
+TEST_CASE( "Test prefix sharing", "[evaluation]") {
+  // Trie of signal sequences: branches are nodes where evaluation can continue in more than one way.
+  SequenceTrie<int> trie;
+  const emp::vector<emp::vector<int>> sequences = {{1, 2, 3}, {1, 2, 4}, {1, 2}, {5}};
+  auto key = [](int i) { return i; };
+  emp::vector<size_t> ends;
+  for (const auto & seq : sequences) ends.emplace_back(trie.Insert(seq.begin(), seq.end(), key));
+  REQUIRE(trie.GetSize() == 6);
+  const size_t node_1 = trie.GetChild(trie.GetRoot(), 1);
+  const size_t node_12 = trie.GetChild(node_1, 2);
+  REQUIRE(node_12 == ends[2]);
+  REQUIRE(trie.GetChild(node_12, 3) == ends[0]);
+  REQUIRE(trie.GetChild(node_12, 5) == SequenceTrie<int>::NO_NODE);
+  REQUIRE(trie.IsBranch(trie.GetRoot()));
+  REQUIRE(!trie.IsBranch(node_1));
+  REQUIRE(trie.IsBranch(node_12));
+  REQUIRE(!trie.IsBranch(ends[0]));
+  // Parents and depths lead back to the deepest checkpoint along a prefix.
+  REQUIRE(trie.GetParent(ends[0]) == node_12);
+  REQUIRE(trie.GetParent(node_1) == trie.GetRoot());
+  REQUIRE(trie.GetParent(trie.GetRoot()) == SequenceTrie<int>::NO_NODE);
+  REQUIRE(trie.GetDepth(trie.GetRoot()) == 0);
+  REQUIRE(trie.GetDepth(node_12) == 2);
+  REQUIRE(trie.GetDepth(ends[3]) == 1);
+  // Saving and restoring regulators (on a matchbin reset since the save).
+  using tag_t = emp::BitSet<64>;
+  using regulator_t = ExponentialCountdownRegulator<>;
+  using matchbin_t = DirtyResetMatchBin<emp::MatchBin<size_t, emp::AsymmetricWrapMetric<64>, emp::RankedSelector<>, regulator_t>>;
+  emp::Random random(2);
+  matchbin_t matchbin(random);
+  const size_t num_functions = 8;
+  emp::vector<tag_t> tags;
+  for (size_t uid = 0; uid < num_functions; ++uid) {
+    tags.emplace_back(random, 0.5);
+    matchbin.Set(uid, tags[uid], uid);
+  }
+  matchbin.AdjRegulator(1, 2.0);
+  matchbin.SetRegulator(4, -1.0);
+  emp::vector<double> saved_views;
+  for (size_t uid = 0; uid < num_functions; ++uid) saved_views.emplace_back(matchbin.ViewRegulator(uid));
+  emp::vector<std::pair<size_t, regulator_t>> snapshot;
+  matchbin.SaveRegulators(snapshot);
+  REQUIRE(snapshot.size() == 2);
+  matchbin.Clear();
+  for (size_t uid = 0; uid < num_functions; ++uid) matchbin.Set(uid, tags[uid], uid);
+  matchbin.AdjRegulator(6, 3.0);
+  matchbin.RestoreRegulators(snapshot);
+  for (size_t uid = 0; uid < num_functions; ++uid) REQUIRE(matchbin.ViewRegulator(uid) == saved_views[uid]);
+  // Memoized responses are forgotten when the memo is cleared (i.e., a new program is loaded).
+  struct checkpoint_t { void Save(int &) { ; } };
+  PrefixMemo<int, checkpoint_t> memo;
+  REQUIRE(!memo.HasResponse(node_12));
+  memo.SetResponse(node_12, 7);
+  REQUIRE(memo.HasResponse(node_12));
+  REQUIRE(memo.GetResponse(node_12) == 7);
+  REQUIRE(!memo.HasResponse(node_1));
+  int hw = 0;
+  memo.SaveCheckpoint(node_12, hw);
+  REQUIRE(memo.HasCheckpoint(node_12));
+  memo.Clear();
+  REQUIRE(!memo.HasResponse(node_12));
+  REQUIRE(!memo.HasCheckpoint(node_12));
+}
+
+/// Reachable functions of a small hand-built program (Hamming metric over 8-bit tags), given
+/// matchbin selector SELECTOR_T.
+template<typename SELECTOR_T>
+emp::vector<bool> FindReachableFunctions() {
+  using tag_t = emp::BitSet<8>;
+  using metric_t = emp::HammingMetric<8>;
+  using matchbin_t = emp::MatchBin<size_t, metric_t, SELECTOR_T, emp::AdditiveCountdownRegulator<>>;
+  using hardware_t = sgp::LinearFunctionsProgramSignalGP<sgp::SimpleMemoryModel, tag_t, int, matchbin_t>;
+  using inst_t = typename hardware_t::inst_t;
+  using program_t = typename hardware_t::program_t;
+  auto make_tag = [](uint32_t bits) {
+    tag_t tag;
+    tag.SetUInt(0, bits);
+    return tag;
+  };
+  typename hardware_t::inst_lib_t inst_lib;
+  typename hardware_t::event_lib_t event_lib;
+  inst_lib.AddInst("Nop", [](hardware_t & hw, const inst_t & inst) { ; }, "No operation!");
+  inst_lib.AddInst("Call", [](hardware_t & hw, const inst_t & inst) { ; }, "Stand-in for Call");
+  inst_lib.AddInst("SetRegulator", [](hardware_t & hw, const inst_t & inst) { ; }, "Stand-in for SetRegulator");
+  program_t program;
+  // f0: selected by the entry signal; calls f1 and regulates f3.
+  program.PushFunction(make_tag(0b00000000));
+  program.PushInst(inst_lib, "Call", {0, 0, 0}, {make_tag(0b11110000)});
+  program.PushInst(inst_lib, "SetRegulator", {0, 0, 0}, {make_tag(0b00001111)});
+  // f1: calls a tag 3 bits from its best matches (f1 and f4).
+  program.PushFunction(make_tag(0b11110001));
+  program.PushInst(inst_lib, "Call", {0, 0, 0}, {make_tag(0b01010101)});
+  // f2: only called by f3.
+  program.PushFunction(make_tag(0b11111111));
+  program.PushInst(inst_lib, "Nop", {0, 0, 0}, {make_tag(0)});
+  // f3: matches nothing well, but is regulated (so it could win any query); calls f2.
+  program.PushFunction(make_tag(0b00001110));
+  program.PushInst(inst_lib, "Call", {0, 0, 0}, {make_tag(0b11111110)});
+  // f4: 1 bit from the entry signal, but f0 is a better match.
+  program.PushFunction(make_tag(0b00000001));
+  program.PushInst(inst_lib, "Nop", {0, 0, 0}, {make_tag(0)});
+  // f5: never the best match; its call and regulation never happen.
+  program.PushFunction(make_tag(0b10101010));
+  program.PushInst(inst_lib, "Call", {0, 0, 0}, {make_tag(0b11111111)});
+  program.PushInst(inst_lib, "SetRegulator", {0, 0, 0}, {make_tag(0b00000001)});
+  emp::Random random(2);
+  hardware_t hw(random, inst_lib, event_lib);
+  hw.SetProgram(program);
+  ReachabilityAnalysis<hardware_t, tag_t, metric_t> reachability;
+  reachability.AddFlowInst(inst_lib.GetID("Call"));
+  reachability.AddRegulatorInst(inst_lib.GetID("SetRegulator"));
+  return reachability.FindReachable(hw, {make_tag(0b00000000)});
+}
+
+TEST_CASE( "ReachabilityAnalysis", "[analysis]") {
+  // With a 75% minimum similarity threshold (distance <= 0.25), f1's call (3 bits off) matches nothing.
+  const emp::vector<bool> thresh_reachable = FindReachableFunctions<emp::RankedSelector<std::ratio<8+(8/4), 8>>>();
+  REQUIRE(thresh_reachable == emp::vector<bool>{true, true, true, true, false, false});
+  // Without a threshold, it reaches its best matches (f1 and f4).
+  const emp::vector<bool> reachable = FindReachableFunctions<emp::RankedSelector<>>();
+  REQUIRE(reachable == emp::vector<bool>{true, true, true, true, true, false});
+}
+
+// ---- World tests (run from the repository root; they read the BoolCalc prefix training set) ----
+
+/// Small BoolCalc configuration for world tests.
+void ConfigureBoolCalcTest(BoolCalcConfig & config) {
+  const std::string test_cases = "experiments/2020-11-28-bool-calc-prefix/hpcc/training_set_prefix.csv";
+  config.SEED(2);
+  config.POP_SIZE(32);
+  config.STOP_ON_SOLUTION(false);
+  config.TRAINING_SET_FILE(test_cases);
+  config.TESTING_SET_FILE(test_cases);
+  config.CPU_CYCLES_PER_INPUT_SIGNAL(32);
+  config.MAX_FUNC_CNT(16);
+  config.MAX_FUNC_INST_CNT(32);
+  config.OUTPUT_DIR("unit_test_output");
+  config.SUMMARY_RESOLUTION(1000);
+  config.SNAPSHOT_RESOLUTION(0);
+}
+
+/// BoolCalcWorld with its evaluation steps exposed.
+class BoolCalcTestWorld : public BoolCalcWorld<> {
+public:
+  using BoolCalcWorld::DoEvaluation;
+  using BoolCalcWorld::DoSelection;
+  using BoolCalcWorld::DoUpdate;
+  using BoolCalcWorld::CompletePopEvaluation_Lazy;
+
+  size_t GetPhenotypeCacheHits() const { return phen_cache.GetHits(); }
+  size_t GetMaxFitOrgID() const { return max_fit_org_id; }
+
+  /// Test scores of each organism (in population order).
+  emp::vector<emp::vector<double>> GetTestScores() {
+    emp::vector<emp::vector<double>> scores;
+    for (size_t org_id = 0; org_id < GetSize(); ++org_id) scores.emplace_back(GetOrg(org_id).GetPhenotype().test_scores);
+    return scores;
+  }
+
+  /// Training case scores of org when run on hw.
+  emp::vector<double> GetTrainingScores(hardware_t & hw, org_t org) {
+    EvaluateOrg(hw, org, training_cases, training_case_ids, training_case_ids.size());
+    return org.GetPhenotype().test_scores;
+  }
+
+  /// Training case scores of org when run normally (nothing knocked out).
+  emp::vector<double> GetTrainingScores(const org_t & org) { return GetTrainingScores(*eval_hardware, org); }
+
+  /// Training case scores of org when run with knockout mode mode.
+  emp::vector<double> GetTrainingScores(KnockoutMode mode, const org_t & org) {
+    return GetTrainingScores(GetKnockoutHardware(mode), org);
+  }
+
+  /// Copy of org with every instruction named in inst_names replaced by Nop (counted in nop_cnt).
+  org_t NopInstructions(const org_t & org, const emp::vector<std::string> & inst_names, size_t & nop_cnt) {
+    org_t nop_org(org);
+    program_t & program = nop_org.GetGenome().GetProgram();
+    for (size_t fID = 0; fID < program.GetSize(); ++fID) {
+      for (size_t iID = 0; iID < program[fID].GetSize(); ++iID) {
+        inst_t & inst = program[fID][iID];
+        const std::string & name = inst_lib->GetName(inst.GetID());
+        if (std::find(inst_names.begin(), inst_names.end(), name) == inst_names.end()) continue;
+        inst.id = inst_lib->GetID("Nop");
+        ++nop_cnt;
+      }
+    }
+    return nop_org;
+  }
+};
+
+TEST_CASE( "BoolCalcWorld parallel evaluation", "[world]") {
+  BoolCalcConfig serial_config;
+  BoolCalcConfig parallel_config;
+  ConfigureBoolCalcTest(serial_config);
+  ConfigureBoolCalcTest(parallel_config);
+  parallel_config.NUM_EVAL_THREADS(4);
+  BoolCalcTestWorld serial_world;
+  BoolCalcTestWorld parallel_world;
+  serial_world.Setup(serial_config);
+  parallel_world.Setup(parallel_config);
+  // Worker threads score every organism exactly as serial evaluation does (so the runs never diverge).
+  for (size_t gen = 0; gen < 4; ++gen) {
+    serial_world.DoEvaluation();
+    parallel_world.DoEvaluation();
+    REQUIRE(parallel_world.GetTestScores() == serial_world.GetTestScores());
+    serial_world.DoSelection();
+    parallel_world.DoSelection();
+    serial_world.DoUpdate();
+    parallel_world.DoUpdate();
+  }
+}
+
+TEST_CASE( "BoolCalcWorld test prefix sharing", "[world]") {
+  BoolCalcConfig plain_config;
+  BoolCalcConfig shared_config;
+  ConfigureBoolCalcTest(plain_config);
+  ConfigureBoolCalcTest(shared_config);
+  shared_config.SHARE_TEST_PREFIXES(true);
+  BoolCalcTestWorld plain_world;
+  BoolCalcTestWorld shared_world;
+  plain_world.Setup(plain_config);
+  shared_world.Setup(shared_config);
+  // Reusing responses and resuming from checkpoints scores every test exactly as running each one
+  // from scratch does.
+  for (size_t gen = 0; gen < 4; ++gen) {
+    plain_world.DoEvaluation();
+    shared_world.DoEvaluation();
+    REQUIRE(shared_world.GetTestScores() == plain_world.GetTestScores());
+    plain_world.DoSelection();
+    shared_world.DoSelection();
+    plain_world.DoUpdate();
+    shared_world.DoUpdate();
+  }
+}
+
+TEST_CASE( "BoolCalcWorld phenotype cache", "[world]") {
+  BoolCalcConfig plain_config;
+  BoolCalcConfig cache_config;
+  ConfigureBoolCalcTest(plain_config);
+  ConfigureBoolCalcTest(cache_config);
+  cache_config.PHENOTYPE_CACHE_SIZE(1000);
+  BoolCalcTestWorld plain_world;
+  BoolCalcTestWorld cache_world;
+  plain_world.Setup(plain_config);
+  cache_world.Setup(cache_config);
+  // Scores pulled from the cache are exactly the scores re-evaluation produces.
+  size_t cache_hits = 0;
+  for (size_t gen = 0; gen < 6; ++gen) {
+    plain_world.DoEvaluation();
+    cache_world.DoEvaluation();
+    REQUIRE(cache_world.GetTestScores() == plain_world.GetTestScores());
+    cache_hits += cache_world.GetPhenotypeCacheHits();
+    plain_world.DoSelection();
+    cache_world.DoSelection();
+    plain_world.DoUpdate();
+    cache_world.DoUpdate();
+  }
+  REQUIRE(cache_hits > 0);
+}
+
+TEST_CASE( "BoolCalcWorld lazy lexicase", "[world]") {
+  BoolCalcConfig eager_config;
+  BoolCalcConfig lazy_config;
+  BoolCalcConfig lazy_parallel_config;
+  ConfigureBoolCalcTest(eager_config);
+  ConfigureBoolCalcTest(lazy_config);
+  ConfigureBoolCalcTest(lazy_parallel_config);
+  lazy_config.LAZY_LEXICASE(true);
+  lazy_parallel_config.LAZY_LEXICASE(true);
+  lazy_parallel_config.NUM_EVAL_THREADS(3);
+  BoolCalcTestWorld eager_world;
+  BoolCalcTestWorld lazy_world;
+  BoolCalcTestWorld lazy_parallel_world;
+  eager_world.Setup(eager_config);
+  lazy_world.Setup(lazy_config);
+  lazy_parallel_world.Setup(lazy_parallel_config);
+  // Lazy evaluation selects the same parents as emp::LexicaseSelect (so populations never diverge)
+  // and finds the same max fitness organism.
+  for (size_t gen = 0; gen < 6; ++gen) {
+    for (BoolCalcTestWorld * world : {&eager_world, &lazy_world, &lazy_parallel_world}) {
+      world->DoEvaluation();
+      world->DoSelection();
+    }
+    REQUIRE(lazy_world.GetMaxFitOrgID() == eager_world.GetMaxFitOrgID());
+    REQUIRE(lazy_parallel_world.GetMaxFitOrgID() == eager_world.GetMaxFitOrgID());
+    // Completing lazy evaluation gives the eager scores.
+    lazy_world.CompletePopEvaluation_Lazy();
+    lazy_parallel_world.CompletePopEvaluation_Lazy();
+    REQUIRE(lazy_world.GetTestScores() == eager_world.GetTestScores());
+    REQUIRE(lazy_parallel_world.GetTestScores() == eager_world.GetTestScores());
+    for (size_t org_id = 0; org_id < eager_world.GetSize(); ++org_id) {
+      REQUIRE(lazy_world.CalcFitnessID(org_id) == eager_world.CalcFitnessID(org_id));
+    }
+    for (BoolCalcTestWorld * world : {&eager_world, &lazy_world, &lazy_parallel_world}) world->DoUpdate();
+    for (size_t org_id = 0; org_id < eager_world.GetSize(); ++org_id) {
+      REQUIRE(lazy_world.GetGenomeAt(org_id) == eager_world.GetGenomeAt(org_id));
+      REQUIRE(lazy_parallel_world.GetGenomeAt(org_id) == eager_world.GetGenomeAt(org_id));
+    }
+  }
+}
+
+TEST_CASE( "BoolCalcWorld knockouts", "[world]") {
+  BoolCalcConfig config;
+  ConfigureBoolCalcTest(config);
+  BoolCalcTestWorld world;
+  world.Setup(config);
+  const emp::vector<std::string> global_memory_insts = {
+    "WorkingToGlobal", "GlobalToWorking", "FullWorkingToGlobal", "FullGlobalToWorking"
+  };
+  const emp::vector<std::string> regulation_insts = {
+    "SetRegulator", "SetRegulator-", "SetOwnRegulator", "SetOwnRegulator-",
+    "AdjRegulator", "AdjRegulator-", "AdjOwnRegulator", "AdjOwnRegulator-",
+    "ClearRegulator", "ClearOwnRegulator", "SenseRegulator", "SenseOwnRegulator",
+    "IncRegulator", "IncOwnRegulator", "DecRegulator", "DecOwnRegulator"
+  };
+  emp::vector<std::string> all_insts(global_memory_insts);
+  all_insts.insert(all_insts.end(), regulation_insts.begin(), regulation_insts.end());
+  // A program run with a knockout mode scores exactly as the same program with its knocked-out
+  // instructions replaced by Nops (run normally).
+  size_t global_memory_nop_cnt = 0;
+  size_t regulation_nop_cnt = 0;
+  size_t all_nop_cnt = 0;
+  for (size_t org_id = 0; org_id < world.GetSize(); ++org_id) {
+    const auto & org = world.GetOrg(org_id);
+    REQUIRE(world.GetTrainingScores(KnockoutMode::GLOBAL_MEMORY, org)
+            == world.GetTrainingScores(world.NopInstructions(org, global_memory_insts, global_memory_nop_cnt)));
+    REQUIRE(world.GetTrainingScores(KnockoutMode::REGULATION, org)
+            == world.GetTrainingScores(world.NopInstructions(org, regulation_insts, regulation_nop_cnt)));
+    REQUIRE(world.GetTrainingScores(KnockoutMode::GLOBAL_MEMORY_AND_REGULATION, org)
+            == world.GetTrainingScores(world.NopInstructions(org, all_insts, all_nop_cnt)));
+  }
+  // The random initial programs use the knocked-out instructions.
+  REQUIRE(global_memory_nop_cnt > 0);
+  REQUIRE(regulation_nop_cnt > 0);
+  REQUIRE(all_nop_cnt == global_memory_nop_cnt + regulation_nop_cnt);
+}
+
+/// World configurations for the variant test (the build configuration with a few options changed).
+struct BoolCalcHammingNearestConfig : BoolCalcBuildConfig {
+  static constexpr std::string_view MATCHBIN_METRIC = "hamming";
+  static constexpr std::string_view MATCHBIN_TAG_INDEX = "nearest";
+};
+
+struct BoolCalcStreakNearestConfig : BoolCalcBuildConfig {
+  static constexpr std::string_view MATCHBIN_METRIC = "streak";
+  static constexpr std::string_view MATCHBIN_TAG_INDEX = "nearest";
+};
+
+struct BoolCalcThreshIncrementalConfig : BoolCalcBuildConfig {
+  static constexpr std::string_view MATCHBIN_THRESH = "25";
+  static constexpr std::string_view MATCHBIN_INDEX = "incremental";
+};
+
+TEST_CASE( "BoolCalcWorld variants", "[world]") {
+  REQUIRE(BoolCalcWorldDefs<BoolCalcHammingNearestConfig>::VALID);
+  REQUIRE(!BoolCalcWorldDefs<BoolCalcStreakNearestConfig>::VALID);
+  REQUIRE(!BoolCalcWorldDefs<BoolCalcThreshIncrementalConfig>::VALID);
+  // Only configurations whose options fit together are compiled in.
+  const emp::vector<BoolCalcVariant> variants = GetBoolCalcVariants(
+    BoolCalcConfigList<BoolCalcHammingNearestConfig, BoolCalcStreakNearestConfig, BoolCalcThreshIncrementalConfig>()
+  );
+  REQUIRE(variants.size() == 1);
+  BoolCalcConfig config;
+  ConfigureBoolCalcTest(config);
+  config.GENERATIONS(2);
+  config.MATCHBIN_METRIC("hamming");
+  config.MATCHBIN_THRESH(std::string(BoolCalcBuildConfig::MATCHBIN_THRESH));
+  config.MATCHBIN_REG(std::string(BoolCalcBuildConfig::MATCHBIN_REG));
+  config.MATCHBIN_TAG_BITS(BoolCalcBuildConfig::MATCHBIN_TAG_BITS);
+  config.MATCHBIN_INDEX(std::string(BoolCalcBuildConfig::MATCHBIN_INDEX));
+  config.MATCHBIN_DECAY(std::string(BoolCalcBuildConfig::MATCHBIN_DECAY));
+  config.MATCHBIN_TAG_INDEX("nearest");
+  REQUIRE(variants[0].Matches(config));
+  REQUIRE(RunBoolCalcVariant(config, variants));
+  config.MATCHBIN_TAG_INDEX("none");
+  REQUIRE(!RunBoolCalcVariant(config, variants));
+}
+
+/// ChgEnvWorld with its evaluation steps exposed.
+class ChgEnvTestWorld : public ChgEnvWorld {
+public:
+  using ChgEnvWorld::ChgEnvWorld;
+  using ChgEnvWorld::DoEvaluation;
+  using ChgEnvWorld::DoSelection;
+  using ChgEnvWorld::DoUpdate;
+};
+
+TEST_CASE( "ChgEnvWorld parallel trials", "[world]") {
+  ChgEnvConfig serial_config;
+  ChgEnvConfig parallel_config;
+  for (ChgEnvConfig * config : {&serial_config, &parallel_config}) {
+    config->SEED(2);
+    config->POP_SIZE(32);
+    config->STOP_ON_SOLUTION(false);
+    config->EVAL_TRIAL_CNT(5);
+    config->NUM_ENV_STATES(4);
+    config->NUM_ENV_UPDATES(8);
+    config->OUTPUT_DIR("unit_test_output");
+    config->SUMMARY_RESOLUTION(1000);
+    config->SNAPSHOT_RESOLUTION(0);
+  }
+  parallel_config.NUM_TRIAL_THREADS(3);
+  emp::Random serial_random(serial_config.SEED());
+  emp::Random parallel_random(parallel_config.SEED());
+  ChgEnvTestWorld serial_world(serial_random);
+  ChgEnvTestWorld parallel_world(parallel_random);
+  serial_world.Setup(serial_config);
+  parallel_world.Setup(parallel_config);
+  // Concurrent trials see the same environment schedules as serial trials, so phenotypes match exactly.
+  for (size_t gen = 0; gen < 4; ++gen) {
+    serial_world.DoEvaluation();
+    parallel_world.DoEvaluation();
+    for (size_t org_id = 0; org_id < serial_world.GetSize(); ++org_id) {
+      REQUIRE(parallel_world.GetOrg(org_id).GetPhenotype() == serial_world.GetOrg(org_id).GetPhenotype());
+    }
+    serial_world.DoSelection();
+    parallel_world.DoSelection();
+    serial_world.DoUpdate();
+    parallel_world.DoUpdate();
+  }
+}
+
 /*
 TEST_CASE( "Figuring Out Ranked Selector Thresholds", "[general]" ) {
   constexpr size_t TAG_WIDTH = 4;